@@ -0,0 +1,199 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/Arena.h>
+#include <libutl/AutoPtr.h>
+#include <libutl/BBcodeParser.h>
+#include <libutl/BufferedFDstream.h>
+#include <libutl/OStimer.h>
+#include <libutl/RDparser.h>
+#include <libutl/Uint.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Compare building transient object graphs (parse trees, compiled regexes, BBCode tokens) on the
+// heap and in an Arena that's cleared after each use.
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+enum prod_t
+{
+    pr_expr,
+    pr_term,
+    pr_atom
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+enum term_t
+{
+    tm_number,
+    tm_plus_or_minus,
+    tm_mult_or_div,
+    tm_open_paren,
+    tm_close_paren
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// count the nodes reachable from the given one
+size_t
+countNodes(const ParseNode* pn)
+{
+    size_t res = 1;
+    for (auto edge = pn->edges(); edge != nullptr; edge = edge->next())
+    {
+        res += countNodes(utl::cast<ParseNode>(edge->get()));
+    }
+    return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+testRDparser(RDparser& parser, const String& expr, size_t numRounds, Arena* arena)
+{
+    size_t numNodes = 0;
+    for (size_t round = 0; round != numRounds; ++round)
+    {
+        Graph* parseTree = parser.parse(expr, nullptr, arena);
+        numNodes += countNodes(utl::cast<ParseNode>(parseTree->getStart()));
+        if (arena == nullptr)
+            delete parseTree;
+        else
+            arena->clear();
+    }
+    return numNodes;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+testRegex(const String& pattern, const String& str, size_t numRounds, Arena* arena)
+{
+    size_t numMatches = 0;
+    for (size_t round = 0; round != numRounds; ++round)
+    {
+        {
+            AutoPtr<Regex> regex;
+            if (arena == nullptr)
+                regex = new Regex(pattern);
+            else
+                regex = new Regex(pattern, arena);
+            if (regex->match(str))
+                ++numMatches;
+        }
+        if (arena != nullptr)
+            arena->clear();
+    }
+    return numMatches;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+testBBcode(const BBcodeParser& parser, const String& text, size_t numRounds, Arena* arena)
+{
+    size_t len = 0;
+    for (size_t round = 0; round != numRounds; ++round)
+    {
+        AutoPtr<String> html = parser.parse(text, arena);
+        len += html->length();
+        if (arena != nullptr)
+            arena->clear();
+    }
+    return len;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+testLargeAlloc()
+{
+    // a large first allocation gets a chunk of its own, and later chunks are still small
+    Arena arena;
+    arena.alloc(1024 * 1024);
+    size_t firstSize = arena.innerAllocatedSize();
+    ASSERT(firstSize < (1024 * 1024 + 4096));
+    arena.alloc(64);
+    ASSERT((arena.innerAllocatedSize() - firstSize) <= 8192);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    if (argc > 2)
+    {
+        cerr << "Arena [numRounds (10000)]" << endl;
+        return 1;
+    }
+    size_t numRounds = (argc > 1) ? Uint(argv[1]).get() : 10000;
+
+    // grammar for simple math expressions
+    RDparser parser;
+    parser.addProduction(pr_expr, "expression", "term [ +_or_- expression ]");
+    parser.addProduction(pr_term, "term", "atom [ *_or_/ term ]");
+    parser.addProduction(pr_atom, "atom", "number");
+    parser.addProduction(pr_atom, "atom", "( expression )");
+    parser.addTerminal(tm_number, "number", "\\d+(\\.\\d*)?");
+    parser.addTerminal(tm_plus_or_minus, "+_or_-", "\\+|^-");
+    parser.addTerminal(tm_mult_or_div, "*_or_/", "\\*|^/");
+    parser.addTerminal(tm_open_paren, "(", "\\(");
+    parser.addTerminal(tm_close_paren, ")", "\\)");
+    parser.compile();
+    String expr = "(1 + 2) * 3 - 4 / (5 + 6 * (7 - 8)) + 9 * 10 - 11";
+
+    String pattern = "^([a-z]+)://([^/:]+)(:\\d+)?(/[[:graph:]]*)?$";
+    String url = "http://www.example.com:8080/path/to/resource.html?a=1&b=2";
+
+    BBcodeParser bbParser;
+    String text = "[b]Hello[/b], [i]world[/i]!\n[center]centered [s]text[/s][/center]\n"
+                  "line [u]three[/u] has [code]a<b[/code] & more :-)";
+
+    testLargeAlloc();
+
+    Arena arena;
+    OStimer timer;
+    cout << "numRounds = " << numRounds << endl;
+
+    timer.start();
+    size_t heapNodes = testRDparser(parser, expr, numRounds, nullptr);
+    timer.stop();
+    cout << "RDparser (heap):      " << timer.userTime() << " sec." << endl;
+    timer.start();
+    size_t arenaNodes = testRDparser(parser, expr, numRounds, &arena);
+    timer.stop();
+    cout << "RDparser (arena):     " << timer.userTime() << " sec." << endl;
+    ASSERT(heapNodes == arenaNodes);
+
+    timer.start();
+    size_t heapMatches = testRegex(pattern, url, numRounds, nullptr);
+    timer.stop();
+    cout << "Regex (heap):         " << timer.userTime() << " sec." << endl;
+    timer.start();
+    size_t arenaMatches = testRegex(pattern, url, numRounds, &arena);
+    timer.stop();
+    cout << "Regex (arena):        " << timer.userTime() << " sec." << endl;
+    ASSERT((heapMatches == numRounds) && (arenaMatches == numRounds));
+
+    timer.start();
+    size_t heapLen = testBBcode(bbParser, text, numRounds, nullptr);
+    timer.stop();
+    cout << "BBcodeParser (heap):  " << timer.userTime() << " sec." << endl;
+    timer.start();
+    size_t arenaLen = testBBcode(bbParser, text, numRounds, &arena);
+    timer.stop();
+    cout << "BBcodeParser (arena): " << timer.userTime() << " sec." << endl;
+    ASSERT(heapLen == arenaLen);
+
+    cout << "arena size: " << arena.innerAllocatedSize() << " bytes" << endl;
+
+    return 0;
+}
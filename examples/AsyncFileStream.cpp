@@ -0,0 +1,114 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/AsyncFileStream.h>
+#include <libutl/BufferedFDstream.h>
+#include <libutl/BufferedFileStream.h>
+#include <libutl/CmdLineArgs.h>
+#include <libutl/MD5.h>
+#include <libutl/MmapStream.h>
+#include <libutl/OStimer.h>
+#include <libutl/Uint.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Copy a file line by line through BufferedFileStream, and through AsyncFileStream (with both
+// streams sharing one IOuring engine), and check that the copies are identical.  Then rewind the
+// AsyncFileStream and read the file again.
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static size_t
+copyLines(Stream& is, Stream& os)
+{
+    String line;
+    size_t numLines = 0;
+    try
+    {
+        for (;;)
+        {
+            is >> line;
+            os << line << '\n';
+            ++numLines;
+        }
+    }
+    catch (StreamEOFex&)
+    {
+    }
+    os.flush();
+    return numLines;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static String
+md5(const Pathname& path)
+{
+    MmapStream ms(path);
+    return MD5::compute(ms).toString();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    CmdLineArgs args(argc, argv);
+    if (args.items() != 3)
+    {
+        cout << "Usage: " << args(0) << " <infile> <outfile>" << endl;
+        return 1;
+    }
+    Pathname inPath = args(1);
+    Pathname outPath = args(2);
+    OStimer timer;
+
+    timer.start();
+    size_t bfsLines;
+    {
+        BufferedFileStream is(inPath, io_rd);
+        BufferedFileStream os(outPath, fs_clobber);
+        bfsLines = copyLines(is, os);
+    }
+    timer.stop();
+    cout << "BufferedFileStream: " << timer.totalTime() << " sec." << endl;
+    String bfsSum = md5(outPath);
+
+    timer.start();
+    size_t afsLines, rereadBytes = 0, inLength;
+    {
+        IOuring ring(16, 16, KB(64));
+        AsyncFileStream is(inPath, io_rd, 8, KB(64), &ring);
+        AsyncFileStream os(outPath, fs_clobber, 8, KB(64), &ring);
+        afsLines = copyLines(is, os);
+        cout << "(io_uring: " << (ring.isAsync() ? "yes" : "no") << ")" << endl;
+
+        // read the input file again (after reaching EOF)
+        is.rewind();
+        byte_t buf[4096];
+        try
+        {
+            for (;;)
+            {
+                rereadBytes += is.read(buf, sizeof(buf), 1);
+            }
+        }
+        catch (StreamEOFex&)
+        {
+        }
+        inLength = is.length();
+    }
+    timer.stop();
+    cout << "AsyncFileStream:    " << timer.totalTime() << " sec." << endl;
+    String afsSum = md5(outPath);
+
+    ASSERT((bfsLines == afsLines) && (bfsSum == afsSum));
+    ASSERT(rereadBytes == inLength);
+    cout << "lines: " << Uint(afsLines).toString() << ", MD5: " << afsSum << endl;
+    return 0;
+}
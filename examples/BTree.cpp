@@ -0,0 +1,210 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/Array.h>
+#include <libutl/AutoPtr.h>
+#include <libutl/BTree.h>
+#include <libutl/BufferedFDstream.h>
+#include <libutl/OStimer.h>
+#include <libutl/RBtree.h>
+#include <libutl/SkipList.h>
+#include <libutl/Uint.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_INSTANTIATE_TPL(TBTree, Uint);
+UTL_INSTANTIATE_TPL(TBTreeIt, Uint);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const size_t scanLength = 100;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// multi-set behavior: findFirstIt(), findLastIt(), insertion via iterator, removal via iterator
+void
+testMultiSet()
+{
+    TBTree<Uint> tree(true, true);
+    size_t i, j;
+    for (j = 0; j != 10; ++j)
+    {
+        for (i = 0; i != 1000; ++i)
+        {
+            tree.add(new Uint(i));
+        }
+    }
+    ASSERT(tree.items() == 10000);
+    IFDEBUG(tree.sanityCheck());
+
+    // each key appears 10 times, between findFirstIt() and findLastIt()
+    for (i = 0; i != 1000; ++i)
+    {
+        auto first = tree.findFirstIt(Uint(i));
+        auto last = tree.findLastIt(Uint(i));
+        ASSERT(!first.isEnd() && (*first.get() == i));
+        ASSERT(!last.isEnd() && (*last.get() == i));
+        for (j = 0; j != 9; ++j)
+        {
+            ++first;
+        }
+        ASSERT(first == last);
+        --first;
+        ASSERT(*first.get() == i);
+        ++last;
+        ASSERT(last.isEnd() || (*last.get() == (i + 1)));
+    }
+    ASSERT(tree.findFirstIt(Uint(1000)).isEnd());
+    ASSERT(tree.findLastIt(Uint(1000)).isEnd());
+
+    // insertion point for a key that's not present
+    tree.remove(Uint(500));
+    IFDEBUG(tree.sanityCheck());
+    ASSERT(tree.findLastIt(Uint(500)).get()->get() == 500);
+    while (tree.remove(Uint(500)))
+        ;
+    auto ip = tree.findFirstIt(Uint(500), true);
+    ASSERT(*ip.get() == 501);
+    tree.insert(new Uint(500), ip);
+    ASSERT(tree.find(Uint(500)) != nullptr);
+    IFDEBUG(tree.sanityCheck());
+
+    // remove every other object by iterator, then the rest in reverse order
+    auto it = tree.begin();
+    while (!it.isEnd())
+    {
+        tree.removeIt(it);
+        if (!it.isEnd())
+            ++it;
+    }
+    IFDEBUG(tree.sanityCheck());
+    while (!tree.empty())
+    {
+        it = tree.end();
+        --it;
+        tree.removeIt(it);
+        ASSERT(it.isEnd());
+    }
+    IFDEBUG(tree.sanityCheck());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+testPerformance(SortedCollection* col, const Array& array, const Array& sorted)
+{
+    size_t numItems = array.items();
+    cout << col->getClassName() << ":" << endl;
+    col->setOwner(false);
+
+    // add objects in random order
+    OStimer timer;
+    timer.start();
+    for (size_t i = 0; i != numItems; ++i)
+    {
+        col->add(array[i]);
+    }
+    timer.stop();
+    cout << "    add:       " << timer.userTime() << " sec." << endl;
+
+    // find objects in random order
+    timer.start();
+    for (size_t i = 0; i != numItems; ++i)
+    {
+        ASSERT(col->find(*array[i]) != nullptr);
+    }
+    timer.stop();
+    cout << "    find:      " << timer.userTime() << " sec." << endl;
+
+    // iterate over all objects
+    timer.start();
+    size_t count = 0;
+    AutoPtr<BidIt> it = col->beginNew();
+    while (!it->isEnd())
+    {
+        ++count;
+        it->forward();
+    }
+    timer.stop();
+    ASSERT(count == numItems);
+    cout << "    iterate:   " << timer.userTime() << " sec." << endl;
+
+    // range scans: find the first object >= key, then visit the following objects
+    size_t numScans = numItems / scanLength;
+    timer.start();
+    for (size_t i = 0; i != numScans; ++i)
+    {
+        col->findFirstIt(*array[i], *it);
+        for (size_t j = 0; (j != scanLength) && !it->isEnd(); ++j)
+        {
+            it->forward();
+        }
+    }
+    timer.stop();
+    cout << "    scan:      " << timer.userTime() << " sec. (" << numScans << " x " << scanLength
+         << ")" << endl;
+
+    // remove objects in random order
+    timer.start();
+    for (size_t i = 0; i != numItems; ++i)
+    {
+        ASSERT(col->remove(*array[i]));
+    }
+    timer.stop();
+    ASSERT(col->empty());
+    cout << "    remove:    " << timer.userTime() << " sec." << endl;
+
+    // bulk load (BTree only)
+    if (col->isA(BTree))
+    {
+        auto& tree = utl::cast<BTree>(*col);
+        timer.start();
+        tree.bulkLoad(sorted);
+        timer.stop();
+        ASSERT(tree.items() == numItems);
+        cout << "    bulkLoad:  " << timer.userTime() << " sec." << endl;
+        IFDEBUG(tree.sanityCheck());
+    }
+
+    col->clear();
+    delete col;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    if (argc > 2)
+    {
+        cerr << "BTree [numItems (10000000)]" << endl;
+        return 1;
+    }
+    size_t numItems = (argc > 1) ? Uint(argv[1]).get() : 10000000;
+
+    testMultiSet();
+
+    // sorted array of objects, and a shuffled copy of it
+    Array sorted(true);
+    sorted.reserve(numItems);
+    for (size_t i = 0; i != numItems; ++i)
+    {
+        sorted += new Uint(i);
+    }
+    Array array(false);
+    array.reserve(numItems);
+    array.copyItems(&sorted);
+    array.shuffle();
+
+    cout << "numItems = " << numItems << endl;
+    testPerformance(new RBtree, array, sorted);
+    testPerformance(new SkipList(true, false, nullptr, 24), array, sorted);
+    testPerformance(new BTree, array, sorted);
+
+    return 0;
+}
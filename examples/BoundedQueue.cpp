@@ -0,0 +1,182 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/BoundedQueue.h>
+#include <libutl/BufferedFDstream.h>
+#include <libutl/Thread.h>
+#include <libutl/Uint.h>
+#include <chrono>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template class BoundedQueue<size_t>;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const size_t batchSize = 16;
+const size_t endOfStream = size_t_max;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// source stage: queue the values [1, count]
+class Source : public utl::Thread
+{
+public:
+    Source(BoundedQueue<size_t>& out, size_t count)
+        : _out(out)
+        , _count(count)
+    {
+    }
+
+    virtual void*
+    run(void*)
+    {
+        for (size_t i = 1; i <= _count; ++i)
+        {
+            _out.enQwait(i);
+        }
+        return nullptr;
+    }
+
+private:
+    BoundedQueue<size_t>& _out;
+    size_t _count;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// middle stage: move values from one queue to the next in batches, doubling them
+class Filter : public utl::Thread
+{
+public:
+    Filter(BoundedQueue<size_t>& in, BoundedQueue<size_t>& out)
+        : _in(in)
+        , _out(out)
+    {
+    }
+
+    virtual void* run(void*);
+
+private:
+    BoundedQueue<size_t>& _in;
+    BoundedQueue<size_t>& _out;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void*
+Filter::run(void*)
+{
+    size_t values[batchSize];
+    while (true)
+    {
+        // wait for one value, then take whatever else is ready
+        _in.deQwait(values[0]);
+        size_t n = 1 + _in.deQ(values + 1, batchSize - 1);
+        bool eos = false;
+        size_t i;
+        for (i = 0; i != n; ++i)
+        {
+            if (values[i] == endOfStream)
+            {
+                // pass it back for the other filters, and stop after this batch
+                _in.enQwait(endOfStream);
+                eos = true;
+                break;
+            }
+            values[i] *= 2;
+        }
+        n = i;
+
+        // forward the batch (waiting for room as necessary)
+        for (i = 0; i != n;)
+        {
+            auto num = _out.enQ(values + i, n - i);
+            if (num == 0)
+            {
+                _out.enQwait(values[i]);
+                num = 1;
+            }
+            i += num;
+        }
+        if (eos)
+            return nullptr;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    if (argc > 4)
+    {
+        cerr << "BoundedQueue [sources (4)] [filters (4)] [count_per_source (1000000)]" << endl;
+        return 1;
+    }
+    size_t numSources = (argc > 1) ? Uint(argv[1]).get() : 4;
+    size_t numFilters = (argc > 2) ? Uint(argv[2]).get() : 4;
+    size_t count = (argc > 3) ? Uint(argv[3]).get() : 1000000;
+
+    // timeouts on an empty or full queue
+    BoundedQueue<size_t> q(2, true);
+    size_t val;
+    ASSERT(!q.deQwait(val, 10));
+    ASSERT(q.enQ(1) && q.enQ(2) && !q.enQ(3));
+    ASSERT(!q.enQwait(3, 10));
+    ASSERT(q.deQ(val) && (val == 1) && q.enQwait(3, 10));
+    ASSERT(q.count() == 2);
+
+    // source(s) -> q1 -> filter(s) -> q2 -> this thread
+    BoundedQueue<size_t> q1(256, true), q2(256, true);
+    size_t i;
+    auto startTime = std::chrono::steady_clock::now();
+    Thread* sources[numSources];
+    for (i = 0; i != numSources; ++i)
+    {
+        sources[i] = new Source(q1, count);
+        sources[i]->start();
+    }
+    Thread* filters[numFilters];
+    for (i = 0; i != numFilters; ++i)
+    {
+        filters[i] = new Filter(q1, q2);
+        filters[i]->start();
+    }
+    size_t sum = 0;
+    size_t num = numSources * count;
+    size_t values[batchSize];
+    while (num != 0)
+    {
+        q2.deQwait(values[0]);
+        size_t n = 1 + q2.deQ(values + 1, batchSize - 1);
+        for (i = 0; i != n; ++i)
+        {
+            sum += values[i];
+        }
+        num -= n;
+    }
+    for (i = 0; i != numSources; ++i)
+    {
+        sources[i]->join();
+    }
+    q1.enQwait(endOfStream);
+    for (i = 0; i != numFilters; ++i)
+    {
+        filters[i]->join();
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    ASSERT(sum == (numSources * count * (count + 1)));
+    ASSERT(q1.deQ(val) && (val == endOfStream));
+    ASSERT(q2.count() == 0);
+
+    cout << "sources: " << numSources << ", filters: " << numFilters << ", count: " << count
+         << ", time: " << std::chrono::duration<double>(endTime - startTime).count() << " sec."
+         << endl;
+    return 0;
+}
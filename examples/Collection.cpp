@@ -1,9 +1,11 @@
 #include <libutl/libutl.h>
 #include <libutl/Application.h>
 #include <libutl/Array.h>
+#include <libutl/BTree.h>
 #include <libutl/BufferedFDstream.h>
 #include <libutl/Hashtable.h>
 #include <libutl/OStimer.h>
+#include <libutl/OpenHashtable.h>
 #include <libutl/RBtree.h>
 #include <libutl/SkipList.h>
 #include <libutl/Uint.h>
@@ -175,13 +177,17 @@ Test::run(int, char**)
 {
     testCollection(new Array);
     testCollection(new Hashtable);
+    testCollection(new OpenHashtable);
     testCollection(new RBtree);
     testCollection(new SkipList);
+    testCollection(new BTree);
 
     testCollectionPerformance(new Array(true, true, false));
     testCollectionPerformance(new Hashtable);
+    testCollectionPerformance(new OpenHashtable);
     testCollectionPerformance(new RBtree);
     testCollectionPerformance(new SkipList(true, false, nullptr, 18));
+    testCollectionPerformance(new BTree);
 
     return 0;
 }
@@ -0,0 +1,259 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/BufferedFDstream.h>
+#include <libutl/ConcurrentHashtable.h>
+#include <libutl/Hashtable.h>
+#include <libutl/RWlockLF.h>
+#include <libutl/Thread.h>
+#include <libutl/Uint.h>
+#include <libutl/Vector.h>
+#include <chrono>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_INSTANTIATE_TPL(Vector, Thread*);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const size_t numKeys = 1 << 16;
+const size_t numOps = 1 << 23;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// common interface for the two tables being compared
+class Table
+{
+public:
+    virtual ~Table()
+    {
+    }
+
+    virtual bool find(const Uint& key) = 0;
+
+    virtual void update(size_t key) = 0;
+
+    virtual void remove(const Uint& key) = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class LockedHashtable : public Table
+{
+public:
+    virtual bool
+    find(const Uint& key)
+    {
+        RWlockLFguard guard(&_lock, io_rd);
+        return (_ht.find(key) != nullptr);
+    }
+
+    virtual void
+    update(size_t key)
+    {
+        RWlockLFguard guard(&_lock, io_wr);
+        _ht.addOrUpdate(new Uint(key));
+    }
+
+    virtual void
+    remove(const Uint& key)
+    {
+        RWlockLFguard guard(&_lock, io_wr);
+        _ht.remove(key);
+    }
+
+private:
+    RWlockLF _lock;
+    Hashtable _ht;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ShardedHashtable : public Table
+{
+public:
+    virtual bool
+    find(const Uint& key)
+    {
+        return _ht.has(key);
+    }
+
+    virtual void
+    update(size_t key)
+    {
+        _ht.addOrUpdate(new Uint(key));
+    }
+
+    virtual void
+    remove(const Uint& key)
+    {
+        _ht.remove(key);
+    }
+
+private:
+    ConcurrentHashtable _ht;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Worker : public utl::Thread
+{
+public:
+    Worker(Table& table, size_t ops, uint_t writePct, uint64_t seed)
+        : _table(table)
+        , _ops(ops)
+        , _writePct(writePct)
+        , _rnd(seed)
+    {
+    }
+
+    virtual void* run(void*);
+
+private:
+    uint64_t
+    random()
+    {
+        _rnd ^= _rnd << 13;
+        _rnd ^= _rnd >> 7;
+        _rnd ^= _rnd << 17;
+        return _rnd;
+    }
+
+private:
+    Table& _table;
+    size_t _ops;
+    uint_t _writePct;
+    uint64_t _rnd;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void*
+Worker::run(void*)
+{
+    Uint key;
+    for (size_t i = 0; i != _ops; ++i)
+    {
+        auto r = random();
+        key = (r >> 8) % numKeys;
+        auto pct = r % 100;
+        if (pct >= _writePct)
+            _table.find(key);
+        else if ((pct & 1) == 0)
+            _table.update(key.get());
+        else
+            _table.remove(key);
+    }
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double
+runTest(Table& table, uint_t numThreads, uint_t writePct)
+{
+    for (size_t i = 0; i != numKeys; i += 2)
+    {
+        table.update(i);
+    }
+
+    Vector<Thread*> threads(numThreads);
+    for (uint_t i = 0; i != numThreads; ++i)
+    {
+        threads[i] = new Worker(table, numOps / numThreads, writePct, 0x9e3779b97f4a7c15ULL + i);
+    }
+    auto startTime = std::chrono::steady_clock::now();
+    for (uint_t i = 0; i != numThreads; ++i)
+    {
+        threads[i]->start(nullptr, true);
+    }
+    for (uint_t i = 0; i != numThreads; ++i)
+    {
+        threads[i]->join();
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(endTime - startTime).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+testConcurrentHashtable()
+{
+    ConcurrentHashtable ht(16);
+    size_t i;
+    for (i = 0; i != numKeys; ++i)
+    {
+        ASSERT(ht.add(new Uint(i)));
+    }
+    ASSERT(!ht.add(new Uint(0)));
+    ASSERT(ht.items() == numKeys);
+    for (i = 0; i != numKeys; ++i)
+    {
+        ASSERT(ht.has(Uint(i)));
+    }
+    ASSERT(!ht.has(Uint(numKeys)));
+
+    // addOrFind, addOrUpdate
+    Uint* found = utl::cast<Uint>(ht.addOrFind(new Uint(1)));
+    ASSERT((found != nullptr) && (found->get() == 1));
+    auto added = new Uint(numKeys);
+    ASSERT(ht.addOrFind(added) == added);
+    ASSERT(!ht.addOrUpdate(new Uint(2)));
+    ASSERT(ht.addOrUpdate(new Uint(numKeys + 1)));
+    size_t val = 0;
+    ASSERT(ht.visit(Uint(numKeys + 1), [&val](Object* obj) { val = utl::cast<Uint>(obj)->get(); }));
+    ASSERT(val == (numKeys + 1));
+
+    // remove every other key
+    for (i = 0; i < numKeys + 2; i += 2)
+    {
+        ASSERT(ht.remove(Uint(i)));
+    }
+    ASSERT(ht.items() == ((numKeys / 2) + 1));
+
+    // iterate
+    size_t count = 0;
+    for (auto it = ht.begin(); it != ht.end(); ++it)
+    {
+        ASSERT((utl::cast<Uint>(*it)->get() % 2) == 1);
+        ++count;
+    }
+    ASSERT(count == ht.items());
+
+    ht.clear();
+    ASSERT(ht.empty());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    if (argc > 3)
+    {
+        cerr << "ConcurrentHashtable [max_threads (64)] [write_pct (10)]" << endl;
+        return 1;
+    }
+    uint_t maxThreads = (argc > 1) ? Uint(argv[1]).get() : 64;
+    uint_t writePct = (argc > 2) ? Uint(argv[2]).get() : 10;
+
+    testConcurrentHashtable();
+
+    cout << "keys: " << numKeys << ", ops: " << numOps << ", writes: " << writePct << "%" << endl;
+    for (uint_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+    {
+        LockedHashtable locked;
+        auto lockedTime = runTest(locked, numThreads, writePct);
+        ShardedHashtable sharded;
+        auto shardedTime = runTest(sharded, numThreads, writePct);
+        cout << "threads: " << numThreads << "  RWlockLF+Hashtable: " << lockedTime
+             << " sec.  ConcurrentHashtable: " << shardedTime << " sec." << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,217 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/BufferedFDstream.h>
+#include <libutl/ConcurrentQueue.h>
+#include <libutl/Thread.h>
+#include <libutl/Uint.h>
+#include <chrono>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template class ConcurrentQueue<size_t>;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const size_t batchSize = 32;
+const size_t endOfStream = size_t_max;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// queue (producerId << 32 | seqNo) for seqNo in [0, count)
+class Producer : public utl::Thread
+{
+public:
+    Producer(ConcurrentQueue<size_t>& q, size_t id, size_t count, bool batch)
+        : _q(q)
+        , _id(id)
+        , _count(count)
+        , _batch(batch)
+    {
+    }
+
+    virtual void* run(void*);
+
+private:
+    ConcurrentQueue<size_t>& _q;
+    size_t _id;
+    size_t _count;
+    bool _batch;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// dequeue until an end-of-stream marker is seen, checking that each producer's values are in order
+class Consumer : public utl::Thread
+{
+public:
+    Consumer(ConcurrentQueue<size_t>& q, size_t numProducers, bool batch, bool wait)
+        : _q(q)
+        , _numProducers(numProducers)
+        , _batch(batch)
+        , _wait(wait)
+        , _count(0)
+    {
+    }
+
+    virtual void* run(void*);
+
+    size_t
+    count() const
+    {
+        return _count;
+    }
+
+private:
+    ConcurrentQueue<size_t>& _q;
+    size_t _numProducers;
+    bool _batch;
+    bool _wait;
+    size_t _count;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void*
+Producer::run(void*)
+{
+    size_t values[batchSize];
+    size_t i = 0;
+    while (i != _count)
+    {
+        if (_batch)
+        {
+            size_t n = min(batchSize, _count - i);
+            for (size_t j = 0; j != n; ++j)
+            {
+                values[j] = (_id << 32) | i++;
+            }
+            _q.enQ(values, values + n);
+        }
+        else
+        {
+            _q.enQ((_id << 32) | i++);
+        }
+    }
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void*
+Consumer::run(void*)
+{
+    size_t next[_numProducers];
+    for (size_t i = 0; i != _numProducers; ++i)
+    {
+        next[i] = 0;
+    }
+    size_t values[batchSize];
+    while (true)
+    {
+        size_t n;
+        if (_wait)
+        {
+            n = _q.deQwait(values[0]) ? 1 : 0;
+        }
+        else
+        {
+            n = _q.deQ(values, _batch ? batchSize : 1);
+            if (n == 0)
+                Thread::yield();
+        }
+        for (size_t i = 0; i != n; ++i)
+        {
+            auto val = values[i];
+            if (val == endOfStream)
+            {
+                // let the other consumers see it too
+                _q.enQ(endOfStream);
+                return nullptr;
+            }
+            auto id = val >> 32;
+            auto seqNo = val & 0xffffffff;
+            ASSERT(id < _numProducers);
+            ASSERT(seqNo >= next[id]);
+            next[id] = seqNo + 1;
+            ++_count;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double
+runTest(size_t numProducers, size_t numConsumers, size_t count, bool batch, bool wait)
+{
+    ConcurrentQueue<size_t> q(wait);
+    Thread* producers[numProducers];
+    Consumer* consumers[numConsumers];
+    size_t i;
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (i = 0; i != numConsumers; ++i)
+    {
+        consumers[i] = new Consumer(q, numProducers, batch, wait);
+        consumers[i]->start();
+    }
+    for (i = 0; i != numProducers; ++i)
+    {
+        producers[i] = new Producer(q, i, count, batch);
+        producers[i]->start();
+    }
+    for (i = 0; i != numProducers; ++i)
+    {
+        producers[i]->join();
+    }
+    q.enQ(endOfStream);
+    size_t total = 0;
+    for (i = 0; i != numConsumers; ++i)
+    {
+        consumers[i]->join(false);
+        total += consumers[i]->count();
+        delete consumers[i];
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    ASSERT(total == (numProducers * count));
+    size_t val;
+    ASSERT(q.deQ(val) && (val == endOfStream));
+    ASSERT(q.empty());
+    return std::chrono::duration<double>(endTime - startTime).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    if (argc > 4)
+    {
+        cerr << "ConcurrentQueue [producers (4)] [consumers (4)] [count_per_producer (1000000)]"
+             << endl;
+        return 1;
+    }
+    size_t numProducers = (argc > 1) ? Uint(argv[1]).get() : 4;
+    size_t numConsumers = (argc > 2) ? Uint(argv[2]).get() : 4;
+    size_t count = (argc > 3) ? Uint(argv[3]).get() : 1000000;
+
+    // deQwait() times out on an empty queue
+    ConcurrentQueue<size_t> q(true);
+    size_t val;
+    ASSERT(!q.deQwait(val, 10));
+
+    cout << "producers: " << numProducers << ", consumers: " << numConsumers
+         << ", count: " << count << endl;
+    cout << "single:   " << runTest(numProducers, numConsumers, count, false, false) << " sec."
+         << endl;
+    cout << "batch:    " << runTest(numProducers, numConsumers, count, true, false) << " sec."
+         << endl;
+    cout << "blocking: " << runTest(numProducers, numConsumers, count, false, true) << " sec."
+         << endl;
+    return 0;
+}
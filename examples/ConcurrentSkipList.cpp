@@ -0,0 +1,300 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/BufferedFDstream.h>
+#include <libutl/ConcurrentSkipList.h>
+#include <libutl/RWlockLF.h>
+#include <libutl/SkipList.h>
+#include <libutl/Thread.h>
+#include <libutl/Uint.h>
+#include <chrono>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const size_t numKeys = 1 << 16;
+const size_t window = 1 << 14;
+const size_t scanLength = 32;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// common interface for the two indexes being compared
+class Index
+{
+public:
+    virtual ~Index()
+    {
+    }
+
+    virtual void add(size_t key) = 0;
+
+    virtual void remove(size_t key) = 0;
+
+    // visit up to scanLength keys >= key, return the number visited
+    virtual size_t scan(size_t key) = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class LockedSkipList : public Index
+{
+public:
+    virtual void
+    add(size_t key)
+    {
+        RWlockLFguard guard(&_lock, io_wr);
+        _sl.add(new Uint(key));
+    }
+
+    virtual void
+    remove(size_t key)
+    {
+        RWlockLFguard guard(&_lock, io_wr);
+        _sl.remove(Uint(key));
+    }
+
+    virtual size_t
+    scan(size_t key)
+    {
+        RWlockLFguard guard(&_lock, io_rd);
+        size_t num = 0, prev = 0;
+        for (auto it = _sl.findFirstIt(Uint(key), true); !it.isEnd() && (num != scanLength); ++it)
+        {
+            auto val = utl::cast<Uint>(*it)->get();
+            ASSERT((num == 0) || (val > prev));
+            prev = val;
+            ++num;
+        }
+        return num;
+    }
+
+private:
+    RWlockLF _lock;
+    SkipList _sl;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class LockFreeSkipList : public Index
+{
+public:
+    virtual void
+    add(size_t key)
+    {
+        _sl.add(new Uint(key));
+    }
+
+    virtual void
+    remove(size_t key)
+    {
+        _sl.remove(Uint(key));
+    }
+
+    virtual size_t
+    scan(size_t key)
+    {
+        size_t num = 0, prev = 0;
+        for (auto it = _sl.findFirstIt(Uint(key)); !it.isEnd() && (num != scanLength); ++it)
+        {
+            auto val = utl::cast<Uint>(*it)->get();
+            ASSERT((num == 0) || (val > prev));
+            prev = val;
+            ++num;
+        }
+        return num;
+    }
+
+private:
+    ConcurrentSkipList _sl;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// add keys in increasing order (as for a time-ordered index), removing those that are too old
+class Writer : public utl::Thread
+{
+public:
+    Writer(Index& index, size_t id, size_t numWriters)
+        : _index(index)
+        , _id(id)
+        , _numWriters(numWriters)
+    {
+    }
+
+    virtual void*
+    run(void*)
+    {
+        for (size_t key = _id; key < numKeys; key += _numWriters)
+        {
+            _index.add(key);
+            if (key >= window)
+                _index.remove(key - window);
+        }
+        return nullptr;
+    }
+
+private:
+    Index& _index;
+    size_t _id;
+    size_t _numWriters;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// scan ranges of the index until told to stop
+class Reader : public utl::Thread
+{
+public:
+    Reader(Index& index, std::atomic_bool& stop, uint64_t seed)
+        : _index(index)
+        , _stop(stop)
+        , _rnd(seed)
+        , _scans(0)
+    {
+    }
+
+    virtual void*
+    run(void*)
+    {
+        while (!_stop.load(std::memory_order_relaxed))
+        {
+            _rnd ^= _rnd << 13;
+            _rnd ^= _rnd >> 7;
+            _rnd ^= _rnd << 17;
+            _index.scan(_rnd % numKeys);
+            ++_scans;
+        }
+        return nullptr;
+    }
+
+    size_t
+    scans() const
+    {
+        return _scans;
+    }
+
+private:
+    Index& _index;
+    std::atomic_bool& _stop;
+    uint64_t _rnd;
+    size_t _scans;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double
+runTest(Index& index, uint_t numWriters, uint_t numReaders, size_t& numScans)
+{
+    std::atomic_bool stop(false);
+    Thread* writers[numWriters];
+    Reader* readers[numReaders];
+    uint_t i;
+    auto startTime = std::chrono::steady_clock::now();
+    for (i = 0; i != numReaders; ++i)
+    {
+        readers[i] = new Reader(index, stop, 0x9e3779b97f4a7c15ULL + i);
+        readers[i]->start();
+    }
+    for (i = 0; i != numWriters; ++i)
+    {
+        writers[i] = new Writer(index, i, numWriters);
+        writers[i]->start();
+    }
+    for (i = 0; i != numWriters; ++i)
+    {
+        writers[i]->join();
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    stop = true;
+    numScans = 0;
+    for (i = 0; i != numReaders; ++i)
+    {
+        readers[i]->join(false);
+        numScans += readers[i]->scans();
+        delete readers[i];
+    }
+    return std::chrono::duration<double>(endTime - startTime).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+testConcurrentSkipList()
+{
+    ConcurrentSkipList sl;
+    size_t i;
+    for (i = 0; i != numKeys; i += 2)
+    {
+        ASSERT(sl.add(new Uint(i)));
+    }
+    ASSERT(!sl.add(new Uint(0)));
+    ASSERT(sl.items() == (numKeys / 2));
+    for (i = 0; i != numKeys; ++i)
+    {
+        ASSERT(sl.has(Uint(i)) == ((i % 2) == 0));
+    }
+
+    // addOrFind, visit
+    Uint* found = utl::cast<Uint>(sl.addOrFind(new Uint(2)));
+    ASSERT((found != nullptr) && (found->get() == 2));
+    auto added = new Uint(3);
+    ASSERT(sl.addOrFind(added) == added);
+    size_t val = 0;
+    ASSERT(sl.visit(Uint(3), [&val](Object* obj) { val = utl::cast<Uint>(obj)->get(); }));
+    ASSERT(val == 3);
+    ASSERT(sl.remove(Uint(3)));
+    ASSERT(!sl.remove(Uint(3)));
+
+    // findFirstIt
+    auto it = sl.findFirstIt(Uint(101));
+    ASSERT(utl::cast<Uint>(*it)->get() == 102);
+    it.release();
+    ASSERT(sl.findFirstIt(Uint(numKeys)) == sl.end());
+
+    // remove every fourth key, and iterate
+    for (i = 0; i < numKeys; i += 4)
+    {
+        ASSERT(sl.remove(Uint(i)));
+    }
+    size_t count = 0;
+    for (auto it = sl.begin(); it != sl.end(); ++it)
+    {
+        ASSERT((utl::cast<Uint>(*it)->get() % 4) == 2);
+        ++count;
+    }
+    ASSERT(count == sl.items());
+
+    sl.clear();
+    ASSERT(sl.empty());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    if (argc > 3)
+    {
+        cerr << "ConcurrentSkipList [writers (4)] [readers (4)]" << endl;
+        return 1;
+    }
+    uint_t numWriters = (argc > 1) ? Uint(argv[1]).get() : 4;
+    uint_t numReaders = (argc > 2) ? Uint(argv[2]).get() : 4;
+
+    testConcurrentSkipList();
+
+    cout << "keys: " << numKeys << ", window: " << window << ", writers: " << numWriters
+         << ", readers: " << numReaders << endl;
+    size_t numScans;
+    LockedSkipList locked;
+    auto lockedTime = runTest(locked, numWriters, numReaders, numScans);
+    cout << "RWlockLF+SkipList:  " << lockedTime << " sec., " << numScans << " scans" << endl;
+    LockFreeSkipList lockFree;
+    auto lockFreeTime = runTest(lockFree, numWriters, numReaders, numScans);
+    cout << "ConcurrentSkipList: " << lockFreeTime << " sec., " << numScans << " scans" << endl;
+    return 0;
+}
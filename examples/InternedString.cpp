@@ -0,0 +1,89 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/BufferedFDstream.h>
+#include <libutl/InternedString.h>
+#include <libutl/OStimer.h>
+#include <libutl/StringVars.h>
+#include <libutl/Uint.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Compare StringVars lookups with String keys (which are hashed and compared character by
+// character) and InternedString keys (which are hashed and compared in constant time).
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const char* names[] = {"HTTP_ACCEPT_ENCODING", "HTTP_USER_AGENT", "CONTENT_LENGTH",
+                              "CONTENT_TYPE",         "QUERY_STRING",    "REQUEST_METHOD",
+                              "SCRIPT_FILENAME",      "SERVER_PROTOCOL", nullptr};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+size_t
+test(const StringVars& vars, size_t numRounds)
+{
+    // make the keys once (as a program would for the names it uses repeatedly)
+    size_t numNames = 0;
+    while (names[numNames] != nullptr)
+        ++numNames;
+    T* keys[numNames];
+    for (size_t i = 0; i != numNames; ++i)
+    {
+        keys[i] = new T(names[i]);
+    }
+
+    size_t res = 0;
+    for (size_t round = 0; round != numRounds; ++round)
+    {
+        for (size_t i = 0; i != numNames; ++i)
+        {
+            res += vars.valueOf(*keys[i]).length();
+        }
+    }
+
+    for (size_t i = 0; i != numNames; ++i)
+    {
+        delete keys[i];
+    }
+    return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    if (argc > 2)
+    {
+        cerr << "InternedString [numRounds (1000000)]" << endl;
+        return 1;
+    }
+    size_t numRounds = (argc > 1) ? Uint(argv[1]).get() : 1000000;
+
+    StringVars vars;
+    for (auto name = names; *name != nullptr; ++name)
+    {
+        vars.setValue(*name, "value");
+    }
+
+    OStimer timer;
+    timer.start();
+    size_t stringLen = test<String>(vars, numRounds);
+    timer.stop();
+    cout << "String keys:         " << timer.userTime() << " sec." << endl;
+    timer.start();
+    size_t internedLen = test<InternedString>(vars, numRounds);
+    timer.stop();
+    cout << "InternedString keys: " << timer.userTime() << " sec." << endl;
+    ASSERT(stringLen == internedLen);
+    cout << "interned strings: " << Uint(InternedString::count()).toString() << endl;
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/BufferedFDstream.h>
+#include <libutl/Hashtable.h>
+#include <libutl/InternedString.h>
+#include <libutl/MemoryCensus.h>
+#include <libutl/ObjectCache.h>
+#include <libutl/OStimer.h>
+#include <libutl/Pair.h>
+#include <libutl/Uint.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Build a few global tables, register them as census roots, and report the memory they hold
+// (as text and as JSON), along with the time it takes to take the census.
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    if (argc > 2)
+    {
+        cerr << "MemoryCensus [numItems (100000)]" << endl;
+        return 1;
+    }
+    size_t numItems = (argc > 1) ? Uint(argv[1]).get() : 100000;
+
+    // a symbol table (name -> value)
+    Hashtable symbols;
+    for (size_t i = 0; i != numItems; ++i)
+    {
+        String name = "symbol" + Uint(i).toString();
+        symbols += new Pair(name.clone(), new Uint(i));
+    }
+
+    // a cache of recently used strings
+    ObjectCache cache(numItems / 10);
+    for (size_t i = 0; i != numItems; ++i)
+    {
+        cache.add(new String("cached" + Uint(i).toString()));
+    }
+
+    // interned strings
+    for (size_t i = 0; i != numItems / 10; ++i)
+    {
+        InternedString("interned" + Uint(i).toString());
+    }
+
+    MemoryCensus::addRoot(&symbols, "symbols");
+    MemoryCensus::addRoot(&cache, "cache");
+
+    MemoryCensus census;
+    OStimer timer;
+    timer.start();
+    census.take();
+    timer.stop();
+
+    census.report(cout);
+    cout << endl;
+    census.report(cout, census_json);
+    cout << endl
+         << "census of " << Uint(census.objects()).toString() << " objects: " << timer.userTime()
+         << " sec." << endl;
+    ASSERT(census.objects(CLASS(Pair)) == numItems);
+
+    MemoryCensus::removeRoot(&symbols);
+    MemoryCensus::removeRoot(&cache);
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/BufferedFDstream.h>
+#include <libutl/BufferedFileStream.h>
+#include <libutl/CmdLineArgs.h>
+#include <libutl/MD5.h>
+#include <libutl/MmapStream.h>
+#include <libutl/OStimer.h>
+#include <libutl/Uint.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Compare reading a file through BufferedFileStream (which copies it into a buffer with read(2))
+// with reading it through MmapStream (which maps it): line by line, and computing its MD5 sum.
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static size_t
+countLines(Stream& is)
+{
+    String line;
+    size_t numLines = 0;
+    try
+    {
+        for (;;)
+        {
+            is >> line;
+            ++numLines;
+        }
+    }
+    catch (StreamEOFex&)
+    {
+    }
+    return numLines;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    CmdLineArgs args(argc, argv);
+    if (args.items() != 2)
+    {
+        cout << "Usage: " << args(0) << " <infile>" << endl;
+        return 1;
+    }
+    Pathname path = args(1);
+    OStimer timer;
+
+    timer.start();
+    BufferedFileStream bfs(path, io_rd);
+    size_t bfsLines = countLines(bfs);
+    timer.stop();
+    cout << "BufferedFileStream readLine: " << timer.totalTime() << " sec." << endl;
+
+    timer.start();
+    MmapStream ms(path);
+    size_t msLines = countLines(ms);
+    timer.stop();
+    cout << "MmapStream readLine:         " << timer.totalTime() << " sec." << endl;
+    ASSERT(bfsLines == msLines);
+
+    timer.start();
+    BufferedFileStream bfs2(path, io_rd);
+    MD5sum bfsSum = MD5::compute(bfs2);
+    timer.stop();
+    cout << "BufferedFileStream MD5:      " << timer.totalTime() << " sec." << endl;
+
+    timer.start();
+    ms.seek(0);
+    MD5sum msSum = MD5::compute(ms);
+    timer.stop();
+    cout << "MmapStream MD5:              " << timer.totalTime() << " sec." << endl;
+    ASSERT(bfsSum.compare(msSum) == 0);
+
+    cout << "lines: " << Uint(msLines).toString() << ", MD5: " << msSum.toString() << endl;
+    return 0;
+}
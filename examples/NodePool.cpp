@@ -0,0 +1,173 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/Array.h>
+#include <libutl/AutoPtr.h>
+#include <libutl/BufferedFDstream.h>
+#include <libutl/Hashtable.h>
+#include <libutl/List.h>
+#include <libutl/OStimer.h>
+#include <libutl/RBtree.h>
+#include <libutl/SkipList.h>
+#include <libutl/Uint.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// make a collection of the given type, with or without a node pool
+Collection*
+makeCollection(uint_t type, bool nodePool)
+{
+    switch (type)
+    {
+    case 0:
+    {
+        auto list = new List(false);
+        list->setNodePool(nodePool);
+        return list;
+    }
+    case 1:
+    {
+        auto ht = new Hashtable(false);
+        ht->setNodePool(nodePool);
+        return ht;
+    }
+    case 2:
+    {
+        auto tree = new RBtree(false);
+        tree->setNodePool(nodePool);
+        return tree;
+    }
+    default:
+    {
+        auto sl = new SkipList(false, false, nullptr, 24);
+        sl->setNodePool(nodePool);
+        return sl;
+    }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+testPerformance(uint_t type, bool nodePool, const Array& array, size_t numRounds)
+{
+    size_t numItems = array.items();
+    AutoPtr<Collection> col = makeCollection(type, nodePool);
+    cout << col->getClassName() << (nodePool ? " (NodePool):" : ":") << endl;
+    bool isList = col->isA(List);
+
+    // fill, iterate, remove every other object, clear (numRounds times)
+    OStimer addTimer, iterateTimer, removeTimer, clearTimer;
+    size_t memSize = 0;
+    for (size_t round = 0; round != numRounds; ++round)
+    {
+        addTimer.start();
+        for (size_t i = 0; i != numItems; ++i)
+        {
+            col->add(array[i]);
+        }
+        addTimer.stop();
+        ASSERT(col->items() == numItems);
+        memSize = col->innerAllocatedSize();
+
+        iterateTimer.start();
+        size_t count = 0;
+        AutoPtr<BidIt> it = col->beginNew();
+        for (; !it->isEnd(); it->forward())
+        {
+            ++count;
+        }
+        iterateTimer.stop();
+        ASSERT(count == numItems);
+
+        // (removing from a list is a linear search, so do fewer of those)
+        removeTimer.start();
+        size_t lim = isList ? min(numItems, (size_t)1000) : numItems;
+        for (size_t i = 0; i < lim; i += 2)
+        {
+            ASSERT(col->remove(*array[i]));
+        }
+        removeTimer.stop();
+
+        clearTimer.start();
+        col->clear();
+        clearTimer.stop();
+        ASSERT(col->empty());
+    }
+
+    cout << "    add:      " << addTimer.userTime() << " sec." << endl;
+    cout << "    iterate:  " << iterateTimer.userTime() << " sec." << endl;
+    cout << "    remove:   " << removeTimer.userTime() << " sec." << endl;
+    cout << "    clear:    " << clearTimer.userTime() << " sec." << endl;
+    cout << "    memory:   " << memSize << " bytes" << endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// owned objects, and moving between collections
+void
+testOwner()
+{
+    for (uint_t type = 0; type != 4; ++type)
+    {
+        AutoPtr<Collection> col = makeCollection(type, true);
+        col->setOwner(true);
+        for (size_t i = 0; i != 1000; ++i)
+        {
+            col->add(new Uint(i));
+        }
+        ASSERT(col->remove(Uint(500)));
+        ASSERT(!col->remove(Uint(500)));
+        ASSERT(col->items() == 999);
+
+        // steal() takes the pool along with the nodes
+        AutoPtr<Collection> col2 = makeCollection(type, false);
+        col2->setOwner(true);
+        col2->steal(*col);
+        ASSERT((col2->items() == 999) && (col2->find(Uint(999)) != nullptr));
+        col2->clear();
+        for (size_t i = 0; i != 1000; ++i)
+        {
+            col2->add(new Uint(i));
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    if (argc > 3)
+    {
+        cerr << "NodePool [numItems (1000000)] [numRounds (2)]" << endl;
+        return 1;
+    }
+    size_t numItems = (argc > 1) ? Uint(argv[1]).get() : 1000000;
+    size_t numRounds = (argc > 2) ? Uint(argv[2]).get() : 2;
+
+    testOwner();
+
+    // shuffled array of objects
+    Array array(true);
+    array.reserve(numItems);
+    for (size_t i = 0; i != numItems; ++i)
+    {
+        array += new Uint(i);
+    }
+    array.shuffle();
+
+    cout << "numItems = " << numItems << ", numRounds = " << numRounds << endl;
+    for (uint_t type = 0; type != 4; ++type)
+    {
+        testPerformance(type, false, array, numRounds);
+        testPerformance(type, true, array, numRounds);
+    }
+
+    return 0;
+}
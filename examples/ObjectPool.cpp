@@ -0,0 +1,101 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/BufferedFDstream.h>
+#include <libutl/Int.h>
+#include <libutl/OStimer.h>
+#include <libutl/Thread.h>
+#include <libutl/Uint.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Compare the allocation of Uint objects (which come from an ObjectPool) with the allocation of
+// Int objects (which are the same size, but come from the global heap).
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// allocate a batch of objects, then delete them (numRounds times)
+template <typename T>
+class Worker : public Thread
+{
+public:
+    Worker(size_t numItems, size_t numRounds)
+        : _numItems(numItems)
+        , _numRounds(numRounds)
+    {
+    }
+
+    virtual void*
+    run(void*)
+    {
+        auto objects = new T*[_numItems];
+        for (size_t round = 0; round != _numRounds; ++round)
+        {
+            for (size_t i = 0; i != _numItems; ++i)
+            {
+                objects[i] = new T(i);
+            }
+            for (size_t i = 0; i != _numItems; ++i)
+            {
+                delete objects[i];
+            }
+        }
+        delete[] objects;
+        return nullptr;
+    }
+
+private:
+    size_t _numItems;
+    size_t _numRounds;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+double
+test(size_t numThreads, size_t numItems, size_t numRounds)
+{
+    OStimer timer;
+    timer.start();
+    Thread* threads[numThreads];
+    for (size_t i = 0; i != numThreads; ++i)
+    {
+        threads[i] = new Worker<T>(numItems, numRounds);
+        threads[i]->start();
+    }
+    for (size_t i = 0; i != numThreads; ++i)
+    {
+        threads[i]->join();
+    }
+    timer.stop();
+    return timer.userTime();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    if (argc > 3)
+    {
+        cerr << "ObjectPool [numThreads (4)] [numItems (10000)]" << endl;
+        return 1;
+    }
+    size_t numThreads = (argc > 1) ? Uint(argv[1]).get() : 4;
+    size_t numItems = (argc > 2) ? Uint(argv[2]).get() : 10000;
+    size_t numRounds = 1000;
+
+    cout << "new/delete Int (global heap): " << test<Int>(numThreads, numItems, numRounds)
+         << " sec." << endl;
+    cout << "new/delete Uint (ObjectPool): " << test<Uint>(numThreads, numItems, numRounds)
+         << " sec." << endl;
+    cout << endl;
+    ObjectPool::report(cout);
+
+    return 0;
+}
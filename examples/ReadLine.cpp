@@ -0,0 +1,114 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/BufferedFileStream.h>
+#include <libutl/CmdLineArgs.h>
+#include <libutl/MmapStream.h>
+#include <libutl/OStimer.h>
+#include <libutl/Uint.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Read a large file line by line with BufferedStream::readLine(), BufferedStream::readLineView(),
+// and MmapStream::readLine(), and report the throughput of each in GB/s.
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void
+report(const char* name, size_t numLines, size_t numBytes, double t)
+{
+    cout << name << Uint(numLines).toString() << " lines, " << Uint(numBytes).toString()
+         << " bytes, " << t << " sec., " << ((double)numBytes / t / 1e9) << " GB/s" << endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    CmdLineArgs args(argc, argv);
+    if ((args.items() < 2) || (args.items() > 3))
+    {
+        cout << "Usage: " << args(0) << " <file> [numRounds (5)]" << endl;
+        return 1;
+    }
+    Pathname path = args(1);
+    size_t numRounds = (args.items() > 2) ? Uint(args(2)).get() : 5;
+    OStimer timer;
+    String line;
+
+    // BufferedStream::readLine()
+    size_t rlLines = 0, rlBytes = 0;
+    timer.start();
+    for (size_t round = 0; round != numRounds; ++round)
+    {
+        BufferedFileStream is(path, io_rd);
+        try
+        {
+            for (;;)
+            {
+                is.readLine(line);
+                rlBytes += line.length() + 1;
+                ++rlLines;
+            }
+        }
+        catch (StreamEOFex&)
+        {
+        }
+    }
+    timer.stop();
+    report("readLine:        ", rlLines, rlBytes, timer.totalTime());
+
+    // BufferedStream::readLineView()
+    size_t rlvLines = 0, rlvBytes = 0;
+    timer.start();
+    for (size_t round = 0; round != numRounds; ++round)
+    {
+        BufferedFileStream is(path, io_rd);
+        try
+        {
+            for (;;)
+            {
+                const char* lineView;
+                rlvBytes += is.readLineView(lineView) + 1;
+                ++rlvLines;
+            }
+        }
+        catch (StreamEOFex&)
+        {
+        }
+    }
+    timer.stop();
+    report("readLineView:    ", rlvLines, rlvBytes, timer.totalTime());
+
+    // MmapStream::readLine()
+    size_t msLines = 0, msBytes = 0;
+    timer.start();
+    for (size_t round = 0; round != numRounds; ++round)
+    {
+        MmapStream ms(path, mmap_sequential);
+        try
+        {
+            for (;;)
+            {
+                ms.readLine(line);
+                msBytes += line.length() + 1;
+                ++msLines;
+            }
+        }
+        catch (StreamEOFex&)
+        {
+        }
+    }
+    timer.stop();
+    report("MmapStream:      ", msLines, msBytes, timer.totalTime());
+
+    ASSERT((rlLines == rlvLines) && (rlLines == msLines));
+    ASSERT((rlBytes == rlvBytes) && (rlBytes == msBytes));
+    return 0;
+}
@@ -12,9 +12,33 @@ UTL_MAIN_RL(Test);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// grow a string through searchReplace() well past the size of its character array
+static void
+testSearchReplace()
+{
+    String str;
+    for (size_t i = 0; i != 200; ++i)
+        str += "ab-";
+    Regex regex("b");
+    bool ok = regex.compile();
+    ASSERT(ok);
+    size_t numReplaced = regex.searchReplace(str, "XYZW");
+    ASSERT(numReplaced == 200);
+    ASSERT(str.length() == (200 * 6));
+    String expected;
+    for (size_t i = 0; i != 200; ++i)
+        expected += "aXYZW-";
+    ASSERT(str == expected);
+    cout << "searchReplace: " << numReplaced << " replacements, length = " << str.length()
+         << endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 int
 Test::run(int, char**)
 {
+    testSearchReplace();
     for (;;)
     {
         Regex regex;
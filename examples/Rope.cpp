@@ -0,0 +1,116 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/BufferedFDstream.h>
+#include <libutl/FDstream.h>
+#include <libutl/OStimer.h>
+#include <libutl/Rope.h>
+#include <libutl/Uint.h>
+#include <fcntl.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Compare building a document by appending and prepending to a String and to a Rope, and writing
+// the result to a file (through a flattened String, and directly from the Rope's pieces).
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const char* line = "<tr><td>name</td><td>value</td></tr>\n";
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+String
+buildString(size_t numLines)
+{
+    String body;
+    for (size_t i = 0; i != numLines; ++i)
+    {
+        body += line;
+    }
+    String doc = "<table>\n";
+    doc += body;
+    doc += "</table>\n";
+    body = doc;
+    doc = "<html><body>\n";
+    doc += body;
+    doc += "</body></html>\n";
+    return doc;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Rope
+buildRope(size_t numLines)
+{
+    Rope doc;
+    for (size_t i = 0; i != numLines; ++i)
+    {
+        doc += line;
+    }
+    doc.prepend("<table>\n");
+    doc += "</table>\n";
+    doc.prepend("<html><body>\n");
+    doc += "</body></html>\n";
+    return doc;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    if (argc > 3)
+    {
+        cerr << "Rope [numLines (100000)] [numRounds (100)]" << endl;
+        return 1;
+    }
+    size_t numLines = (argc > 1) ? Uint(argv[1]).get() : 100000;
+    size_t numRounds = (argc > 2) ? Uint(argv[2]).get() : 100;
+
+    FDstream os(::open("/dev/null", O_WRONLY), io_wr);
+    OStimer timer;
+    size_t stringLen = 0, ropeLen = 0, flatLen = 0;
+
+    timer.start();
+    for (size_t round = 0; round != numRounds; ++round)
+    {
+        String doc = buildString(numLines);
+        os << doc;
+        stringLen += doc.length();
+    }
+    timer.stop();
+    cout << "String (build + write):       " << timer.userTime() << " sec." << endl;
+
+    timer.start();
+    for (size_t round = 0; round != numRounds; ++round)
+    {
+        Rope doc = buildRope(numLines);
+        String flat = doc.toString();
+        os << flat;
+        flatLen += flat.length();
+    }
+    timer.stop();
+    cout << "Rope (build + flatten):       " << timer.userTime() << " sec." << endl;
+
+    timer.start();
+    for (size_t round = 0; round != numRounds; ++round)
+    {
+        Rope doc = buildRope(numLines);
+        os << doc;
+        ropeLen += doc.length();
+    }
+    timer.stop();
+    cout << "Rope (build + writev):        " << timer.userTime() << " sec." << endl;
+    ASSERT((stringLen == ropeLen) && (flatLen == ropeLen));
+
+    Rope doc = buildRope(numLines);
+    cout << "length: " << Uint(doc.length()).toString()
+         << ", pieces: " << Uint(doc.numPieces()).toString() << endl;
+
+    return 0;
+}
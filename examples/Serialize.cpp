@@ -0,0 +1,87 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/BufferedFileStream.h>
+#include <libutl/CmdLineArgs.h>
+#include <libutl/OStimer.h>
+#include <libutl/Uint.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Serialize integers (in ser_compact mode) to a file and read them back through a plain Stream&
+// reference, so that every byte goes through Stream::put() and Stream::get().
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void
+writeInts(Stream& os, size_t num)
+{
+    for (size_t i = 0; i != num; ++i)
+    {
+        uint32_t u32 = i * 2654435761U;
+        uint64_t u64 = (uint64_t)u32 << 16;
+        utl::serialize(u32, os, io_wr, ser_compact);
+        utl::serialize(u64, os, io_wr, ser_compact);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static size_t
+readInts(Stream& is, size_t num)
+{
+    size_t numBad = 0;
+    for (size_t i = 0; i != num; ++i)
+    {
+        uint32_t u32;
+        uint64_t u64;
+        utl::serialize(u32, is, io_rd, ser_compact);
+        utl::serialize(u64, is, io_rd, ser_compact);
+        if ((u32 != (uint32_t)(i * 2654435761U)) || (u64 != ((uint64_t)u32 << 16)))
+            ++numBad;
+    }
+    return numBad;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    CmdLineArgs args(argc, argv);
+    if ((args.items() < 2) || (args.items() > 3))
+    {
+        cout << "Usage: " << args(0) << " <file> [numItems (10000000)]" << endl;
+        return 1;
+    }
+    Pathname path = args(1);
+    size_t numItems = (args.items() > 2) ? Uint(args(2)).get() : 10000000;
+    OStimer timer;
+
+    timer.start();
+    {
+        BufferedFileStream os(path, fs_clobber);
+        writeInts(os, numItems);
+    }
+    timer.stop();
+    cout << "write: " << timer.totalTime() << " sec." << endl;
+
+    timer.start();
+    size_t numBad;
+    {
+        BufferedFileStream is(path, io_rd);
+        numBad = readInts(is, numItems);
+    }
+    timer.stop();
+    cout << "read:  " << timer.totalTime() << " sec." << endl;
+
+    ASSERT(numBad == 0);
+    cout << Uint(numItems).toString() << " items, " << Uint(numItems * 12).toString() << " bytes"
+         << endl;
+    return 0;
+}
@@ -3,6 +3,8 @@
 #include <libutl/Bool.h>
 #include <libutl/BufferedFDstream.h>
 #include <libutl/String.h>
+#include <libutl/StringVars.h>
+#include <libutl/Uint.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -12,6 +14,56 @@ UTL_MAIN_RL(Test);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// count calls to the global allocator (when libUTL doesn't provide its own operator new)
+#if (UTL_GBLNEW_MODE == UTL_GBLNEW_MODE_RELEASE) && !UTL_GBLNEW_PROFILE
+#define ALLOC_COUNTING
+static size_t numAllocs = 0;
+
+// (new and delete aren't inlined, so the compiler doesn't pair an inlined malloc() or free() with
+// the other side's out-of-line call)
+void* __attribute__((noinline))
+operator new(size_t size)
+{
+    ++numAllocs;
+    void* ptr = ::malloc(size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void*
+operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void __attribute__((noinline))
+operator delete(void* ptr) noexcept
+{
+    ::free(ptr);
+}
+
+void
+operator delete[](void* ptr) noexcept
+{
+    operator delete(ptr);
+}
+
+void
+operator delete(void* ptr, size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+void
+operator delete[](void* ptr, size_t) noexcept
+{
+    operator delete(ptr);
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void
 printTokens(const String& str, bool pq)
 {
@@ -28,8 +80,48 @@ printTokens(const String& str, bool pq)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// parse HTTP-style header lines into a StringVars, then look up each header
+size_t
+parseHeaders(size_t numRounds)
+{
+    static const char* headers[] = {"Host: www.example.com",
+                                    "User-Agent: libUTL/1.0",
+                                    "Accept: text/html, */*",
+                                    "Accept-Encoding: gzip",
+                                    "Connection: keep-alive",
+                                    "Content-Type: text/plain",
+                                    "Content-Length: 1234",
+                                    "Cache-Control: no-cache",
+                                    nullptr};
+    size_t res = 0;
+    for (size_t round = 0; round != numRounds; ++round)
+    {
+        StringVars vars;
+        for (auto hdr = headers; *hdr != nullptr; ++hdr)
+        {
+            String line = *hdr;
+            size_t colonIdx = line.find(':');
+            String name = line.subString(0, colonIdx);
+            String value = line.subString(colonIdx + 1);
+            name.toLower();
+            value.trim();
+            vars.setValue(name, value);
+        }
+        for (auto hdr = headers; *hdr != nullptr; ++hdr)
+        {
+            size_t idx = 0;
+            String name = String(*hdr, false).nextToken(idx, ':');
+            name.toLower();
+            res += vars.valueOf(name).length();
+        }
+    }
+    return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 int
-Test::run(int, char**)
+Test::run(int argc, char** argv)
 {
     const char* string_0 = "  abcd efgh  ";
     const char* string_1 = "abcd efgh";
@@ -40,5 +132,15 @@ Test::run(int, char**)
     test = "a ,  bb, cc, d'  ' , eee";
     printTokens(test, true);
     printTokens(test, false);
+
+    size_t numRounds = (argc > 1) ? Uint(argv[1]).get() : 1000;
+#ifdef ALLOC_COUNTING
+    size_t allocs = numAllocs;
+#endif
+    parseHeaders(numRounds);
+#ifdef ALLOC_COUNTING
+    cout << "parsed headers " << Uint(numRounds).toString() << " times: "
+         << Uint(numAllocs - allocs).toString() << " allocations" << endl;
+#endif
     return 0;
 }
@@ -0,0 +1,134 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/Array.h>
+#include <libutl/BufferedFDstream.h>
+#include <libutl/Hashtable.h>
+#include <libutl/OStimer.h>
+#include <libutl/Pair.h>
+#include <libutl/THashMap.h>
+#include <libutl/Uint.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const size_t numItems = 1000000;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+testMap()
+{
+    THashMap<size_t, size_t> map;
+
+    // add items
+    size_t i;
+    for (i = 0; i < numItems; ++i)
+    {
+        ASSERT(map.add(i, i * 2));
+    }
+    ASSERT(!map.add(0, 0));
+    ASSERT(map.size() == numItems);
+
+    // find items
+    for (i = 0; i < numItems; ++i)
+    {
+        ASSERT(*map.get(i) == (i * 2));
+    }
+    ASSERT(map.get(numItems) == nullptr);
+
+    // remove every 10th item while iterating
+    auto it = map.begin();
+    while (it != map.end())
+    {
+        if ((it->first % 10) == 0)
+            map.removeIt(it);
+        else
+            ++it;
+    }
+    ASSERT(map.size() == (numItems - (numItems / 10)));
+    for (i = 0; i < numItems; ++i)
+    {
+        ASSERT(map.has(i) == ((i % 10) != 0));
+    }
+
+    // copy & compare
+    auto copy = map;
+    for (auto& entry : map)
+    {
+        ASSERT(*copy.get(entry.first) == entry.second);
+    }
+
+    // values can be modified through an iterator (but keys can't)
+    static_assert(std::is_same<decltype(*map.begin()), std::pair<const size_t, size_t>&>::value,
+                  "THashMap entries must have const keys");
+    for (auto& entry : copy)
+    {
+        entry.second = entry.first * 3;
+    }
+    for (i = 1; i < numItems; i += 10)
+    {
+        ASSERT(*copy.get(i) == (i * 3));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int, char**)
+{
+    testMap();
+
+    // heterogeneous lookup: find String keys with const char*
+    THashMap<String, size_t> wordCounts;
+    const char* words[] = {"the", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "dog"};
+    for (auto word : words)
+    {
+        ++wordCounts[word];
+    }
+    cout << "\"the\" appears " << *wordCounts.get("the") << " times" << endl;
+    cout << "\"fox\" appears " << *wordCounts.get("fox") << " times" << endl;
+    ASSERT(!wordCounts.has("cat"));
+
+    // compare with a Hashtable of Pair objects
+    Array keys;
+    size_t i;
+    for (i = 0; i < numItems; ++i)
+    {
+        keys += new String(Uint(i).toString());
+    }
+    keys.shuffle();
+
+    OStimer timer;
+    Hashtable ht;
+    timer.start();
+    for (i = 0; i < numItems; ++i)
+    {
+        ht += new Pair(keys(i), Uint(i));
+    }
+    for (i = 0; i < numItems; ++i)
+    {
+        ASSERT(ht.find(keys(i)) != nullptr);
+    }
+    timer.stop();
+    cout << "Hashtable of Pair:        " << timer.userTime() << " sec." << endl;
+
+    THashMap<String, size_t> map;
+    timer.start();
+    for (i = 0; i < numItems; ++i)
+    {
+        map.add(utl::cast<String>(keys(i)), i);
+    }
+    for (i = 0; i < numItems; ++i)
+    {
+        ASSERT(map.get(utl::cast<String>(keys(i))) != nullptr);
+    }
+    timer.stop();
+    cout << "THashMap<String, size_t>: " << timer.userTime() << " sec." << endl;
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/BufferedFileStream.h>
+#include <libutl/BufferedTCPsocket.h>
+#include <libutl/CmdLineArgs.h>
+#include <libutl/OStimer.h>
+#include <libutl/TCPserverSocket.h>
+#include <libutl/Thread.h>
+#include <libutl/Uint.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Send a file to a client over a local TCP connection (several times), by copying it through
+// BufferedFileStream, and with transferFrom() (which uses sendfile(2)).
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const uint16_t port = 23456;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// receive everything sent on a connection (and count the bytes)
+class Receiver : public Thread
+{
+public:
+    Receiver(TCPserverSocket& server)
+        : _server(server)
+        , _numBytes(0)
+    {
+    }
+
+    virtual void*
+    run(void*)
+    {
+        TCPsocket socket;
+        _server.accept(&socket);
+        byte_t buf[65536];
+        try
+        {
+            for (;;)
+            {
+                _numBytes += socket.read(buf, sizeof(buf), 1);
+            }
+        }
+        catch (StreamEOFex&)
+        {
+        }
+        return nullptr;
+    }
+
+    size_t
+    numBytes() const
+    {
+        return _numBytes;
+    }
+
+private:
+    TCPserverSocket& _server;
+    size_t _numBytes;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static size_t
+send(TCPserverSocket& server, const Pathname& path, size_t numRounds, bool sendfile)
+{
+    auto receiver = new Receiver(server);
+    receiver->start();
+    {
+        BufferedTCPsocket socket(InetHostAddress(127, 0, 0, 1), port);
+        for (size_t round = 0; round != numRounds; ++round)
+        {
+            socket << "HTTP/1.1 200 OK\r\n\r\n";
+            if (sendfile)
+            {
+                FileStream file(path, io_rd);
+                socket.transferFrom(file, 0, file.length());
+            }
+            else
+            {
+                BufferedFileStream file(path, io_rd);
+                socket.copyData(file);
+            }
+        }
+        socket.flush();
+    }
+    receiver->join(false);
+    size_t numBytes = receiver->numBytes();
+    delete receiver;
+    return numBytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    CmdLineArgs args(argc, argv);
+    if ((args.items() < 2) || (args.items() > 3))
+    {
+        cout << "Usage: " << args(0) << " <file> [numRounds (10)]" << endl;
+        return 1;
+    }
+    Pathname path = args(1);
+    size_t numRounds = (args.items() > 2) ? Uint(args(2)).get() : 10;
+
+    InetHostAddress addr(127, 0, 0, 1);
+    TCPserverSocket server(&addr, port);
+    OStimer timer;
+
+    timer.start();
+    size_t copyBytes = send(server, path, numRounds, false);
+    timer.stop();
+    cout << "copy:         " << timer.totalTime() << " sec." << endl;
+
+    timer.start();
+    size_t sendfileBytes = send(server, path, numRounds, true);
+    timer.stop();
+    cout << "transferFrom: " << timer.totalTime() << " sec." << endl;
+
+    ASSERT(copyBytes == sendfileBytes);
+    cout << "bytes sent: " << Uint(sendfileBytes).toString() << endl;
+    return 0;
+}
@@ -0,0 +1,251 @@
+#include <libutl/libutl.h>
+#include <libutl/Application.h>
+#include <libutl/AutoPtr.h>
+#include <libutl/BufferedFDstream.h>
+#include <libutl/ConcurrentQueue.h>
+#include <libutl/Float.h>
+#include <libutl/Hashtable.h>
+#include <libutl/List.h>
+#include <libutl/RBtree.h>
+#include <libutl/String.h>
+#include <libutl/Thread.h>
+#include <libutl/Uint.h>
+#include <chrono>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Benchmark global new/delete with libutl's containers.
+//
+// Build libutl with and without -DLIBUTL_GBLNEW_FAST=ON and compare the results: the default
+// build uses the system allocator (glibc malloc), the other uses the thread-caching allocator.
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+UTL_APP(Test);
+UTL_MAIN_RL(Test);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template class ConcurrentQueue<size_t>;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const size_t endOfStream = size_t_max;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Timer
+{
+public:
+    Timer()
+    {
+        _startTime = std::chrono::steady_clock::now();
+    }
+
+    double
+    elapsed() const
+    {
+        auto endTime = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(endTime - _startTime).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point _startTime;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// fill a collection with boxed objects, then clear it (which deletes them)
+void
+fillAndClear(Collection& col, size_t numItems, size_t numRounds, bool strings)
+{
+    for (size_t round = 0; round != numRounds; ++round)
+    {
+        for (size_t i = 0; i != numItems; ++i)
+        {
+            if (strings)
+                col.add(new String(Uint(i).toString()));
+            else
+                col.add(new Uint(i));
+        }
+        col.clear();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// fill and clear a collection of each type
+class Worker : public Thread
+{
+public:
+    Worker(size_t numItems, size_t numRounds)
+        : _numItems(numItems)
+        , _numRounds(numRounds)
+    {
+    }
+
+    virtual void* run(void*);
+
+private:
+    size_t _numItems;
+    size_t _numRounds;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void*
+Worker::run(void*)
+{
+    List list(true);
+    Hashtable ht(true);
+    RBtree tree(true);
+    fillAndClear(list, _numItems, _numRounds, true);
+    fillAndClear(ht, _numItems, _numRounds, false);
+    fillAndClear(tree, _numItems, _numRounds, false);
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// allocate objects and pass them to a consumer
+class Producer : public Thread
+{
+public:
+    Producer(ConcurrentQueue<size_t>& q, size_t count)
+        : _q(q)
+        , _count(count)
+    {
+    }
+
+    virtual void* run(void*);
+
+private:
+    ConcurrentQueue<size_t>& _q;
+    size_t _count;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void*
+Producer::run(void*)
+{
+    for (size_t i = 0; i != _count; ++i)
+    {
+        _q.enQ(reinterpret_cast<size_t>(new Uint(i)));
+    }
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// delete objects allocated by producers (until an end-of-stream marker is seen)
+class Consumer : public Thread
+{
+public:
+    Consumer(ConcurrentQueue<size_t>& q)
+        : _q(q)
+    {
+    }
+
+    virtual void* run(void*);
+
+private:
+    ConcurrentQueue<size_t>& _q;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void*
+Consumer::run(void*)
+{
+    size_t val;
+    while (_q.deQwait(val))
+    {
+        if (val == endOfStream)
+        {
+            _q.enQ(endOfStream);
+            break;
+        }
+        delete reinterpret_cast<Uint*>(val);
+    }
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double
+testLocal(size_t numThreads, size_t numItems, size_t numRounds)
+{
+    Timer timer;
+    Thread* threads[numThreads];
+    for (size_t i = 0; i != numThreads; ++i)
+    {
+        threads[i] = new Worker(numItems, numRounds);
+        threads[i]->start();
+    }
+    for (size_t i = 0; i != numThreads; ++i)
+    {
+        threads[i]->join();
+    }
+    return timer.elapsed();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double
+testRemote(size_t numPairs, size_t count)
+{
+    Timer timer;
+    ConcurrentQueue<size_t> q(true);
+    Thread* producers[numPairs];
+    Thread* consumers[numPairs];
+    for (size_t i = 0; i != numPairs; ++i)
+    {
+        consumers[i] = new Consumer(q);
+        consumers[i]->start();
+        producers[i] = new Producer(q, count);
+        producers[i]->start();
+    }
+    for (size_t i = 0; i != numPairs; ++i)
+    {
+        producers[i]->join();
+    }
+    q.enQ(endOfStream);
+    for (size_t i = 0; i != numPairs; ++i)
+    {
+        consumers[i]->join();
+    }
+    return timer.elapsed();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Test::run(int argc, char** argv)
+{
+    if (argc > 3)
+    {
+        cerr << "gblnew [numThreads (4)] [numItems (100000)]" << endl;
+        return 1;
+    }
+    size_t numThreads = (argc > 1) ? Uint(argv[1]).get() : 4;
+    size_t numItems = (argc > 2) ? Uint(argv[2]).get() : 100000;
+
+#if UTL_GBLNEW_MODE == UTL_GBLNEW_MODE_FAST
+    cout << "allocator: fast" << endl;
+#else
+    cout << "allocator: system" << endl;
+#endif
+
+    cout << "fill/clear List, Hashtable, RBtree (1 thread): "
+         << Float(testLocal(1, numItems, 10)).toString(2) << " sec." << endl;
+    cout << "fill/clear List, Hashtable, RBtree (" << numThreads
+         << " threads): " << Float(testLocal(numThreads, numItems, 10)).toString(2) << " sec."
+         << endl;
+    cout << "new in producer, delete in consumer (" << numThreads
+         << " pairs): " << Float(testRemote(numThreads, numItems * 10)).toString(2) << " sec."
+         << endl;
+
+    return 0;
+}
@@ -6,6 +6,7 @@
 #include <libutl/OStimer.h>
 #include <libutl/RandUtils.h>
 #include <libutl/Uint.h>
+#include <chrono>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -50,7 +51,8 @@ Test::run(int, char**)
     ASSERTD(list.testSorted());
     cout << "    user time = " << Float(timer.userTime()).toString(2) << " sec." << endl;
 
-    cout << "Array std::sort" << endl;
+    // an array of Uint objects under the natural ordering is radix-sorted
+    cout << "Array radix sort" << endl;
     Array array(false);
     array = unsorted;
     timer.start();
@@ -59,5 +61,50 @@ Test::run(int, char**)
     ASSERTD(array.testSorted());
     cout << "    user time = " << Float(timer.userTime()).toString(2) << " sec." << endl;
 
+    // (any other ordering requires a comparison sort)
+    cout << "Array std::sort" << endl;
+    Array keyArray(false);
+    keyArray.setOrdering(keyOrdering, sort_none);
+    keyArray = unsorted;
+    timer.start();
+    keyArray.sort();
+    timer.stop();
+    ASSERTD(keyArray.testSorted());
+    cout << "    user time = " << Float(timer.userTime()).toString(2) << " sec." << endl;
+
+    // user time is summed over all threads, so show the elapsed time too
+    cout << "Array parallel merge-sort" << endl;
+    array = unsorted;
+    timer.start();
+    auto startTime = std::chrono::steady_clock::now();
+    array.sort(sort_parallelMergeSort);
+    auto endTime = std::chrono::steady_clock::now();
+    timer.stop();
+    ASSERTD(array.testSorted());
+    cout << "    user time = " << Float(timer.userTime()).toString(2) << " sec." << endl;
+    cout << "    real time = "
+         << Float(std::chrono::duration<double>(endTime - startTime).count()).toString(2)
+         << " sec." << endl;
+
+    Vector<uint64_t> vect(numItems);
+    for (i = 0; i != numItems; ++i)
+    {
+        vect[i] = utl::cast<Uint>(unsorted[i])->get();
+    }
+    Vector<uint64_t> vectCopy = vect;
+
+    cout << "Vector<uint64_t> std::sort" << endl;
+    timer.start();
+    std::sort(vect.begin(), vect.end());
+    timer.stop();
+    cout << "    user time = " << Float(timer.userTime()).toString(2) << " sec." << endl;
+
+    cout << "Vector<uint64_t> radix sort" << endl;
+    timer.start();
+    radixSort(vectCopy);
+    timer.stop();
+    ASSERT(vectCopy == vect);
+    cout << "    user time = " << Float(timer.userTime()).toString(2) << " sec." << endl;
+
     return 0;
 }
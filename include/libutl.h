@@ -42,6 +42,7 @@
 #include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <type_traits>
 
@@ -79,5 +80,6 @@ UTL_NS_DECLARE;
 #include <libutl/util.h>
 #include <libutl/gblnew.h>
 #include <libutl/RunTimeClass.h>
+#include <libutl/ObjectPool.h>
 #include <libutl/Object.h>
 #include <libutl/util_inl.h>
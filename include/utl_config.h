@@ -7,6 +7,7 @@
 #define UTL_GBLNEW_MODE_DEBUG 1
 #define UTL_GBLNEW_MODE_DEBUG_MSVC 2
 #define UTL_GBLNEW_MODE_RELEASE 3
+#define UTL_GBLNEW_MODE_FAST 4
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -22,3 +23,18 @@
 #define UTL_GBLNEW_MODE UTL_GBLNEW_MODE_RELEASE
 #endif
 #endif
+
+// the fast (thread-caching) allocator needs mmap() and pthreads
+#if (UTL_GBLNEW_MODE == UTL_GBLNEW_MODE_FAST) && (UTL_HOST_TYPE != UTL_HT_UNIX)
+#error UTL_GBLNEW_MODE_FAST requires a UNIX host.
+#endif
+
+// sampling allocation profiler (see gblnew.h)
+#ifndef UTL_GBLNEW_PROFILE
+#define UTL_GBLNEW_PROFILE 0
+#endif
+#if UTL_GBLNEW_PROFILE &&                                                                          \
+    (((UTL_GBLNEW_MODE != UTL_GBLNEW_MODE_RELEASE) && (UTL_GBLNEW_MODE != UTL_GBLNEW_MODE_FAST)) || \
+     (UTL_HOST_TYPE != UTL_HT_UNIX))
+#error UTL_GBLNEW_PROFILE requires UNIX, and UTL_GBLNEW_MODE_RELEASE or UTL_GBLNEW_MODE_FAST.
+#endif
@@ -0,0 +1 @@
+../ubc/Arena.h
\ No newline at end of file
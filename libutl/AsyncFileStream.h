@@ -0,0 +1 @@
+../uio/AsyncFileStream.h
\ No newline at end of file
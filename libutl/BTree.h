@@ -0,0 +1 @@
+../ucc/BTree.h
\ No newline at end of file
@@ -0,0 +1 @@
+../ucc/BTreeIt.h
\ No newline at end of file
@@ -0,0 +1 @@
+../ucc/BoundedQueue.h
\ No newline at end of file
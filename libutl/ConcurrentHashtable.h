@@ -0,0 +1 @@
+../ucc/ConcurrentHashtable.h
\ No newline at end of file
@@ -0,0 +1 @@
+../ucc/ConcurrentHashtableIt.h
\ No newline at end of file
@@ -0,0 +1 @@
+../ucc/ConcurrentSkipList.h
\ No newline at end of file
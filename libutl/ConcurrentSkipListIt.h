@@ -0,0 +1 @@
+../ucc/ConcurrentSkipListIt.h
\ No newline at end of file
@@ -0,0 +1 @@
+../uts/Futex.h
\ No newline at end of file
@@ -0,0 +1 @@
+../uio/IOuring.h
\ No newline at end of file
@@ -0,0 +1 @@
+../ust/InternedString.h
\ No newline at end of file
@@ -0,0 +1 @@
+../ubc/MemoryCensus.h
\ No newline at end of file
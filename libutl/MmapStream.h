@@ -0,0 +1 @@
+../uio/MmapStream.h
\ No newline at end of file
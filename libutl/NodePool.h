@@ -0,0 +1 @@
+../ucc/NodePool.h
\ No newline at end of file
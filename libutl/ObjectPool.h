@@ -0,0 +1 @@
+../ubc/ObjectPool.h
\ No newline at end of file
@@ -0,0 +1 @@
+../ucc/OpenHashtable.h
\ No newline at end of file
@@ -0,0 +1 @@
+../ucc/OpenHashtableIt.h
\ No newline at end of file
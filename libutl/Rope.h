@@ -0,0 +1 @@
+../ust/Rope.h
\ No newline at end of file
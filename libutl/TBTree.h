@@ -0,0 +1 @@
+../ucc/TBTree.h
\ No newline at end of file
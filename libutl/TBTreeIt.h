@@ -0,0 +1 @@
+../ucc/TBTreeIt.h
\ No newline at end of file
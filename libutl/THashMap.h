@@ -0,0 +1 @@
+../ucc/THashMap.h
\ No newline at end of file
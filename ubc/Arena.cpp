@@ -0,0 +1,102 @@
+#include <libutl/libutl.h>
+#include <libutl/Arena.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// chunk header size (keeps allocations aligned as well as the global allocator would)
+static const size_t chunkHeaderSize = alignof(max_align_t);
+
+static const size_t minChunkSize = 4 * 1024;
+static const size_t maxChunkSize = 1024 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Arena::Arena()
+{
+    _chunkSize = minChunkSize;
+    _allocatedSize = 0;
+    _chunks = nullptr;
+    _chunkPtr = _chunkLim = nullptr;
+    _finalizers = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Arena::~Arena()
+{
+    clear();
+    delete[] reinterpret_cast<byte_t*>(_chunks);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+Arena::clear()
+{
+    // destroy objects (most recently constructed first)
+    finalizer_t* fin = _finalizers;
+    _finalizers = nullptr;
+    while (fin != nullptr)
+    {
+        fin->destroy(fin->object);
+        fin = fin->next;
+    }
+
+    // release all chunks except the first one (which is the most recent regular-size chunk)
+    if (_chunks == nullptr)
+        return;
+    chunk_t* chunk = _chunks->next;
+    while (chunk != nullptr)
+    {
+        chunk_t* next = chunk->next;
+        delete[] reinterpret_cast<byte_t*>(chunk);
+        chunk = next;
+    }
+    _chunks->next = nullptr;
+    _allocatedSize = _chunks->size;
+    _chunkPtr = reinterpret_cast<byte_t*>(_chunks) + chunkHeaderSize;
+    _chunkLim = reinterpret_cast<byte_t*>(_chunks) + _chunks->size;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void*
+Arena::allocSlow(size_t size, size_t align)
+{
+    // a large allocation gets a chunk of its own, so the current chunk's free space isn't lost
+    size_t reqSize = chunkHeaderSize + size + ((align > chunkHeaderSize) ? align : 0);
+    if ((_chunks != nullptr) && (reqSize > (_chunkSize / 4)))
+    {
+        auto chunk = reinterpret_cast<chunk_t*>(new byte_t[reqSize]);
+        chunk->next = _chunks->next;
+        chunk->size = reqSize;
+        _chunks->next = chunk;
+        _allocatedSize += reqSize;
+        auto ptr = reinterpret_cast<byte_t*>(chunk) + chunkHeaderSize;
+        return reinterpret_cast<byte_t*>(
+            nextMultipleOfPow2(align, reinterpret_cast<size_t>(ptr)));
+    }
+
+    // start a new chunk (twice the size of the previous one),
+    // .. except that a large first allocation gets a first chunk that's just big enough for it,
+    //    without making the following chunks any larger
+    size_t chunkSize = max(_chunkSize, reqSize);
+    auto chunk = reinterpret_cast<chunk_t*>(new byte_t[chunkSize]);
+    chunk->next = _chunks;
+    chunk->size = chunkSize;
+    _chunks = chunk;
+    _allocatedSize += chunkSize;
+    _chunkPtr = reinterpret_cast<byte_t*>(chunk) + chunkHeaderSize;
+    _chunkLim = reinterpret_cast<byte_t*>(chunk) + chunkSize;
+    if (_chunkSize < maxChunkSize)
+        _chunkSize *= 2;
+    return alloc(size, align);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
@@ -0,0 +1,174 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <type_traits>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Monotonic memory arena.
+
+   Arena serves allocations by bumping a pointer through large chunks of memory, and never frees
+   anything individually.  It's meant for transient structures whose parts all die together,
+   like a parse tree: build the structure in an arena, use it, then clear() the arena to
+   release the whole thing at once.
+
+   create() placement-constructs an object (typically an Object-derived one) in the arena.
+   When the object's class has a non-trivial destructor, create() registers it, and clear()
+   runs the registered destructors in reverse order of construction before releasing the
+   memory.  An object made by create() must never be deleted: whatever refers to it must not
+   own it.  arenaNew() and arenaDelete() help code that works either with or without an arena.
+
+   Chunks start at 4 KB and double in size (up to 1 MB).  A large allocation gets a chunk of its
+   own, which doesn't affect the size of later chunks.  clear() keeps the most recent chunk, so
+   an arena that's re-used (e.g. once per request) settles down to making no calls to the global
+   allocator at all.
+
+   Arena is not thread-safe.
+
+   \author Adam McKee
+   \ingroup utility
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Arena
+{
+public:
+    /** Constructor. */
+    Arena();
+
+    Arena(const Arena&) = delete;
+
+    Arena& operator=(const Arena&) = delete;
+
+    /** Destructor (destroys all objects, releases all chunks). */
+    ~Arena();
+
+    /**
+       Allocate memory.  Like operator new, a zero-size allocation gets a unique non-null pointer.
+       \return allocated memory
+       \param size size of allocation (in bytes)
+       \param align required alignment (a power of 2)
+    */
+    void*
+    alloc(size_t size, size_t align = alignof(max_align_t))
+    {
+        if (size == 0)
+            size = 1;
+        auto ptr = reinterpret_cast<byte_t*>(
+            nextMultipleOfPow2(align, reinterpret_cast<size_t>(_chunkPtr)));
+        if ((ptr > _chunkLim) || (size > (size_t)(_chunkLim - ptr)))
+            return allocSlow(size, align);
+        _chunkPtr = ptr + size;
+        return ptr;
+    }
+
+    /** Construct a T in memory allocated from the arena. */
+    template <typename T, typename... Args>
+    T* create(Args&&... args);
+
+    /** Destroy all objects and release all memory (except the most recent chunk). */
+    void clear();
+
+    /** Get the total size of the allocated chunks. */
+    size_t
+    innerAllocatedSize() const
+    {
+        return _allocatedSize;
+    }
+
+private:
+    struct chunk_t
+    {
+        chunk_t* next;
+        size_t size;
+    };
+
+    struct finalizer_t
+    {
+        finalizer_t* next;
+        void (*destroy)(void*);
+        void* object;
+    };
+
+private:
+    void* allocSlow(size_t size, size_t align);
+
+    template <typename T>
+    static void
+    destroy(void* object)
+    {
+        reinterpret_cast<T*>(object)->~T();
+    }
+
+private:
+    size_t _chunkSize;
+    size_t _allocatedSize;
+    chunk_t* _chunks;
+    byte_t* _chunkPtr;
+    byte_t* _chunkLim;
+    finalizer_t* _finalizers;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#undef new
+
+template <typename T, typename... Args>
+T*
+Arena::create(Args&&... args)
+{
+    void* mem = alloc(sizeof(T), alignof(T));
+    T* object = new (mem) T(std::forward<Args>(args)...);
+    if (!std::is_trivially_destructible<T>::value)
+    {
+        void* finMem = alloc(sizeof(finalizer_t), alignof(finalizer_t));
+        auto fin = reinterpret_cast<finalizer_t*>(finMem);
+        fin->next = _finalizers;
+        fin->destroy = destroy<T>;
+        fin->object = object;
+        _finalizers = fin;
+    }
+    return object;
+}
+
+#include <libutl/gblnew_macros.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Construct a T in the given arena, or on the heap if no arena is given.
+   \ingroup utility
+*/
+template <typename T, typename... Args>
+T*
+arenaNew(Arena* arena, Args&&... args)
+{
+    if (arena == nullptr)
+        return new T(std::forward<Args>(args)...);
+    return arena->template create<T>(std::forward<Args>(args)...);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Delete an object that was made by arenaNew() (does nothing if it's in an arena).
+   \ingroup utility
+*/
+template <typename T>
+void
+arenaDelete(Arena* arena, T* object)
+{
+    if (arena == nullptr)
+        delete object;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
@@ -0,0 +1,305 @@
+#include <libutl/libutl.h>
+#include <libutl/MemoryCensus.h>
+#include <libutl/Mutex.h>
+#include <libutl/Stream.h>
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct CensusRoot
+{
+    const Object* object;
+    char* name;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// registered roots (in order of registration)
+struct CensusRoots
+{
+    Mutex mutex;
+    CensusRoot* roots = nullptr;
+    size_t numRoots = 0;
+    size_t size = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static CensusRoots&
+censusRoots()
+{
+    static CensusRoots roots;
+    return roots;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// write a JSON string (with quotes)
+static void
+census_writeJSON(Stream& os, const char* str)
+{
+    os << '"';
+    for (auto ptr = str; *ptr != '\0'; ++ptr)
+    {
+        char c = *ptr;
+        if ((c == '"') || (c == '\\'))
+        {
+            os << '\\' << c;
+        }
+        else if ((byte_t)c < 0x20)
+        {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", (uint_t)c);
+            os << buf;
+        }
+        else
+        {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MemoryCensus::MemoryCensus()
+    : _roots(nullptr)
+    , _numRoots(0)
+    , _objects(0)
+    , _bytes(0)
+    , _ownedBytes(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MemoryCensus::~MemoryCensus()
+{
+    clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+MemoryCensus::addRoot(const Object* root, const char* name)
+{
+    ASSERTD(root != nullptr);
+    auto& roots = censusRoots();
+    MutexGuard guard(&roots.mutex);
+    if (roots.numRoots == roots.size)
+        arrayGrow(roots.roots, roots.size, roots.numRoots + 1, 16);
+    auto& cr = roots.roots[roots.numRoots++];
+    cr.object = root;
+    cr.name = utl::strdup((name == nullptr) ? root->getClassName() : name);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+MemoryCensus::removeRoot(const Object* root)
+{
+    auto& roots = censusRoots();
+    MutexGuard guard(&roots.mutex);
+    for (size_t i = 0; i != roots.numRoots; ++i)
+    {
+        if (roots.roots[i].object != root)
+            continue;
+        delete[] roots.roots[i].name;
+        --roots.numRoots;
+        memmove(roots.roots + i, roots.roots + i + 1, (roots.numRoots - i) * sizeof(CensusRoot));
+        return;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+MemoryCensus::take()
+{
+    clear();
+
+    // (holding the lock keeps the roots from being removed while we walk them)
+    auto& roots = censusRoots();
+    MutexGuard guard(&roots.mutex);
+    _numRoots = roots.numRoots;
+    _roots = new root_t[_numRoots];
+    for (size_t i = 0; i != _numRoots; ++i)
+    {
+        auto& cr = roots.roots[i];
+        auto& root = _roots[i];
+        root.name = utl::strdup(cr.name);
+        size_t objects = _objects;
+        root.count.bytes = add(*cr.object);
+        root.count.objects = _objects - objects;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+MemoryCensus::add(const Object& object)
+{
+    size_t size = object.allocatedSize();
+
+    // count the objects it owns (each of them adds its size to _ownedBytes)
+    size_t saveOwnedBytes = _ownedBytes;
+    _ownedBytes = 0;
+    object.censusOwned(self);
+    size_t ownedBytes = _ownedBytes;
+    _ownedBytes = saveOwnedBytes + size;
+
+    // charge the remainder to the object's class
+    size_t bytes = (size > ownedBytes) ? (size - ownedBytes) : 0;
+    auto& count = _classes[object.getClass()];
+    ++count.objects;
+    count.bytes += bytes;
+    ++_objects;
+    _bytes += bytes;
+
+    return size;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+MemoryCensus::clear()
+{
+    _classes.clear();
+    for (size_t i = 0; i != _numRoots; ++i)
+    {
+        delete[] _roots[i].name;
+    }
+    delete[] _roots;
+    _roots = nullptr;
+    _numRoots = 0;
+    _objects = 0;
+    _bytes = 0;
+    _ownedBytes = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+MemoryCensus::objects(const RunTimeClass* rtc) const
+{
+    auto count = _classes.get(rtc);
+    return (count == nullptr) ? 0 : count->objects;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+MemoryCensus::bytes(const RunTimeClass* rtc) const
+{
+    auto count = _classes.get(rtc);
+    return (count == nullptr) ? 0 : count->bytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+MemoryCensus::report(Stream& os, uint_t format) const
+{
+    if (format == census_json)
+        reportJSON(os);
+    else
+        reportText(os);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MemoryCensus::class_t*
+MemoryCensus::sortClasses() const
+{
+    // in order of decreasing size (then by name)
+    auto classes = new class_t[_classes.items()];
+    size_t numClasses = 0;
+    for (auto& entry : _classes)
+    {
+        classes[numClasses++] = entry;
+    }
+    std::sort(classes, classes + numClasses, [](const class_t& lhs, const class_t& rhs) {
+        if (lhs.second.bytes != rhs.second.bytes)
+            return (lhs.second.bytes > rhs.second.bytes);
+        return (strcmp(lhs.first->name(), rhs.first->name()) < 0);
+    });
+    return classes;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+MemoryCensus::reportText(Stream& os) const
+{
+    size_t numClasses = _classes.items();
+    auto classes = sortClasses();
+
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%-48s %12s %16s\n", "class", "objects", "bytes");
+    os << buf;
+    for (size_t i = 0; i != numClasses; ++i)
+    {
+        auto& entry = classes[i];
+        auto className = entry.first->name();
+        snprintf(buf, sizeof(buf), "%-48s %12zu %16zu\n", (className == nullptr) ? "?" : className,
+                 entry.second.objects, entry.second.bytes);
+        os << buf;
+    }
+    delete[] classes;
+    snprintf(buf, sizeof(buf), "%-48s %12zu %16zu\n", "(total)", _objects, _bytes);
+    os << buf;
+
+    if (_numRoots == 0)
+        return;
+    snprintf(buf, sizeof(buf), "\n%-48s %12s %16s\n", "root", "objects", "bytes");
+    os << buf;
+    for (size_t i = 0; i != _numRoots; ++i)
+    {
+        auto& root = _roots[i];
+        snprintf(buf, sizeof(buf), "%-48s %12zu %16zu\n", root.name, root.count.objects,
+                 root.count.bytes);
+        os << buf;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+MemoryCensus::reportJSON(Stream& os) const
+{
+    size_t numClasses = _classes.items();
+    auto classes = sortClasses();
+
+    char buf[128];
+    snprintf(buf, sizeof(buf), "{\"objects\":%zu,\"bytes\":%zu,\"classes\":[", _objects, _bytes);
+    os << buf;
+    for (size_t i = 0; i != numClasses; ++i)
+    {
+        auto& entry = classes[i];
+        os << ((i == 0) ? "{\"class\":" : ",{\"class\":");
+        census_writeJSON(os, entry.first->name());
+        snprintf(buf, sizeof(buf), ",\"objects\":%zu,\"bytes\":%zu}", entry.second.objects,
+                 entry.second.bytes);
+        os << buf;
+    }
+    delete[] classes;
+    os << "],\"roots\":[";
+    for (size_t i = 0; i != _numRoots; ++i)
+    {
+        auto& root = _roots[i];
+        os << ((i == 0) ? "{\"name\":" : ",{\"name\":");
+        census_writeJSON(os, root.name);
+        snprintf(buf, sizeof(buf), ",\"objects\":%zu,\"bytes\":%zu}", root.count.objects,
+                 root.count.bytes);
+        os << buf;
+    }
+    os << "]}\n";
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
@@ -0,0 +1,151 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/THashMap.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class RunTimeClass;
+class Stream;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Memory census report formats.
+*/
+enum census_t
+{
+    census_text, /**< plain text (a table) */
+    census_json  /**< JSON */
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Per-class accounting of the memory held by objects.
+
+   A census starts from root objects (global tables, caches, registries, etc.) and counts every
+   object that the roots own, directly or indirectly.  For each class, it reports the number of
+   instances and the bytes they occupy, as measured by Object::allocatedSize().  An object that
+   owns other objects is charged only for the memory that isn't accounted for by those objects
+   (e.g. a Hashtable is charged for its bucket array, and its contained objects are counted
+   under their own classes).  Object::censusOwned() tells the census which objects an object
+   owns; objects that don't override it are counted as a whole.
+
+   Roots are registered with addRoot() (by whoever creates them), and take() walks all of them.
+   The cost of a census is roughly proportional to the number of objects it counts times the
+   depth of nesting (because each level of ownership has its allocated size computed).  No
+   memory is allocated per object, so it's cheap enough to run periodically (e.g. to track the
+   memory growth of a long-running server).
+
+   A root must not be modified by other threads while a census is being taken, unless it does
+   its own locking (as ObjectRegistry and ConcurrentHashtable do).
+
+   \author Adam McKee
+   \ingroup utility
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class MemoryCensus
+{
+public:
+    /** Constructor. */
+    MemoryCensus();
+
+    MemoryCensus(const MemoryCensus&) = delete;
+
+    MemoryCensus& operator=(const MemoryCensus&) = delete;
+
+    /** Destructor. */
+    ~MemoryCensus();
+
+    /**
+       Register a root object.  The object must be removed (see removeRoot()) before it's
+       destroyed.
+       \param root root object
+       \param name (optional) name of the root for the report (default is the class name)
+    */
+    static void addRoot(const Object* root, const char* name = nullptr);
+
+    /** Remove a root object. */
+    static void removeRoot(const Object* root);
+
+    /** Take a census of the registered roots (discarding the results of any earlier one). */
+    void take();
+
+    /**
+       Count an object, and the objects that it owns.
+       \return allocated size of the object (including the objects it owns)
+       \param object object to count
+    */
+    size_t add(const Object& object);
+
+    /** Discard the results. */
+    void clear();
+
+    /** Get the total number of objects counted. */
+    size_t
+    objects() const
+    {
+        return _objects;
+    }
+
+    /** Get the total size of the objects counted. */
+    size_t
+    bytes() const
+    {
+        return _bytes;
+    }
+
+    /** Get the number of instances of the given class that were counted. */
+    size_t objects(const RunTimeClass* rtc) const;
+
+    /** Get the total size of the instances of the given class that were counted. */
+    size_t bytes(const RunTimeClass* rtc) const;
+
+    /**
+       Write a report to a stream.  Classes are listed in order of decreasing size, followed by
+       the totals for each root.
+       \param os output stream
+       \param format (optional : census_text) report format (see utl::census_t)
+    */
+    void report(Stream& os, uint_t format = census_text) const;
+
+private:
+    struct count_t
+    {
+        size_t objects;
+        size_t bytes;
+    };
+
+    struct root_t
+    {
+        char* name;
+        count_t count;
+    };
+
+    typedef std::pair<const RunTimeClass*, count_t> class_t;
+
+private:
+    class_t* sortClasses() const;
+    void reportText(Stream& os) const;
+    void reportJSON(Stream& os) const;
+
+private:
+    THashMap<const RunTimeClass*, count_t> _classes;
+    root_t* _roots;
+    size_t _numRoots;
+    size_t _objects;
+    size_t _bytes;
+    size_t _ownedBytes;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
@@ -269,6 +269,13 @@ Object::innerAllocatedSize() const
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+Object::censusOwned(MemoryCensus&) const
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 #ifdef DEBUG
 void
 Object::addOwnedIt(const class FwdIt* it) const
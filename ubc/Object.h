@@ -6,6 +6,7 @@ UTL_NS_BEGIN;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+class MemoryCensus;
 class Stream;
 class String;
 
@@ -262,6 +263,13 @@ public:
     /** Get the "inner" allocated size. */
     virtual size_t innerAllocatedSize() const;
 
+    /**
+       Add the objects that self owns (whose sizes are included in innerAllocatedSize()) to a
+       memory census, by calling MemoryCensus::add() for each of them.  The default implementation
+       does nothing (so self is counted as a whole).
+    */
+    virtual void censusOwned(MemoryCensus& census) const;
+
     /// \name Comparison Operators
     //@{
     /** Less-than operator. */
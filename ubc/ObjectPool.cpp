@@ -0,0 +1,356 @@
+#include <libutl/libutl.h>
+#include <libutl/Stream.h>
+#include <thread>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#undef new
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// maximum number of pools (classes beyond this limit use the global heap)
+static const size_t maxPools = 256;
+
+// objects moved between a thread's list and the depot at a time
+static const size_t batchSize = 32;
+
+// a thread's list is drained when it holds more objects than this
+static const size_t maxListSize = 4 * batchSize;
+
+// allocations/de-allocations a thread makes before reporting them to the pool
+static const ssize_t statsBatchSize = 64;
+
+// chunks that objects are carved from
+static const size_t minChunkSize = 16 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct ObjectPool::list_t
+{
+    void* head;
+    uint32_t count;
+    int32_t live;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// all pools (indexed by ObjectPool::_idx)
+static std::atomic<ObjectPool*> objectPool_pools[maxPools];
+static std::atomic<size_t> objectPool_numPools(0);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+thread_local ObjectPool::list_t* ObjectPool::_threadLists = nullptr;
+thread_local bool ObjectPool::_threadExited = false;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// return a thread's lists to the pools when it exits
+class ObjectPoolReaper
+{
+public:
+    ~ObjectPoolReaper();
+
+    void
+    arm()
+    {
+    }
+};
+
+static thread_local ObjectPoolReaper objectPool_reaper;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ObjectPoolReaper::~ObjectPoolReaper()
+{
+    // after this, the thread allocates from (and frees to) the depots directly
+    ObjectPool::_threadExited = true;
+    auto lists = ObjectPool::_threadLists;
+    if (lists == nullptr)
+        return;
+    ObjectPool::_threadLists = nullptr;
+    size_t numPools = min(objectPool_numPools.load(std::memory_order_acquire), maxPools);
+    for (size_t i = 0; i != numPools; ++i)
+    {
+        auto pool = objectPool_pools[i].load(std::memory_order_acquire);
+        if (pool != nullptr)
+            pool->threadExit(lists[i]);
+    }
+    ::free(lists);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ObjectPool::ObjectPool(const RunTimeClass* rtc, size_t size)
+    : _rtc(rtc)
+    , _size(max(size, sizeof(void*)))
+    , _live(0)
+    , _peak(0)
+    , _allocatedSize(0)
+    , _lock(false)
+    , _depot(nullptr)
+    , _depotCount(0)
+    , _chunkPtr(nullptr)
+    , _chunkLim(nullptr)
+{
+    _idx = objectPool_numPools.fetch_add(1, std::memory_order_acq_rel);
+    if (_idx < maxPools)
+        objectPool_pools[_idx].store(this, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const ObjectPool*
+ObjectPool::find(const RunTimeClass* rtc)
+{
+    size_t numPools = min(objectPool_numPools.load(std::memory_order_acquire), maxPools);
+    for (size_t i = 0; i != numPools; ++i)
+    {
+        auto pool = objectPool_pools[i].load(std::memory_order_acquire);
+        if ((pool != nullptr) && (pool->_rtc == rtc))
+            return pool;
+    }
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ObjectPool::report(Stream& os)
+{
+    size_t numPools = min(objectPool_numPools.load(std::memory_order_acquire), maxPools);
+    for (size_t i = 0; i != numPools; ++i)
+    {
+        auto pool = objectPool_pools[i].load(std::memory_order_acquire);
+        if (pool == nullptr)
+            continue;
+
+        // include the calling thread's unreported counts
+        if (_threadLists != nullptr)
+            pool->flushStats(_threadLists[i]);
+
+        char buf[256];
+        snprintf(buf, sizeof(buf), "%-32s size: %4zu  live: %10zu  peak: %10zu  memory: %zu\n",
+                 pool->_rtc->name(), pool->_size, pool->liveCount(), pool->peakCount(),
+                 pool->innerAllocatedSize());
+        os << buf;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void*
+ObjectPool::alloc(size_t size)
+{
+    // not pooled -> use the global heap
+    if ((size != _size) || (_idx >= maxPools))
+        return ::operator new(size);
+
+    // allocate from the thread's list
+    list_t* list = threadList();
+    if (list == nullptr)
+    {
+        lock();
+        void* ptr = _depot;
+        if (ptr == nullptr)
+        {
+            ptr = carve();
+        }
+        else
+        {
+            _depot = *reinterpret_cast<void**>(ptr);
+            --_depotCount;
+        }
+        unlock();
+        addLive(1);
+        return ptr;
+    }
+    if (list->head == nullptr)
+        refill(*list);
+    void* ptr = list->head;
+    list->head = *reinterpret_cast<void**>(ptr);
+    --list->count;
+    if (++list->live >= statsBatchSize)
+        flushStats(*list);
+    return ptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ObjectPool::free(void* ptr, size_t size)
+{
+    // not pooled -> return it to the global heap
+    if ((size != _size) || (_idx >= maxPools))
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    // free to the thread's list
+    list_t* list = threadList();
+    if (list == nullptr)
+    {
+        lock();
+        *reinterpret_cast<void**>(ptr) = _depot;
+        _depot = ptr;
+        ++_depotCount;
+        unlock();
+        addLive(-1);
+        return;
+    }
+    *reinterpret_cast<void**>(ptr) = list->head;
+    list->head = ptr;
+    ++list->count;
+    if (--list->live <= -statsBatchSize)
+        flushStats(*list);
+    if (list->count > maxListSize)
+        drain(*list, list->count - (maxListSize / 2));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ObjectPool::list_t*
+ObjectPool::threadList()
+{
+    auto lists = _threadLists;
+    if (lists != nullptr)
+        return lists + _idx;
+    if (_threadExited)
+        return nullptr;
+
+    // first use in this thread: make its lists, and make sure the reaper will run
+    lists = static_cast<list_t*>(calloc(maxPools, sizeof(list_t)));
+    if (lists == nullptr)
+        throw std::bad_alloc();
+    _threadLists = lists;
+    objectPool_reaper.arm();
+    return lists + _idx;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ObjectPool::threadExit(list_t& list)
+{
+    flushStats(list);
+    if (list.count != 0)
+        drain(list, list.count);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ObjectPool::refill(list_t& list)
+{
+    ASSERTD(list.head == nullptr);
+    lock();
+    void* head = nullptr;
+    size_t count = 0;
+    for (; (count != batchSize) && (_depot != nullptr); ++count)
+    {
+        void* ptr = _depot;
+        _depot = *reinterpret_cast<void**>(ptr);
+        *reinterpret_cast<void**>(ptr) = head;
+        head = ptr;
+    }
+    _depotCount -= count;
+    for (; count != batchSize; ++count)
+    {
+        void* ptr = carve();
+        *reinterpret_cast<void**>(ptr) = head;
+        head = ptr;
+    }
+    unlock();
+    list.head = head;
+    list.count = count;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ObjectPool::drain(list_t& list, size_t count)
+{
+    ASSERTD(count <= list.count);
+
+    // detach [head, tail] from the list
+    void* head = list.head;
+    void* tail = head;
+    for (size_t i = 1; i != count; ++i)
+    {
+        tail = *reinterpret_cast<void**>(tail);
+    }
+    list.head = *reinterpret_cast<void**>(tail);
+    list.count -= count;
+
+    // push it onto the depot
+    lock();
+    *reinterpret_cast<void**>(tail) = _depot;
+    _depot = head;
+    _depotCount += count;
+    unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ObjectPool::flushStats(list_t& list)
+{
+    if (list.live == 0)
+        return;
+    addLive(list.live);
+    list.live = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ObjectPool::addLive(ssize_t delta)
+{
+    ssize_t live = _live.fetch_add(delta, std::memory_order_relaxed) + delta;
+    if (live <= 0)
+        return;
+    size_t peak = _peak.load(std::memory_order_relaxed);
+    while (((size_t)live > peak) &&
+           !_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    {
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void*
+ObjectPool::carve()
+{
+    // (called with _lock held)
+    if (_chunkPtr == _chunkLim)
+    {
+        size_t chunkSize = max(minChunkSize, batchSize * _size);
+        size_t numObjects = chunkSize / _size;
+        _chunkPtr = static_cast<byte_t*>(::operator new(numObjects * _size));
+        _chunkLim = _chunkPtr + (numObjects * _size);
+        _allocatedSize.fetch_add(numObjects * _size, std::memory_order_relaxed);
+    }
+    void* ptr = _chunkPtr;
+    _chunkPtr += _size;
+    return ptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ObjectPool::lock()
+{
+    while (_lock.exchange(true, std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
@@ -0,0 +1,178 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class RunTimeClass;
+class Stream;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Pooled allocation for instances of a class.
+
+   A class that's declared with UTL_CLASS_POOLED gets class-specific operator new/delete that
+   allocate its instances from an ObjectPool of its own (keyed by its RunTimeClass).  Each thread
+   keeps a free list of instances for each pool, so allocation and de-allocation are usually just
+   a pop or push on a list that no other thread touches.  When a thread's list runs dry, it takes
+   a batch of instances from the pool's shared depot (or carves new ones out of a large chunk);
+   when the list grows too long, a batch goes back to the depot.  A thread's lists are returned
+   to the depot when it exits.  Memory held by a pool is never returned to the global allocator.
+
+   Only instances of exactly the pooled class's size come from the pool: a derived class that
+   adds data members (and doesn't declare UTL_CLASS_POOLED itself) is allocated from the global
+   heap as usual.
+
+   Each pool counts its live instances and remembers the peak count.  For the sake of speed,
+   threads report allocations and de-allocations to the pool in batches, so the counts lag
+   slightly behind reality.
+
+   Pooling is disabled in a DEBUG build (so that gblnew's leak tracking sees every object).
+
+   \author Adam McKee
+   \ingroup utility
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ObjectPool
+{
+public:
+    /**
+       Constructor.
+       \param rtc RunTimeClass of the pooled class
+       \param size size of instances (in bytes)
+    */
+    ObjectPool(const RunTimeClass* rtc, size_t size);
+
+    /** Get the pool for the given class. */
+    template <typename T>
+    static ObjectPool*
+    get()
+    {
+        static ObjectPool pool(T::getThisClass(), sizeof(T));
+        return &pool;
+    }
+
+    /** Find the pool for the given class (nullptr if there's none). */
+    static const ObjectPool* find(const RunTimeClass* rtc);
+
+    /** Write a line with the statistics for each pool to the given stream. */
+    static void report(Stream& os);
+
+    /** Allocate an instance. */
+    void* alloc(size_t size);
+
+    /** Free an instance that was allocated by alloc(). */
+    void free(void* ptr, size_t size);
+
+    /** Get the RunTimeClass of the pooled class. */
+    const RunTimeClass*
+    runTimeClass() const
+    {
+        return _rtc;
+    }
+
+    /** Get the size of an instance. */
+    size_t
+    objectSize() const
+    {
+        return _size;
+    }
+
+    /** Get the number of live instances. */
+    size_t
+    liveCount() const
+    {
+        auto live = _live.load(std::memory_order_relaxed);
+        return (live < 0) ? 0 : live;
+    }
+
+    /** Get the peak number of live instances. */
+    size_t
+    peakCount() const
+    {
+        return _peak.load(std::memory_order_relaxed);
+    }
+
+    /** Get the total size of the chunks that instances are carved out of. */
+    size_t
+    innerAllocatedSize() const
+    {
+        return _allocatedSize.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct list_t;
+    friend class ObjectPoolReaper;
+
+private:
+    list_t* threadList();
+    void threadExit(list_t& list);
+    void refill(list_t& list);
+    void drain(list_t& list, size_t count);
+    void flushStats(list_t& list);
+    void addLive(ssize_t delta);
+    void* carve();
+    void lock();
+    void
+    unlock()
+    {
+        _lock.store(false, std::memory_order_release);
+    }
+
+private:
+    const RunTimeClass* _rtc;
+    size_t _size;
+    size_t _idx;
+    std::atomic<ssize_t> _live;
+    std::atomic<size_t> _peak;
+    std::atomic<size_t> _allocatedSize;
+
+    // shared depot (protected by _lock)
+    std::atomic<bool> _lock;
+    void* _depot;
+    size_t _depotCount;
+    byte_t* _chunkPtr;
+    byte_t* _chunkLim;
+
+    // the calling thread's lists (one for each pool)
+    static thread_local list_t* _threadLists;
+    static thread_local bool _threadExited;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Allocate instances of a class from its own ObjectPool (by giving it class-specific
+   operator new/delete).
+   \ingroup macros
+*/
+#if UTL_GBLNEW_MODE == UTL_GBLNEW_MODE_DEBUG || UTL_GBLNEW_MODE == UTL_GBLNEW_MODE_DEBUG_MSVC
+#define UTL_CLASS_POOLED
+#else
+#define UTL_CLASS_POOLED                                                                           \
+public:                                                                                            \
+    static void* operator new(size_t size)                                                         \
+    {                                                                                              \
+        return utl::ObjectPool::get<thisType>()->alloc(size);                                      \
+    }                                                                                              \
+    static void* operator new(size_t, void* ptr)                                                   \
+    {                                                                                              \
+        return ptr;                                                                                \
+    }                                                                                              \
+    static void operator delete(void* ptr, size_t size)                                            \
+    {                                                                                              \
+        utl::ObjectPool::get<thisType>()->free(ptr, size);                                         \
+    }                                                                                              \
+    static void operator delete(void*, void*)                                                      \
+    {                                                                                              \
+    }
+#endif
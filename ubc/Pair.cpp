@@ -1,4 +1,5 @@
 #include <libutl/libutl.h>
+#include <libutl/MemoryCensus.h>
 #include <libutl/Pair.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -150,6 +151,17 @@ Pair::innerAllocatedSize() const
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+Pair::censusOwned(MemoryCensus& census) const
+{
+    if (isFirstOwner() && (_first != nullptr))
+        census.add(*_first);
+    if (isSecondOwner() && (_second != nullptr))
+        census.add(*_second);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void
 Pair::setFirst(const Object* first)
 {
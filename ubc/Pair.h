@@ -27,6 +27,7 @@ class Pair
     , protected FlagsMI
 {
     UTL_CLASS_DECL(Pair, Object);
+    UTL_CLASS_POOLED;
 
 public:
     /**
@@ -78,6 +79,8 @@ public:
 
     virtual size_t innerAllocatedSize() const;
 
+    virtual void censusOwned(MemoryCensus& census) const;
+
     /** Return the first object. */
     Object*
     first() const
@@ -357,3 +357,1051 @@ operator delete(void* ptr, const char*, uint_t) noexcept
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #endif // UTL_GBLNEW_MODE == UTL_GBLNEW_MODE_DEBUG
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if UTL_GBLNEW_PROFILE
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#undef new
+#include <cmath>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <mutex>
+#include <semaphore.h>
+#include <string>
+#include <sys/mman.h>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// PROFILE definitions ///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Each thread counts down the bytes until its next sample.  The distances between samples are
+// drawn from an exponential distribution (with a mean of the sampling interval), so allocation
+// sizes can't fall into step with the sampling.  A sample records the allocating call stack in a
+// fixed-size hash table (allocated with mmap(), so recording a sample never calls new).
+
+static const uint_t prof_maxFrames = 32;
+static const size_t prof_tableSize = 16384;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct ProfSample
+{
+    uint64_t hash;
+    uint_t numFrames;
+    void* frames[prof_maxFrames];
+    size_t count; // # of sampled allocations
+    size_t bytes; // total size of sampled allocations
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static std::atomic<size_t> prof_interval(0);
+static size_t prof_samplingInterval = 0;
+static thread_local ptrdiff_t prof_bytesUntilSample = 0;
+static thread_local bool prof_threadStarted = false;
+static thread_local uint64_t prof_rngState = 0;
+static thread_local bool prof_busy = false;
+
+// protects the table
+static std::mutex prof_mutex;
+static ProfSample* prof_table = nullptr;
+static size_t prof_numSamples = 0;
+static size_t prof_numDropped = 0;
+
+// for reports triggered by a signal (prof_signalMutex protects the path and format)
+static sem_t prof_signalSem;
+static std::mutex prof_signalMutex;
+static std::string prof_signalPath;
+static uint_t prof_signalFormat = memprofile_pprof;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// bytes until the next sample
+static ptrdiff_t
+prof_nextSample(size_t interval)
+{
+    // xorshift64* seeded from the thread's stack address
+    uint64_t x = prof_rngState;
+    if (x == 0)
+        x = reinterpret_cast<uintptr_t>(&x) | 1;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    prof_rngState = x;
+    double u = (double)((x * 0x2545f4914f6cdd1dULL) >> 11) / (double)((uint64_t)1 << 53);
+    return (ptrdiff_t)(-log(1.0 - u) * (double)interval) + 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void __attribute__((noinline))
+prof_record(size_t size)
+{
+    void* frames[prof_maxFrames + 2];
+    prof_busy = true;
+    int numFrames = backtrace(frames, prof_maxFrames + 2);
+    prof_busy = false;
+
+    // skip prof_record() and prof_sample()
+    int skip = min(numFrames, 2);
+    void** stack = frames + skip;
+    numFrames -= skip;
+
+    uint64_t hash = 14695981039346656037ULL;
+    for (int i = 0; i != numFrames; ++i)
+    {
+        hash = (hash ^ reinterpret_cast<uintptr_t>(stack[i])) * 1099511628211ULL;
+    }
+
+    std::lock_guard<std::mutex> lock(prof_mutex);
+    if (prof_table == nullptr)
+        return;
+    for (size_t i = 0; i != prof_tableSize; ++i)
+    {
+        ProfSample& sample = prof_table[(hash + i) & (prof_tableSize - 1)];
+        if (sample.count == 0)
+        {
+            // new call stack (but leave some room in the table)
+            if (prof_numSamples >= ((prof_tableSize * 3) / 4))
+                break;
+            sample.hash = hash;
+            sample.numFrames = numFrames;
+            memcpy(sample.frames, stack, numFrames * sizeof(void*));
+            ++prof_numSamples;
+        }
+        else if ((sample.hash != hash) || (sample.numFrames != (uint_t)numFrames) ||
+                 (memcmp(sample.frames, stack, numFrames * sizeof(void*)) != 0))
+        {
+            continue;
+        }
+        ++sample.count;
+        sample.bytes += size;
+        return;
+    }
+    ++prof_numDropped;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void __attribute__((noinline))
+prof_sample(size_t size)
+{
+    size_t interval = prof_interval.load(std::memory_order_relaxed);
+    if ((interval == 0) || prof_busy)
+        return;
+
+    // (the thread's first allocation only starts the countdown)
+    bool sample = prof_threadStarted;
+    prof_threadStarted = true;
+    prof_bytesUntilSample = prof_nextSample(interval);
+    if (sample)
+        prof_record(size);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// called for every allocation
+static inline void
+prof_onAlloc(size_t size)
+{
+    if ((prof_interval.load(std::memory_order_relaxed) != 0) &&
+        ((prof_bytesUntilSample -= size) <= 0))
+    {
+        prof_sample(size);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// name of the function containing the given address
+static std::string
+prof_symbolize(void* addr)
+{
+    std::string str;
+    Dl_info info;
+    if ((dladdr(addr, &info) != 0) && (info.dli_sname != nullptr))
+    {
+        int status;
+        char* name = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        str = (status == 0) ? name : info.dli_sname;
+        free(name);
+    }
+    else
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "0x%zx", reinterpret_cast<size_t>(addr));
+        str = buf;
+    }
+    return str;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void
+prof_report(std::string& str, uint_t format)
+{
+    // copy the samples
+    std::vector<ProfSample> samples;
+    size_t interval;
+    {
+        std::lock_guard<std::mutex> lock(prof_mutex);
+        interval = prof_samplingInterval;
+        if (prof_table != nullptr)
+        {
+            samples.reserve(prof_numSamples);
+            for (size_t i = 0; i != prof_tableSize; ++i)
+            {
+                if (prof_table[i].count != 0)
+                    samples.push_back(prof_table[i]);
+            }
+        }
+    }
+
+    char buf[128];
+    if (format == memprofile_collapsed)
+    {
+        // root;...;caller <estimated bytes>
+        for (auto& sample : samples)
+        {
+            // (a sample of average size s represents 1 / (1 - exp(-s / interval)) allocations)
+            double avgSize = (double)sample.bytes / (double)sample.count;
+            double scale = 1.0 / (1.0 - exp(-avgSize / (double)max(interval, (size_t)1)));
+            std::vector<std::string> names;
+            for (uint_t i = 0; i != sample.numFrames; ++i)
+            {
+                names.push_back(prof_symbolize(sample.frames[i]));
+            }
+
+            // leave out operator new (and new[])
+            size_t leaf = 0;
+            while (((leaf + 1) < names.size()) && (names[leaf].compare(0, 12, "operator new") == 0))
+                ++leaf;
+
+            for (size_t i = names.size(); i-- != leaf;)
+            {
+                str += names[i];
+                if (i != leaf)
+                    str += ';';
+            }
+            snprintf(buf, sizeof(buf), " %zu\n", (size_t)((double)sample.bytes * scale));
+            str += buf;
+        }
+        return;
+    }
+
+    // pprof (legacy heap profile format, allocation counts)
+    size_t totalCount = 0, totalBytes = 0;
+    for (auto& sample : samples)
+    {
+        totalCount += sample.count;
+        totalBytes += sample.bytes;
+    }
+    snprintf(buf, sizeof(buf), "heap profile: 0: 0 [%zu: %zu] @ heap_v2/%zu\n", totalCount,
+             totalBytes, interval);
+    str += buf;
+    for (auto& sample : samples)
+    {
+        snprintf(buf, sizeof(buf), "0: 0 [%zu: %zu] @", sample.count, sample.bytes);
+        str += buf;
+        for (uint_t i = 0; i != sample.numFrames; ++i)
+        {
+            snprintf(buf, sizeof(buf), " 0x%zx", reinterpret_cast<size_t>(sample.frames[i]));
+            str += buf;
+        }
+        str += '\n';
+    }
+
+    // pprof needs the address space layout to find the symbols
+    str += "\nMAPPED_LIBRARIES:\n";
+    int fd = open("/proc/self/maps", O_RDONLY);
+    if (fd >= 0)
+    {
+        char mapsBuf[4096];
+        ssize_t n;
+        while ((n = read(fd, mapsBuf, sizeof(mapsBuf))) > 0)
+            str.append(mapsBuf, n);
+        close(fd);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static bool
+prof_write(const char* path, uint_t format)
+{
+    std::string str;
+    prof_report(str, format);
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return false;
+    const char* ptr = str.data();
+    size_t rem = str.size();
+    while (rem != 0)
+    {
+        ssize_t n = write(fd, ptr, rem);
+        if (n <= 0)
+            break;
+        ptr += n;
+        rem -= n;
+    }
+    close(fd);
+    return (rem == 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void
+prof_signalHandler(int)
+{
+    sem_post(&prof_signalSem);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// write a report for each signal received
+static void*
+prof_signalThread(void*)
+{
+    prof_busy = true;
+    for (;;)
+    {
+        if (sem_wait(&prof_signalSem) != 0)
+            continue;
+        std::string path;
+        uint_t format;
+        {
+            std::lock_guard<std::mutex> lock(prof_signalMutex);
+            path = prof_signalPath;
+            format = prof_signalFormat;
+        }
+        prof_write(path.c_str(), format);
+    }
+    return nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+memProfileStart(size_t samplingInterval)
+{
+    std::lock_guard<std::mutex> lock(prof_mutex);
+    if (prof_table == nullptr)
+    {
+        void* ptr = mmap(nullptr, prof_tableSize * sizeof(ProfSample), PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED)
+            return;
+        prof_table = static_cast<ProfSample*>(ptr);
+    }
+    prof_samplingInterval = max(samplingInterval, (size_t)1);
+    prof_interval.store(prof_samplingInterval, std::memory_order_relaxed);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+memProfileStop()
+{
+    prof_interval.store(0, std::memory_order_relaxed);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+memProfileReset()
+{
+    std::lock_guard<std::mutex> lock(prof_mutex);
+    if (prof_table != nullptr)
+        memset(prof_table, 0, prof_tableSize * sizeof(ProfSample));
+    prof_numSamples = 0;
+    prof_numDropped = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+memProfileReport(Stream& os, uint_t format)
+{
+    bool busy = prof_busy;
+    prof_busy = true;
+    std::string str;
+    prof_report(str, format);
+    prof_busy = busy;
+    os.write(reinterpret_cast<const byte_t*>(str.data()), str.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool
+memProfileWrite(const char* path, uint_t format)
+{
+    bool busy = prof_busy;
+    prof_busy = true;
+    bool res = prof_write(path, format);
+    prof_busy = busy;
+    return res;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool
+memProfileWriteOnSignal(int sig, const char* path, uint_t format)
+{
+    static std::once_flag once;
+    bool ok = true;
+    std::call_once(once, [&ok] {
+        pthread_t thread;
+        ok = (sem_init(&prof_signalSem, 0, 0) == 0) &&
+             (pthread_create(&thread, nullptr, prof_signalThread, nullptr) == 0);
+        if (ok)
+            pthread_detach(thread);
+    });
+    if (!ok)
+        return false;
+    {
+        std::lock_guard<std::mutex> lock(prof_signalMutex);
+        prof_signalPath = path;
+        prof_signalFormat = format;
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = prof_signalHandler;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    return (sigaction(sig, &sa, nullptr) == 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if UTL_GBLNEW_MODE == UTL_GBLNEW_MODE_RELEASE
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void*
+operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+operator delete[](void* ptr) noexcept
+{
+    operator delete(ptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void*
+operator new(size_t size)
+{
+    prof_onAlloc(size);
+    void* ptr = malloc((size == 0) ? 1 : size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // UTL_GBLNEW_MODE == UTL_GBLNEW_MODE_RELEASE
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // UTL_GBLNEW_PROFILE
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if UTL_GBLNEW_MODE == UTL_GBLNEW_MODE_FAST
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#undef new
+#include <mutex>
+#include <pthread.h>
+#include <sys/mman.h>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_USE;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// FAST definitions //////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Small blocks (up to fast_maxSmallSize bytes) are allocated from 64 KB slabs, where each slab
+// holds blocks of a single size class.  All slabs are carved out of one large region of reserved
+// address space, so freeing a block only requires a range check to tell whether it came from a
+// slab (or from malloc()).  The slab headers are kept in a separate array (indexed by the slab's
+// position in the region) rather than at the start of each slab, because headers at 64 KB
+// intervals would all compete for the same few cache sets.
+//
+// Each thread has its own heap with a list of slabs for each size class, so allocating and
+// freeing blocks in the same thread doesn't require any synchronization.  A block that's freed
+// by a different thread is pushed onto its slab's (lock-free) remote free list, which the owning
+// thread collects when the slab runs out of blocks.  When a thread exits, its empty slabs are
+// released, and its heap (with the remaining slabs) is kept for re-use by a new thread.
+//
+// Empty slabs go to a global pool.  The pool keeps a few slabs ready for re-use, and returns
+// the memory of the rest to the OS (via madvise(MADV_DONTNEED)).
+
+static const size_t fast_slabSize = 64 * 1024;
+static const size_t fast_maxSmallSize = 4096;
+static const uint_t fast_numClasses = 32;
+static const size_t fast_maxHotSlabs = 32;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct FastHeap;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct alignas(64) FastSlab
+{
+    FastHeap* heap;                    // owning heap
+    FastSlab* prev;                    // previous slab in the heap's list for the size class
+    FastSlab* next;                    // next slab in the heap's list (or in the pool)
+    byte_t* mem;                       // the slab's memory
+    FastSlab* nextReactivated;         // next slab in the heap's reactivated list
+    void* freeList;                    // blocks freed by the owning thread
+    std::atomic<void*> remoteFreeList; // blocks freed by other threads
+    std::atomic<bool> full;            // removed from the heap's list because it ran out?
+    uint_t sizeClass;
+    size_t blockSize;
+    size_t used;                       // # of allocated blocks (incl. those on remoteFreeList)
+    byte_t* bumpPtr;                   // never-allocated blocks are in [bumpPtr, bumpLim)
+    byte_t* bumpLim;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct FastHeap
+{
+    FastSlab* slabs[fast_numClasses];       // slabs with blocks to allocate (current slab first)
+    std::atomic<FastSlab*> reactivated;     // full slabs that have had blocks freed remotely
+    FastHeap* next;                         // next heap in the list of abandoned heaps
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void fast_init();
+static void fast_threadExit(void* heap);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// (all of these are statically initialized, because global new may be called before dynamic
+//  initialization of this module)
+static pthread_once_t fast_once = PTHREAD_ONCE_INIT;
+static pthread_key_t fast_heapKey;
+static thread_local FastHeap* fast_heap = nullptr;
+static byte_t* fast_regionBegin = nullptr;
+static byte_t* fast_regionEnd = nullptr;
+static FastSlab* fast_slabs = nullptr;
+
+// protects the region, the slab pool, and the list of abandoned heaps
+static std::mutex fast_mutex;
+static byte_t* fast_regionPtr = nullptr;
+static FastSlab* fast_hotSlabs = nullptr;
+static FastSlab* fast_coldSlabs = nullptr;
+static size_t fast_numHotSlabs = 0;
+static FastHeap* fast_abandonedHeaps = nullptr;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// size classes: 16 bytes apart up to 256, then 4 per power of 2 up to fast_maxSmallSize
+static inline uint_t
+fast_sizeClass(size_t size)
+{
+    if (size <= 256)
+        return (size == 0) ? 0 : ((size + 15) / 16) - 1;
+    size_t s = size - 1;
+    uint_t bit = 63 - __builtin_clzll(s);
+    return 16 + ((bit - 8) * 4) + ((s >> (bit - 2)) & 3);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline size_t
+fast_classSize(uint_t sizeClass)
+{
+    if (sizeClass < 16)
+        return (sizeClass + 1) * 16;
+    size_t base = (size_t)1 << (((sizeClass - 16) / 4) + 8);
+    return base + ((((sizeClass - 16) % 4) + 1) * (base / 4));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline FastSlab*
+fast_slab(void* ptr)
+{
+    return fast_slabs + ((static_cast<byte_t*>(ptr) - fast_regionBegin) / fast_slabSize);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// reserve the region, create the key for thread exit
+static void
+fast_init()
+{
+    pthread_key_create(&fast_heapKey, fast_threadExit);
+
+    // reserve as much address space as we can get (up to 64 GB)
+    for (size_t size = (size_t)64 << 30; size >= ((size_t)256 << 20); size /= 2)
+    {
+        void* ptr = mmap(nullptr, size + fast_slabSize, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (ptr == MAP_FAILED)
+            continue;
+        size_t headersSize = (size / fast_slabSize) * sizeof(FastSlab);
+        void* headers = mmap(nullptr, headersSize, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (headers == MAP_FAILED)
+        {
+            munmap(ptr, size + fast_slabSize);
+            continue;
+        }
+        fast_slabs = static_cast<FastSlab*>(headers);
+        fast_regionBegin = reinterpret_cast<byte_t*>(
+            nextMultipleOfPow2(fast_slabSize, reinterpret_cast<uintptr_t>(ptr)));
+        fast_regionEnd = fast_regionBegin + size;
+        fast_regionPtr = fast_regionBegin;
+        break;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// get the calling thread's heap (re-using an abandoned heap if possible)
+static FastHeap*
+fast_getHeap()
+{
+    pthread_once(&fast_once, fast_init);
+    if (fast_regionBegin == nullptr)
+        return nullptr;
+
+    fast_mutex.lock();
+    FastHeap* heap = fast_abandonedHeaps;
+    if (heap != nullptr)
+        fast_abandonedHeaps = heap->next;
+    fast_mutex.unlock();
+
+    if (heap == nullptr)
+    {
+        void* ptr = calloc(1, sizeof(FastHeap));
+        if (ptr == nullptr)
+            return nullptr;
+        heap = new (ptr) FastHeap();
+    }
+    heap->next = nullptr;
+    pthread_setspecific(fast_heapKey, heap);
+    fast_heap = heap;
+    return heap;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// get an empty slab from the pool (or the region)
+static FastSlab*
+fast_newSlab(FastHeap* heap, uint_t sizeClass)
+{
+    fast_mutex.lock();
+    FastSlab* slab;
+    if (fast_hotSlabs != nullptr)
+    {
+        slab = fast_hotSlabs;
+        fast_hotSlabs = slab->next;
+        --fast_numHotSlabs;
+    }
+    else if (fast_coldSlabs != nullptr)
+    {
+        slab = fast_coldSlabs;
+        fast_coldSlabs = slab->next;
+    }
+    else if (fast_regionPtr != fast_regionEnd)
+    {
+        slab = fast_slab(fast_regionPtr);
+        slab->mem = fast_regionPtr;
+        fast_regionPtr += fast_slabSize;
+    }
+    else
+    {
+        slab = nullptr;
+    }
+    fast_mutex.unlock();
+    if (slab == nullptr)
+        return nullptr;
+
+    size_t blockSize = fast_classSize(sizeClass);
+    size_t numBlocks = fast_slabSize / blockSize;
+    slab->heap = heap;
+    slab->prev = slab->next = slab->nextReactivated = nullptr;
+    slab->freeList = nullptr;
+    slab->remoteFreeList.store(nullptr, std::memory_order_relaxed);
+    slab->full.store(false, std::memory_order_relaxed);
+    slab->sizeClass = sizeClass;
+    slab->blockSize = blockSize;
+    slab->used = 0;
+    slab->bumpPtr = slab->mem;
+    slab->bumpLim = slab->bumpPtr + (numBlocks * blockSize);
+    return slab;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// return an empty slab to the pool
+static void
+fast_releaseSlab(FastSlab* slab)
+{
+    bool hot;
+    fast_mutex.lock();
+    hot = (fast_numHotSlabs < fast_maxHotSlabs);
+    if (hot)
+    {
+        slab->next = fast_hotSlabs;
+        fast_hotSlabs = slab;
+        ++fast_numHotSlabs;
+    }
+    fast_mutex.unlock();
+    if (hot)
+        return;
+
+    madvise(slab->mem, fast_slabSize, MADV_DONTNEED);
+    fast_mutex.lock();
+    slab->next = fast_coldSlabs;
+    fast_coldSlabs = slab;
+    fast_mutex.unlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline void
+fast_link(FastHeap* heap, FastSlab* slab)
+{
+    FastSlab*& head = heap->slabs[slab->sizeClass];
+    slab->prev = nullptr;
+    slab->next = head;
+    if (head != nullptr)
+        head->prev = slab;
+    head = slab;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline void
+fast_unlink(FastHeap* heap, FastSlab* slab)
+{
+    if (slab->prev == nullptr)
+        heap->slabs[slab->sizeClass] = slab->next;
+    else
+        slab->prev->next = slab->next;
+    if (slab->next != nullptr)
+        slab->next->prev = slab->prev;
+    slab->prev = slab->next = nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// move blocks from the slab's remote free list to its local free list
+static bool
+fast_collect(FastSlab* slab)
+{
+    void* list = slab->remoteFreeList.exchange(nullptr, std::memory_order_acquire);
+    if (list == nullptr)
+        return false;
+    void* tail = list;
+    size_t count = 1;
+    for (void* next; (next = *static_cast<void**>(tail)) != nullptr; tail = next)
+        ++count;
+    *static_cast<void**>(tail) = slab->freeList;
+    slab->freeList = list;
+    slab->used -= count;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// put full slabs that have had blocks freed remotely back into their lists
+static void
+fast_drainReactivated(FastHeap* heap)
+{
+    FastSlab* slab = heap->reactivated.exchange(nullptr, std::memory_order_acquire);
+    while (slab != nullptr)
+    {
+        FastSlab* next = slab->nextReactivated;
+        fast_link(heap, slab);
+        slab = next;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void*
+fast_allocSlow(FastHeap* heap, uint_t sizeClass)
+{
+    for (;;)
+    {
+        FastSlab* slab = heap->slabs[sizeClass];
+
+        // no slabs for this size class -> check reactivated slabs, or get a new slab
+        if (slab == nullptr)
+        {
+            fast_drainReactivated(heap);
+            if (heap->slabs[sizeClass] != nullptr)
+                continue;
+            slab = fast_newSlab(heap, sizeClass);
+            if (slab == nullptr)
+                return nullptr;
+            fast_link(heap, slab);
+        }
+
+        // allocate from the slab's free list, its never-allocated blocks, or its remote free list
+        if ((slab->freeList != nullptr) || fast_collect(slab))
+        {
+            void* ptr = slab->freeList;
+            slab->freeList = *static_cast<void**>(ptr);
+            ++slab->used;
+            return ptr;
+        }
+        if (slab->bumpPtr != slab->bumpLim)
+        {
+            void* ptr = slab->bumpPtr;
+            slab->bumpPtr += slab->blockSize;
+            ++slab->used;
+            return ptr;
+        }
+
+        // the slab is full -> remove it from the list
+        // (it goes back in when a block is freed -- check for a remote free that raced with this)
+        fast_unlink(heap, slab);
+        slab->full.store(true);
+        if ((slab->remoteFreeList.load() != nullptr) && slab->full.exchange(false))
+            fast_link(heap, slab);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline void*
+fast_alloc(size_t size)
+{
+    if (size > fast_maxSmallSize)
+        return nullptr;
+    FastHeap* heap = fast_heap;
+    if (heap == nullptr)
+    {
+        heap = fast_getHeap();
+        if (heap == nullptr)
+            return nullptr;
+    }
+    uint_t sizeClass = fast_sizeClass(size);
+    FastSlab* slab = heap->slabs[sizeClass];
+    if (slab != nullptr)
+    {
+        void* ptr = slab->freeList;
+        if (ptr != nullptr)
+        {
+            slab->freeList = *static_cast<void**>(ptr);
+            ++slab->used;
+            return ptr;
+        }
+    }
+    return fast_allocSlow(heap, sizeClass);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline void
+fast_free(void* ptr)
+{
+    // not allocated from a slab?
+    if ((static_cast<byte_t*>(ptr) < fast_regionBegin) ||
+        (static_cast<byte_t*>(ptr) >= fast_regionEnd))
+    {
+        free(ptr);
+        return;
+    }
+
+    FastSlab* slab = fast_slab(ptr);
+    FastHeap* heap = fast_heap;
+
+    // freed by the owning thread?
+    if ((heap != nullptr) && (slab->heap == heap))
+    {
+        *static_cast<void**>(ptr) = slab->freeList;
+        slab->freeList = ptr;
+        if (slab->full.load(std::memory_order_relaxed) && slab->full.exchange(false))
+            fast_link(heap, slab);
+
+        // release the slab if it's empty (unless it's the current slab)
+        if ((--slab->used == 0) && (heap->slabs[slab->sizeClass] != slab))
+        {
+            fast_unlink(heap, slab);
+            fast_releaseSlab(slab);
+        }
+        return;
+    }
+
+    // freed by another thread
+    void* head = slab->remoteFreeList.load(std::memory_order_relaxed);
+    do
+    {
+        *static_cast<void**>(ptr) = head;
+    } while (!slab->remoteFreeList.compare_exchange_weak(head, ptr));
+
+    // let the owner know if it's not allocating from this slab
+    if (slab->full.load() && slab->full.exchange(false))
+    {
+        FastHeap* owner = slab->heap;
+        FastSlab* top = owner->reactivated.load(std::memory_order_relaxed);
+        do
+        {
+            slab->nextReactivated = top;
+        } while (!owner->reactivated.compare_exchange_weak(top, slab, std::memory_order_release,
+                                                           std::memory_order_relaxed));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// release the exiting thread's empty slabs, and keep its heap for re-use
+static void
+fast_threadExit(void* ptr)
+{
+    auto heap = static_cast<FastHeap*>(ptr);
+    fast_heap = nullptr;
+    fast_drainReactivated(heap);
+    for (uint_t sizeClass = 0; sizeClass != fast_numClasses; ++sizeClass)
+    {
+        FastSlab* slab = heap->slabs[sizeClass];
+        while (slab != nullptr)
+        {
+            FastSlab* next = slab->next;
+            fast_collect(slab);
+            if (slab->used == 0)
+            {
+                fast_unlink(heap, slab);
+                fast_releaseSlab(slab);
+            }
+            slab = next;
+        }
+    }
+
+    fast_mutex.lock();
+    heap->next = fast_abandonedHeaps;
+    fast_abandonedHeaps = heap;
+    fast_mutex.unlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void*
+operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+operator delete[](void* ptr) noexcept
+{
+    operator delete(ptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void*
+operator new(size_t size)
+{
+#if UTL_GBLNEW_PROFILE
+    prof_onAlloc(size);
+#endif
+    void* ptr = fast_alloc(size);
+    if (ptr != nullptr)
+        return ptr;
+
+    // large block (or no slab available)
+    ptr = malloc((size == 0) ? 1 : size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+operator delete(void* ptr) noexcept
+{
+    if (ptr != nullptr)
+        fast_free(ptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // UTL_GBLNEW_MODE == UTL_GBLNEW_MODE_FAST
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void*
+memRealloc(void* ptr, size_t newSize)
+{
+    ASSERTD(newSize != 0);
+#if UTL_GBLNEW_MODE == UTL_GBLNEW_MODE_FAST
+    // slab blocks don't come from malloc()
+    if ((static_cast<byte_t*>(ptr) >= fast_regionBegin) &&
+        (static_cast<byte_t*>(ptr) < fast_regionEnd))
+    {
+        return nullptr;
+    }
+#if UTL_GBLNEW_PROFILE
+    prof_onAlloc(newSize);
+#endif
+    // (our new and new[] got the block from malloc())
+    return ::realloc(ptr, newSize);
+#elif (UTL_GBLNEW_MODE == UTL_GBLNEW_MODE_RELEASE) && UTL_GBLNEW_PROFILE
+    prof_onAlloc(newSize);
+
+    // (our new and new[] got the block from malloc())
+    return ::realloc(ptr, newSize);
+#else
+    // new and new[] are the C++ runtime's (or they're the debug versions), so we don't know that
+    // the block came from malloc()
+    return nullptr;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
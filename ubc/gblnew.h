@@ -11,6 +11,18 @@
    common memory allocation mistakes for you (such as memory leaks).  To have memory leaks
    reported, simply call memReportLeaks() just before your program exits.
 
+   In \c UTL_GBLNEW_MODE_FAST mode (see the \c LIBUTL_GBLNEW_FAST CMake option), new and delete
+   use a slab allocator with per-thread caches instead of the system allocator.  Blocks of up to
+   4 KB are allocated from slabs that each hold blocks of a single size class.  Each thread
+   allocates from its own slabs without locking, and blocks freed by other threads are handed
+   back to the owning thread through a lock-free list.  Empty slabs are returned to the OS.
+   Larger blocks are allocated with malloc().
+
+   If \c UTL_GBLNEW_PROFILE is non-zero (see the \c LIBUTL_GBLNEW_PROFILE CMake option), new can
+   also sample allocations (see memProfileStart()) to find the call sites that allocate the most
+   memory.  Sampling is cheap enough to leave on in long-running servers.  Profiling is available
+   with \c UTL_GBLNEW_MODE_RELEASE and \c UTL_GBLNEW_MODE_FAST.
+
    \author Adam McKee
 */
 
@@ -24,6 +36,22 @@ class Thread;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/**
+   Re-size a block with the system allocator's realloc(), which can often grow a block in place
+   (and re-maps large blocks instead of copying them).  This is only done when libUTL++ provides
+   global new and new[], and got the block from malloc(): in \c UTL_GBLNEW_MODE_FAST mode (for
+   blocks that aren't in a slab), and in \c UTL_GBLNEW_MODE_RELEASE mode with
+   \c UTL_GBLNEW_PROFILE.  Otherwise the block may not have come from malloc(), so it can't be
+   handed to realloc().
+   \see utl::realloc
+   \return address of re-sized block (nullptr if it can't be re-sized this way)
+   \param ptr address of block (allocated by new[] for a trivially destructible type)
+   \param newSize new size of block (non-zero)
+*/
+void* memRealloc(void* ptr, size_t newSize);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 #if (UTL_GBLNEW_MODE == UTL_GBLNEW_MODE_DEBUG) || (UTL_GBLNEW_MODE == UTL_GBLNEW_MODE_DEBUG_MSVC)
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -59,6 +87,79 @@ void memPrintBlocks();
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+#if UTL_GBLNEW_PROFILE
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Stream;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Allocation profile report formats.
+*/
+enum memprofile_t
+{
+    memprofile_pprof,    /**< pprof (legacy heap profile format) */
+    memprofile_collapsed /**< collapsed stacks (for flame graphs) */
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Start (or resume) sampling allocations.  On average, one allocation is sampled for every
+   \b samplingInterval bytes allocated, and the allocating call stack is recorded.
+   \param samplingInterval (optional : 512 KB) mean number of bytes between samples
+*/
+void memProfileStart(size_t samplingInterval = 512 * 1024);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Stop sampling allocations (the samples are kept). */
+void memProfileStop();
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Discard all samples. */
+void memProfileReset();
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Write an allocation profile report to a stream.
+   \param os output stream
+   \param format (optional : memprofile_pprof) report format (see utl::memprofile_t)
+*/
+void memProfileReport(Stream& os, uint_t format = memprofile_pprof);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Write an allocation profile report to a file.
+   \return true if successful, false otherwise
+   \param path file path
+   \param format (optional : memprofile_pprof) report format (see utl::memprofile_t)
+*/
+bool memProfileWrite(const char* path, uint_t format = memprofile_pprof);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Write an allocation profile report to a file whenever the given signal is received.  The
+   report is written by a background thread (not in the signal handler).
+   \return true if successful, false otherwise
+   \param sig signal number (e.g. SIGUSR2)
+   \param path file path
+   \param format (optional : memprofile_pprof) report format (see utl::memprofile_t)
+*/
+bool memProfileWriteOnSignal(int sig, const char* path, uint_t format = memprofile_pprof);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // UTL_GBLNEW_PROFILE
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 UTL_NS_END;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
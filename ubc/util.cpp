@@ -27,6 +27,16 @@
 #include <random>
 #include <libutl/gblnew_macros.h>
 
+// vectorized line scanning (with AVX2 if the CPU has it)
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define UTL_FINDLINEEND_SSE2
+#if (UTL_CC == UTL_CC_GCC) && defined(__x86_64__)
+#include <immintrin.h>
+#define UTL_FINDLINEEND_AVX2
+#endif
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 UTL_NS_BEGIN;
@@ -281,6 +291,16 @@ realloc(void* ptr, size_t size, size_t newSize)
 {
     if (size == newSize)
         return ptr;
+
+    // let the system allocator re-size it in place (or re-map it) if possible
+    if ((ptr != nullptr) && (newSize != 0))
+    {
+        void* newPtr = memRealloc(ptr, newSize);
+        if (newPtr != nullptr)
+            return newPtr;
+    }
+
+    // allocate a new block and copy
     void* newPtr = (newSize == 0) ? nullptr : new byte_t[newSize];
     memcpy(newPtr, ptr, min(size, newSize));
     delete[](byte_t*) ptr;
@@ -302,6 +322,78 @@ strdup(const char* str)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#ifdef UTL_FINDLINEEND_AVX2
+// search whole 32-byte blocks (advancing ptr past them), return nullptr if no match
+__attribute__((target("avx2"))) static const byte_t*
+findLineEndAVX2(const byte_t*& ptr, const byte_t* lim)
+{
+    auto nl = _mm256_set1_epi8('\n');
+    auto nul = _mm256_setzero_si256();
+    for (; (lim - ptr) >= 32; ptr += 32)
+    {
+        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+        auto match = _mm256_or_si256(_mm256_cmpeq_epi8(block, nl), _mm256_cmpeq_epi8(block, nul));
+        uint32_t mask = _mm256_movemask_epi8(match);
+        if (mask != 0)
+            return ptr + lowestBit(mask);
+    }
+    return nullptr;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const byte_t*
+findLineEnd(const byte_t* ptr, const byte_t* lim)
+{
+#ifdef UTL_FINDLINEEND_AVX2
+    // 32 bytes at a time
+    static const bool haveAVX2 = __builtin_cpu_supports("avx2");
+    if (haveAVX2)
+    {
+        auto res = findLineEndAVX2(ptr, lim);
+        if (res != nullptr)
+            return res;
+    }
+#endif
+
+#ifdef UTL_FINDLINEEND_SSE2
+    // 16 bytes at a time
+    auto nl = _mm_set1_epi8('\n');
+    auto nul = _mm_setzero_si128();
+    for (; (lim - ptr) >= 16; ptr += 16)
+    {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+        auto match = _mm_or_si128(_mm_cmpeq_epi8(block, nl), _mm_cmpeq_epi8(block, nul));
+        uint32_t mask = _mm_movemask_epi8(match);
+        if (mask != 0)
+            return ptr + lowestBit(mask);
+    }
+#else
+    // 8 bytes at a time (stop at the first word that has a newline or nul in it)
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t highs = 0x8080808080808080ULL;
+    for (; (lim - ptr) >= 8; ptr += 8)
+    {
+        uint64_t word;
+        memcpy(&word, ptr, 8);
+        uint64_t nlWord = word ^ (ones * '\n');
+        if ((((word - ones) & ~word) | ((nlWord - ones) & ~nlWord)) & highs)
+            break;
+    }
+#endif
+
+    // one byte at a time for the remainder
+    for (; ptr != lim; ++ptr)
+    {
+        if ((*ptr == '\n') || (*ptr == '\0'))
+            break;
+    }
+    return ptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 SSL_CTX*
 sslContext()
 {
@@ -329,6 +421,20 @@ sslVerifyLocations(const char* caFile, const char* caPath)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// read a big-endian (ser_compact) integer of the given size, one byte after another
+static inline uint64_t
+getCompact(Stream& stream, uint_t numBytes)
+{
+    uint64_t res = 0;
+    for (uint_t i = 0; i != numBytes; ++i)
+    {
+        res = (res << 8) | stream.get();
+    }
+    return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void
 serialize(bool& b, Stream& stream, uint_t io, uint_t mode)
 {
@@ -468,7 +574,7 @@ serialize(int16_t& i, Stream& stream, uint_t io, uint_t mode)
     {
         if (io == io_rd)
         {
-            i = ((uint16_t)stream.get() << 8) | (uint16_t)stream.get();
+            i = getCompact(stream, 2);
         }
         else
         {
@@ -515,7 +621,7 @@ serialize(uint16_t& i, Stream& stream, uint_t io, uint_t mode)
     {
         if (io == io_rd)
         {
-            i = ((uint16_t)stream.get() << 8) | (uint16_t)stream.get();
+            i = getCompact(stream, 2);
         }
         else
         {
@@ -562,8 +668,7 @@ serialize(int32_t& i, Stream& stream, uint_t io, uint_t mode)
     {
         if (io == io_rd)
         {
-            i = ((uint32_t)stream.get() << 24) | ((uint32_t)stream.get() << 16) |
-                ((uint32_t)stream.get() << 8) | (uint32_t)stream.get();
+            i = getCompact(stream, 4);
         }
         else
         {
@@ -612,8 +717,7 @@ serialize(uint32_t& i, Stream& stream, uint_t io, uint_t mode)
     {
         if (io == io_rd)
         {
-            i = ((uint32_t)stream.get() << 24) | ((uint32_t)stream.get() << 16) |
-                ((uint32_t)stream.get() << 8) | (uint32_t)stream.get();
+            i = getCompact(stream, 4);
         }
         else
         {
@@ -662,13 +766,7 @@ serialize(long& i, Stream& stream, uint_t io, uint_t mode)
     {
         if (io == io_rd)
         {
-            i = 0;
-#if UTL_SIZEOF_LONG == 8
-            i = ((uint64_t)stream.get() << 56) | ((uint64_t)stream.get() << 48) |
-                ((uint64_t)stream.get() << 40) | ((uint64_t)stream.get() << 32);
-#endif
-            i |= ((uint64_t)stream.get() << 24) | ((uint64_t)stream.get() << 16) |
-                 ((uint64_t)stream.get() << 8) | (uint64_t)stream.get();
+            i = getCompact(stream, UTL_SIZEOF_LONG);
         }
         else
         {
@@ -723,13 +821,7 @@ serialize(ulong_t& i, Stream& stream, uint_t io, uint_t mode)
     {
         if (io == io_rd)
         {
-            i = 0;
-#if UTL_SIZEOF_LONG == 8
-            i = ((ulong_t)stream.get() << 56) | ((ulong_t)stream.get() << 48) |
-                ((ulong_t)stream.get() << 40) | ((ulong_t)stream.get() << 32);
-#endif
-            i |= ((ulong_t)stream.get() << 24) | ((ulong_t)stream.get() << 16) |
-                 ((ulong_t)stream.get() << 8) | (ulong_t)stream.get();
+            i = getCompact(stream, UTL_SIZEOF_LONG);
         }
         else
         {
@@ -788,10 +880,7 @@ serialize(int64_t& i, Stream& stream, uint_t io, uint_t mode)
     {
         if (io == io_rd)
         {
-            i = ((uint64_t)stream.get() << 56) | ((uint64_t)stream.get() << 48) |
-                ((uint64_t)stream.get() << 40) | ((uint64_t)stream.get() << 32) |
-                ((uint64_t)stream.get() << 24) | ((uint64_t)stream.get() << 16) |
-                ((uint64_t)stream.get() << 8) | (uint64_t)stream.get();
+            i = getCompact(stream, 8);
         }
         else
         {
@@ -844,10 +933,7 @@ serialize(uint64_t& i, Stream& stream, uint_t io, uint_t mode)
     {
         if (io == io_rd)
         {
-            i = (int64_t)((uint64_t)stream.get() << 56) | ((uint64_t)stream.get() << 48) |
-                ((uint64_t)stream.get() << 40) | ((uint64_t)stream.get() << 32) |
-                ((uint64_t)stream.get() << 24) | ((uint64_t)stream.get() << 16) |
-                ((uint64_t)stream.get() << 8) | (uint64_t)stream.get();
+            i = getCompact(stream, 8);
         }
         else
         {
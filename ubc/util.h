@@ -186,7 +186,12 @@ void setSerializeMode(uint_t mode);
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
-   Re-allocate the given block.
+   Re-allocate the given block (which was allocated by new[]).  If the block is known to have come
+   from malloc() (see utl::memRealloc), it is re-sized with the system allocator's realloc(), so
+   growing a large block doesn't need a second allocation of the new size (or a copy).  Otherwise,
+   a new block is allocated and the contents are copied over.  Only builds that use libUTL++'s
+   thread-caching allocator (the \c LIBUTL_GBLNEW_FAST build option) or allocation profiling
+   re-size in place: in a default build, and in the debug modes, the block is always copied.
 
    \ingroup utility
    \return address of re-allocated block
@@ -209,6 +214,21 @@ char* strdup(const char* str);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/**
+   Find the end of a line: the first newline or nul in the given range of bytes.
+
+   The range is searched 32 or 16 bytes at a time with AVX2 or SSE2 instructions where the host
+   has them, and 8 bytes at a time otherwise.
+
+   \ingroup utility
+   \return address of the first newline or nul (lim if there is none)
+   \param ptr start of range
+   \param lim end of range
+*/
+const byte_t* findLineEnd(const byte_t* ptr, const byte_t* lim);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /**
    Get a pointer to the global SSL context.
 
@@ -3,6 +3,9 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <libutl/Ordering.h>
+#if UTL_CC == UTL_CC_MSVC
+#include <intrin.h>
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -180,6 +183,28 @@ nextMultipleOfPow2(uint64_t x, uint64_t target)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/**
+   Find the lowest set bit in a (non-zero) 32-bit mask.
+
+   \ingroup math
+   \return index of the lowest set bit
+   \param mask the mask (must not be zero)
+*/
+inline uint_t
+lowestBit(uint32_t mask)
+{
+    ASSERTD(mask != 0);
+#if UTL_CC == UTL_CC_MSVC
+    unsigned long idx;
+    _BitScanForward(&idx, mask);
+    return idx;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /**
    Compute the allocated size of an object.
 
@@ -237,13 +262,15 @@ arrayGrow(T*& array,
     ASSERTD(newSize >= minSize);
 
     // copy objects from old allocation to new
-    T* newArray = new T[newSize];
+    T* newArray;
     if (std::is_trivially_copyable<T>())
     {
-        memcpy(newArray, array, arraySize * sizeof(T));
+        newArray = static_cast<T*>(utl::realloc(array, arraySize * sizeof(T), newSize * sizeof(T)));
+        array = nullptr;
     }
     else
     {
+        newArray = new T[newSize];
         T* lhsPtr = newArray;
         T* rhsPtr = array;
         T* rhsLim = array + arraySize;
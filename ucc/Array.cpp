@@ -187,13 +187,21 @@ Array::shuffle(size_t low, size_t high, randutils::mt19937_64_rng* rng)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void Array::sort(uint_t)
+void
+Array::sort(uint_t algorithm)
 {
     // don't try to sort an array with holes in it
     if (hasHole())
         removeHoles();
     ASSERTD(_array.size() == _items);
 
+    if (algorithm == sort_parallelMergeSort)
+    {
+        utl::parallelMergeSort(_array.get(), 0, _items, ordering());
+        return;
+    }
+    if (utl::radixSort(_array.get(), 0, _items, ordering()))
+        return;
     std::sort(_array.begin(), _array.end(), utl::lessThan<>(this->ordering()));
 }
 
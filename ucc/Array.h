@@ -300,6 +300,10 @@ public:
         sort(sort_quickSort);
     }
 
+    /**
+       Sort the array.  \b sort_parallelMergeSort uses parallelMergeSort().  Otherwise, an array
+       of numbers (see radixSort()) is radix-sorted, and any other array is sorted by std::sort().
+    */
     virtual void sort(uint_t algorithm);
     //@}
 
@@ -0,0 +1,1035 @@
+#include <libutl/libutl.h>
+#include <libutl/Array.h>
+#include <libutl/BTree.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_CLASS_IMPL(utl::BTree);
+UTL_CLASS_IMPL(utl::BTreeIt);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::steal(Object& rhs_)
+{
+    auto& rhs = utl::cast<BTree>(rhs_);
+    deInit();
+    super::steal(rhs);
+    _root = rhs._root;
+    _first = rhs._first;
+    _last = rhs._last;
+    _height = rhs._height;
+    rhs.init();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+BTree::innerAllocatedSize() const
+{
+    return super::innerAllocatedSize() + nodesSize(_root);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::bulkLoad(const Array& array)
+{
+    clear();
+    size_t n = array.items();
+    if (n == 0)
+        return;
+
+#ifdef DEBUG
+    // objects must be sorted
+    for (size_t i = 1; i != n; ++i)
+    {
+        int cmp = compareObjects(array[i - 1], array[i]);
+        ASSERTD(isMultiSet() ? (cmp <= 0) : (cmp < 0));
+    }
+#endif
+
+    // make the leaves, spreading the objects evenly between them
+    delete static_cast<leaf_t*>(_root);
+    size_t levelSize = (n + leaf_max - 1) / leaf_max;
+    node_t** level = new node_t*[levelSize];
+    Object** firstObjects = new Object*[levelSize];
+    size_t objectIdx = 0;
+    leaf_t* prev = nullptr;
+    for (size_t i = 0; i != levelSize; ++i)
+    {
+        leaf_t* leaf = newLeaf();
+        leaf->count = (n / levelSize) + ((i < (n % levelSize)) ? 1 : 0);
+        for (uint_t j = 0; j != leaf->count; ++j)
+        {
+            Object* object = array[objectIdx++];
+            leaf->objects[j] = isOwner() ? object->clone() : object;
+        }
+        leaf->prev = prev;
+        if (prev == nullptr)
+            _first = leaf;
+        else
+            prev->next = leaf;
+        prev = leaf;
+        level[i] = leaf;
+        firstObjects[i] = leaf->objects[0];
+    }
+    _last = prev;
+    _height = 1;
+
+    // build each level of internal nodes from the level beneath it
+    while (levelSize > 1)
+    {
+        size_t parentsSize = (levelSize + inner_max - 1) / inner_max;
+        size_t childIdx = 0;
+        for (size_t i = 0; i != parentsSize; ++i)
+        {
+            inner_t* node = newInner();
+            node->count = (levelSize / parentsSize) + ((i < (levelSize % parentsSize)) ? 1 : 0);
+            Object* firstObject = firstObjects[childIdx];
+            for (uint_t j = 0; j != node->count; ++j, ++childIdx)
+            {
+                node_t* child = level[childIdx];
+                child->parent = node;
+                node->children[j] = child;
+                if (j > 0)
+                    node->keys[j - 1] = firstObjects[childIdx];
+            }
+            level[i] = node;
+            firstObjects[i] = firstObject;
+        }
+        levelSize = parentsSize;
+        ++_height;
+    }
+    _root = level[0];
+    _items = n;
+    delete[] level;
+    delete[] firstObjects;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Object*
+BTree::find(const Object& key) const
+{
+    size_t idx;
+    leaf_t* leaf = findPos(key, find_first, idx);
+    return (leaf == nullptr) ? nullptr : leaf->objects[idx];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BTree::iterator
+BTree::findIt(const Object& key) const
+{
+    iterator it = const_cast_this->findIt(key);
+    IFDEBUG(it.setConst(true));
+    return it;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BTree::iterator
+BTree::findIt(const Object& key)
+{
+    size_t idx = 0;
+    leaf_t* leaf = findPos(key, find_first, idx);
+    return iterator(this, leaf, idx);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::findIt(const Object& key, BidIt& it)
+{
+    it = findIt(key);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::findFirstIt(const Object& key, BidIt& it, bool insert)
+{
+    it = findFirstIt(key, insert);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BTree::iterator
+BTree::findFirstIt(const Object& key, bool insert) const
+{
+    iterator it = const_cast_this->findFirstIt(key, insert);
+    IFDEBUG(it.setConst(true));
+    return it;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BTree::iterator
+BTree::findFirstIt(const Object& key, bool insert)
+{
+    size_t idx = 0;
+    leaf_t* leaf = findPos(key, insert ? find_ip : find_first, idx);
+    return iterator(this, leaf, idx);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::findLastIt(const Object& key, BidIt& it)
+{
+    it = findLastIt(key);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BTree::iterator
+BTree::findLastIt(const Object& key) const
+{
+    iterator it = const_cast_this->findLastIt(key);
+    IFDEBUG(it.setConst(true));
+    return it;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BTree::iterator
+BTree::findLastIt(const Object& key)
+{
+    size_t idx = 0;
+    leaf_t* leaf = findPos(key, find_last, idx);
+    return iterator(this, leaf, idx);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool
+BTree::add(const Object* object)
+{
+    ASSERTD(object != nullptr);
+    leaf_t* leaf = findLeaf(*object, false);
+    size_t idx = lowerBound(leaf->objects, leaf->count, *object);
+
+    // duplicates only allowed in multi-set
+    if (!isMultiSet())
+    {
+        const Object* next = nullptr;
+        if (idx < leaf->count)
+            next = leaf->objects[idx];
+        else if (leaf->next != nullptr)
+            next = leaf->next->objects[0];
+        if ((next != nullptr) && (compareObjects(next, object) == 0))
+        {
+            if (isOwner())
+                delete object;
+            return false;
+        }
+    }
+
+    insertAt(leaf, idx, object);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::insert(const Object* object, const BidIt& it_)
+{
+    auto& it = utl::cast<iterator>(it_.getProxiedObject());
+    IFDEBUG(checkInsert(object, it, true));
+
+    // object becomes the predecessor of the iterator's object
+    leaf_t* leaf = it._leaf;
+    size_t idx = it._idx;
+    if (leaf == nullptr)
+    {
+        leaf = _last;
+        idx = leaf->count;
+    }
+    insertAt(leaf, idx, object);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::clear()
+{
+    freeNodes(_root);
+    _root = _first = _last = newLeaf();
+    _height = 1;
+    _items = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool
+BTree::remove(const Object& key)
+{
+    size_t idx;
+    leaf_t* leaf = findPos(key, find_first, idx);
+
+    // removal fails if key not found
+    if (leaf == nullptr)
+        return false;
+
+    removeAt(leaf, idx);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::removeIt(BidIt& it)
+{
+    ASSERTD(*it != nullptr);
+    auto& bit = utl::cast<iterator>(it.getProxiedObject());
+    ASSERTD(bit.isValid(this));
+    leaf_t* leaf = bit._leaf;
+    size_t idx = bit._idx;
+
+    // note the object that follows the removed one
+    Object* next = nullptr;
+    if ((idx + 1) < leaf->count)
+        next = leaf->objects[idx + 1];
+    else if (leaf->next != nullptr)
+        next = leaf->next->objects[0];
+
+    // no re-balancing -> the next object (if any) is now at the same position
+    if (!removeAt(leaf, idx))
+    {
+        if (idx == leaf->count)
+        {
+            bit._leaf = leaf->next;
+            bit._idx = 0;
+        }
+        return;
+    }
+
+    // the tree was re-balanced -> look for the next object
+    if (next == nullptr)
+    {
+        bit._leaf = nullptr;
+        bit._idx = 0;
+        return;
+    }
+    leaf = findLeaf(*next, false);
+    idx = lowerBound(leaf->objects, leaf->count, *next);
+    while (true)
+    {
+        if (idx == leaf->count)
+        {
+            leaf = leaf->next;
+            idx = 0;
+            ASSERTD(leaf != nullptr);
+        }
+        if (leaf->objects[idx] == next)
+            break;
+        ++idx;
+    }
+    bit._leaf = leaf;
+    bit._idx = idx;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BidIt*
+BTree::beginNew() const
+{
+    auto it = new iterator(this, (_items == 0) ? nullptr : _first, 0);
+    IFDEBUG(it->setConst(true));
+    return it;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BidIt*
+BTree::beginNew()
+{
+    return new iterator(this, (_items == 0) ? nullptr : _first, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BidIt*
+BTree::endNew() const
+{
+    auto it = new iterator(this, nullptr, 0);
+    IFDEBUG(it->setConst(true));
+    return it;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BidIt*
+BTree::endNew()
+{
+    return new iterator(this, nullptr, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef DEBUG
+void
+BTree::sanityCheck() const
+{
+    super::sanityCheck();
+    const Object* first;
+    ASSERT(_root->parent == nullptr);
+    ASSERT(sanityCheck(_root, 1, first) == _items);
+
+    // check the list of leaves
+    size_t items = 0;
+    const leaf_t* prev = nullptr;
+    for (const leaf_t* leaf = _first; leaf != nullptr; leaf = leaf->next)
+    {
+        ASSERT(leaf->prev == prev);
+        items += leaf->count;
+        prev = leaf;
+    }
+    ASSERT(prev == _last);
+    ASSERT(items == _items);
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::init(bool owner, bool multiSet, Ordering* ordering)
+{
+    setOwner(owner);
+    setMultiSet(multiSet);
+    setOrdering(ordering, sort_none);
+    _root = _first = _last = newLeaf();
+    _height = 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::deInit()
+{
+    freeNodes(_root);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BTree::leaf_t*
+BTree::newLeaf()
+{
+    auto leaf = new leaf_t;
+    leaf->parent = nullptr;
+    leaf->count = 0;
+    leaf->isLeaf = true;
+    leaf->prev = leaf->next = nullptr;
+    return leaf;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BTree::inner_t*
+BTree::newInner()
+{
+    auto node = new inner_t;
+    node->parent = nullptr;
+    node->count = 0;
+    node->isLeaf = false;
+    return node;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::freeNodes(node_t* node)
+{
+    if (node->isLeaf)
+    {
+        auto leaf = static_cast<leaf_t*>(node);
+        if (isOwner())
+        {
+            for (uint_t i = 0; i != leaf->count; ++i)
+            {
+                delete leaf->objects[i];
+            }
+        }
+        delete leaf;
+    }
+    else
+    {
+        auto inner = static_cast<inner_t*>(node);
+        for (uint_t i = 0; i != inner->count; ++i)
+        {
+            freeNodes(inner->children[i]);
+        }
+        delete inner;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+BTree::nodesSize(const node_t* node)
+{
+    if (node->isLeaf)
+        return sizeof(leaf_t);
+    auto inner = static_cast<const inner_t*>(node);
+    size_t sz = sizeof(inner_t);
+    for (uint_t i = 0; i != inner->count; ++i)
+    {
+        sz += nodesSize(inner->children[i]);
+    }
+    return sz;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+BTree::lowerBound(Object* const* objects, size_t num, const Object& key) const
+{
+    // find the number of objects < key
+    size_t lo = 0, hi = num;
+    while (lo < hi)
+    {
+        size_t mid = (lo + hi) / 2;
+        if (compareObjects(objects[mid], &key) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+BTree::upperBound(Object* const* objects, size_t num, const Object& key) const
+{
+    // find the number of objects <= key
+    size_t lo = 0, hi = num;
+    while (lo < hi)
+    {
+        size_t mid = (lo + hi) / 2;
+        if (compareObjects(objects[mid], &key) <= 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BTree::leaf_t*
+BTree::findLeaf(const Object& key, bool upper) const
+{
+    node_t* node = _root;
+    while (!node->isLeaf)
+    {
+        auto inner = static_cast<inner_t*>(node);
+        size_t numKeys = inner->count - 1;
+        size_t idx = upper ? upperBound(inner->keys, numKeys, key)
+                           : lowerBound(inner->keys, numKeys, key);
+        node = inner->children[idx];
+    }
+    return static_cast<leaf_t*>(node);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BTree::leaf_t*
+BTree::findPos(const Object& key, uint_t findType, size_t& idx) const
+{
+    leaf_t* leaf;
+    if (findType == find_last)
+    {
+        // the last matching object precedes the first object > key
+        leaf = findLeaf(key, true);
+        idx = upperBound(leaf->objects, leaf->count, key);
+        if (idx == 0)
+        {
+            leaf = leaf->prev;
+            if (leaf == nullptr)
+                return nullptr;
+            idx = leaf->count;
+        }
+        --idx;
+    }
+    else
+    {
+        // the first matching object (or insertion point) is the first object >= key, which may
+        // be at the start of the next leaf
+        ASSERTD((findType == find_first) || (findType == find_ip));
+        leaf = findLeaf(key, false);
+        idx = lowerBound(leaf->objects, leaf->count, key);
+        if (idx == leaf->count)
+        {
+            leaf = leaf->next;
+            idx = 0;
+            if (leaf == nullptr)
+                return nullptr;
+        }
+        if (findType == find_ip)
+            return leaf;
+    }
+    if (compareObjects(leaf->objects[idx], &key) != 0)
+    {
+        idx = 0;
+        return nullptr;
+    }
+    return leaf;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::insertAt(leaf_t* leaf, size_t idx, const Object* object)
+{
+    ASSERTD(idx <= leaf->count);
+    ++_items;
+
+    // room in the leaf?
+    if (leaf->count < leaf_max)
+    {
+        memmove(leaf->objects + idx + 1, leaf->objects + idx,
+                (leaf->count - idx) * sizeof(Object*));
+        leaf->objects[idx] = const_cast<Object*>(object);
+        ++leaf->count;
+        if (idx == 0)
+            updateSeparator(leaf);
+        return;
+    }
+
+    // split the leaf
+    Object* objects[leaf_max + 1];
+    memcpy(objects, leaf->objects, idx * sizeof(Object*));
+    objects[idx] = const_cast<Object*>(object);
+    memcpy(objects + idx + 1, leaf->objects + idx, (leaf_max - idx) * sizeof(Object*));
+    const uint_t leftCount = (leaf_max + 1) / 2;
+    const uint_t rightCount = (leaf_max + 1) - leftCount;
+    leaf_t* right = newLeaf();
+    memcpy(leaf->objects, objects, leftCount * sizeof(Object*));
+    memcpy(right->objects, objects + leftCount, rightCount * sizeof(Object*));
+    leaf->count = leftCount;
+    right->count = rightCount;
+
+    // link the new leaf in after the old one
+    right->prev = leaf;
+    right->next = leaf->next;
+    if (leaf->next == nullptr)
+        _last = right;
+    else
+        leaf->next->prev = right;
+    leaf->next = right;
+
+    if (idx == 0)
+        updateSeparator(leaf);
+    insertChild(leaf, right->objects[0], right);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::insertChild(node_t* left, Object* key, node_t* right)
+{
+    inner_t* node = left->parent;
+
+    // splitting the root -> make a new root
+    if (node == nullptr)
+    {
+        node = newInner();
+        node->count = 2;
+        node->keys[0] = key;
+        node->children[0] = left;
+        node->children[1] = right;
+        left->parent = right->parent = node;
+        _root = node;
+        ++_height;
+        return;
+    }
+
+    // room in the node?
+    size_t idx = childIdx(node, left);
+    if (node->count < inner_max)
+    {
+        memmove(node->keys + idx + 1, node->keys + idx,
+                (node->count - 1 - idx) * sizeof(Object*));
+        memmove(node->children + idx + 2, node->children + idx + 1,
+                (node->count - 1 - idx) * sizeof(node_t*));
+        node->keys[idx] = key;
+        node->children[idx + 1] = right;
+        right->parent = node;
+        ++node->count;
+        return;
+    }
+
+    // split the node
+    Object* keys[inner_max];
+    node_t* children[inner_max + 1];
+    memcpy(keys, node->keys, idx * sizeof(Object*));
+    keys[idx] = key;
+    memcpy(keys + idx + 1, node->keys + idx, (inner_max - 1 - idx) * sizeof(Object*));
+    memcpy(children, node->children, (idx + 1) * sizeof(node_t*));
+    children[idx + 1] = right;
+    memcpy(children + idx + 2, node->children + idx + 1, (inner_max - 1 - idx) * sizeof(node_t*));
+    const uint_t leftCount = (inner_max + 1) / 2;
+    const uint_t rightCount = (inner_max + 1) - leftCount;
+    inner_t* rightNode = newInner();
+    memcpy(node->keys, keys, (leftCount - 1) * sizeof(Object*));
+    memcpy(node->children, children, leftCount * sizeof(node_t*));
+    memcpy(rightNode->keys, keys + leftCount, (rightCount - 1) * sizeof(Object*));
+    memcpy(rightNode->children, children + leftCount, rightCount * sizeof(node_t*));
+    node->count = leftCount;
+    rightNode->count = rightCount;
+    right->parent = node;
+    for (uint_t i = 0; i != rightCount; ++i)
+    {
+        rightNode->children[i]->parent = rightNode;
+    }
+
+    // keys[leftCount - 1] is the first object under rightNode
+    insertChild(node, keys[leftCount - 1], rightNode);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool
+BTree::removeAt(leaf_t* leaf, size_t idx)
+{
+    ASSERTD(idx < leaf->count);
+    if (isOwner())
+        delete leaf->objects[idx];
+    --leaf->count;
+    memmove(leaf->objects + idx, leaf->objects + idx + 1, (leaf->count - idx) * sizeof(Object*));
+    --_items;
+    if ((idx == 0) && (leaf->count > 0))
+        updateSeparator(leaf);
+
+    // underflow?
+    if ((leaf == _root) || (leaf->count >= leaf_min))
+        return false;
+    rebalance(leaf);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::removeChild(inner_t* node, size_t idx)
+{
+    // the child's separator is keys[idx - 1]
+    ASSERTD((idx > 0) && (idx < node->count));
+    --node->count;
+    memmove(node->keys + idx - 1, node->keys + idx, (node->count - idx) * sizeof(Object*));
+    memmove(node->children + idx, node->children + idx + 1,
+            (node->count - idx) * sizeof(node_t*));
+
+    if (node == _root)
+    {
+        // root with a single child -> child becomes the root
+        if (node->count == 1)
+        {
+            _root = node->children[0];
+            _root->parent = nullptr;
+            delete node;
+            --_height;
+        }
+    }
+    else if (node->count < inner_min)
+    {
+        rebalance(node);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::rebalance(leaf_t* leaf)
+{
+    inner_t* parent = leaf->parent;
+    size_t idx = childIdx(parent, leaf);
+    leaf_t* left = (idx > 0) ? static_cast<leaf_t*>(parent->children[idx - 1]) : nullptr;
+    leaf_t* right =
+        ((idx + 1) < parent->count) ? static_cast<leaf_t*>(parent->children[idx + 1]) : nullptr;
+
+    // borrow from the left sibling
+    if ((left != nullptr) && (left->count > leaf_min))
+    {
+        memmove(leaf->objects + 1, leaf->objects, leaf->count * sizeof(Object*));
+        leaf->objects[0] = left->objects[--left->count];
+        ++leaf->count;
+        parent->keys[idx - 1] = leaf->objects[0];
+        return;
+    }
+
+    // borrow from the right sibling
+    if ((right != nullptr) && (right->count > leaf_min))
+    {
+        leaf->objects[leaf->count++] = right->objects[0];
+        --right->count;
+        memmove(right->objects, right->objects + 1, right->count * sizeof(Object*));
+        parent->keys[idx] = right->objects[0];
+        return;
+    }
+
+    // merge with a sibling (the right one of the pair is removed)
+    if (left == nullptr)
+    {
+        left = leaf;
+        ++idx;
+    }
+    else
+    {
+        right = leaf;
+    }
+    ASSERTD((left->count + right->count) <= leaf_max);
+    memcpy(left->objects + left->count, right->objects, right->count * sizeof(Object*));
+    left->count += right->count;
+    left->next = right->next;
+    if (right->next == nullptr)
+        _last = left;
+    else
+        right->next->prev = left;
+    delete right;
+    removeChild(parent, idx);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::rebalance(inner_t* node)
+{
+    inner_t* parent = node->parent;
+    size_t idx = childIdx(parent, node);
+    inner_t* left = (idx > 0) ? static_cast<inner_t*>(parent->children[idx - 1]) : nullptr;
+    inner_t* right =
+        ((idx + 1) < parent->count) ? static_cast<inner_t*>(parent->children[idx + 1]) : nullptr;
+
+    // borrow the left sibling's last child (rotating the separators)
+    if ((left != nullptr) && (left->count > inner_min))
+    {
+        memmove(node->keys + 1, node->keys, (node->count - 1) * sizeof(Object*));
+        memmove(node->children + 1, node->children, node->count * sizeof(node_t*));
+        --left->count;
+        node->keys[0] = parent->keys[idx - 1];
+        node->children[0] = left->children[left->count];
+        node->children[0]->parent = node;
+        parent->keys[idx - 1] = left->keys[left->count - 1];
+        ++node->count;
+        return;
+    }
+
+    // borrow the right sibling's first child
+    if ((right != nullptr) && (right->count > inner_min))
+    {
+        node->keys[node->count - 1] = parent->keys[idx];
+        node->children[node->count] = right->children[0];
+        node->children[node->count]->parent = node;
+        ++node->count;
+        parent->keys[idx] = right->keys[0];
+        --right->count;
+        memmove(right->keys, right->keys + 1, (right->count - 1) * sizeof(Object*));
+        memmove(right->children, right->children + 1, right->count * sizeof(node_t*));
+        return;
+    }
+
+    // merge with a sibling (the right one of the pair is removed)
+    if (left == nullptr)
+    {
+        left = node;
+        ++idx;
+    }
+    else
+    {
+        right = node;
+    }
+    ASSERTD((left->count + right->count) <= inner_max);
+    left->keys[left->count - 1] = parent->keys[idx - 1];
+    memcpy(left->keys + left->count, right->keys, (right->count - 1) * sizeof(Object*));
+    for (uint_t i = 0; i != right->count; ++i)
+    {
+        node_t* child = right->children[i];
+        child->parent = left;
+        left->children[left->count + i] = child;
+    }
+    left->count += right->count;
+    delete right;
+    removeChild(parent, idx);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTree::updateSeparator(leaf_t* leaf)
+{
+    // the leaf's separator is held by the nearest ancestor it isn't the leftmost descendant of
+    node_t* node = leaf;
+    for (inner_t* parent = node->parent; parent != nullptr; parent = parent->parent)
+    {
+        size_t idx = childIdx(parent, node);
+        if (idx > 0)
+        {
+            parent->keys[idx - 1] = leaf->objects[0];
+            return;
+        }
+        node = parent;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+BTree::childIdx(const inner_t* parent, const node_t* child)
+{
+    size_t idx = 0;
+    while (parent->children[idx] != child)
+    {
+        ++idx;
+        ASSERTD(idx < parent->count);
+    }
+    return idx;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef DEBUG
+size_t
+BTree::sanityCheck(const node_t* node, uint_t depth, const Object*& first) const
+{
+    if (node->isLeaf)
+    {
+        ASSERT(depth == _height);
+        auto leaf = static_cast<const leaf_t*>(node);
+        ASSERT(leaf->count <= leaf_max);
+        ASSERT((leaf == _root) || (leaf->count >= leaf_min));
+        first = (leaf->count == 0) ? nullptr : leaf->objects[0];
+        return leaf->count;
+    }
+
+    auto inner = static_cast<const inner_t*>(node);
+    ASSERT(inner->count <= inner_max);
+    ASSERT((inner == _root) ? (inner->count >= 2) : (inner->count >= inner_min));
+    size_t items = 0;
+    for (uint_t i = 0; i != inner->count; ++i)
+    {
+        const node_t* child = inner->children[i];
+        ASSERT(child->parent == inner);
+        const Object* childFirst;
+        items += sanityCheck(child, depth + 1, childFirst);
+        if (i == 0)
+            first = childFirst;
+        else
+            ASSERT(inner->keys[i - 1] == childFirst);
+    }
+    return items;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+BTreeIt::compare(const Object& rhs) const
+{
+    auto& bit = utl::cast<BTreeIt>(rhs);
+    ASSERTD(hasSameOwner(bit));
+    int res = utl::compare(_leaf, bit._leaf);
+    if (res != 0)
+        return res;
+    return utl::compare(_idx, bit._idx);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTreeIt::copy(const Object& rhs)
+{
+    auto& bit = utl::cast<BTreeIt>(rhs);
+    super::copy(bit);
+    _tree = bit._tree;
+    _leaf = bit._leaf;
+    _idx = bit._idx;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTreeIt::forward(size_t dist)
+{
+    ASSERTD(isValid(_tree));
+    while ((dist-- > 0) && (_leaf != nullptr))
+    {
+        if (++_idx == _leaf->count)
+        {
+            _leaf = _leaf->next;
+            _idx = 0;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTreeIt::reverse(size_t dist)
+{
+    ASSERTD(isValid(_tree));
+    while (dist-- > 0)
+    {
+        if (_leaf == nullptr)
+        {
+            // end -> last object
+            if (_tree->_items == 0)
+                break;
+            _leaf = _tree->_last;
+            _idx = _leaf->count - 1;
+        }
+        else if (_idx > 0)
+        {
+            --_idx;
+        }
+        else if (_leaf->prev != nullptr)
+        {
+            _leaf = _leaf->prev;
+            _idx = _leaf->count - 1;
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BTreeIt::set(const Object* object)
+{
+    ASSERTD(!isConst());
+    ASSERTD(isValid(_tree));
+
+    if (_leaf == nullptr)
+    {
+        ASSERTD(object != nullptr);
+        _tree->add(object);
+    }
+    else if (object == nullptr)
+    {
+        _tree->removeIt(*this);
+    }
+    else
+    {
+        Object* treeObject = _leaf->objects[_idx];
+        if (object == treeObject)
+            return;
+        if (_tree->isOwner())
+            delete treeObject;
+        _leaf->objects[_idx] = const_cast<Object*>(object);
+        if (_idx == 0)
+            _tree->updateSeparator(_leaf);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
@@ -0,0 +1,302 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/SortedCollection.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Array;
+class BTreeIt;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// BTree ///////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   B+ tree.
+
+   RBtree and SkipList allocate a node for every contained object, so walking through them (or
+   searching them) touches a different cache line at nearly every step.  BTree instead keeps up
+   to 28 object pointers in each leaf node, and up to 15 children in each internal node, so each
+   node occupies a handful of adjacent cache lines, and the tree is very shallow (a tree holding
+   ten million objects is only 6 levels deep).  The leaves are linked together, so iteration is
+   a simple walk through arrays of object pointers.
+
+   Each separator key stored in an internal node is a pointer to the first object in the subtree
+   to its right, so no copies of objects (or their keys) are ever made.
+
+   A sorted Array can be loaded into a BTree in O(n) time with bulkLoad().
+
+   <b>Advantages</b>
+
+   \arg add(), find(), remove() are O(log n)
+   \arg contained objects are always sorted
+   \arg few cache misses for searching, and fewer still for iteration
+   \arg much less memory overhead per object than RBtree or SkipList
+
+   <b>Disadvantages</b>
+
+   \arg adding or removing an object invalidates iterators (other than the one given to
+   removeIt())
+
+   \author Adam McKee
+   \ingroup collection
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class BTree : public SortedCollection
+{
+    UTL_CLASS_DECL(BTree, SortedCollection);
+    friend class BTreeIt;
+
+public:
+    typedef BTreeIt iterator;
+
+public:
+    /**
+       Constructor.
+       \param owner \b owner flag
+       \param multiSet (optional : false) \b multiSet flag
+       \param ordering (optional) ordering
+    */
+    BTree(bool owner, bool multiSet = false, Ordering* ordering = nullptr)
+    {
+        init(owner, multiSet, ordering);
+    }
+
+    virtual void steal(Object& rhs);
+
+    virtual size_t innerAllocatedSize() const;
+
+    /**
+       Replace the contents of the tree with the objects in the given array, which must already be
+       sorted according to the tree's ordering (and contain no duplicates unless isMultiSet()).
+       The tree is built bottom-up in O(n) time.  If isOwner(), copies of the objects are added.
+       \param array sorted array of objects
+    */
+    void bulkLoad(const Array& array);
+
+    /// \name Searching
+    //@{
+    virtual Object* find(const Object& key) const;
+
+    iterator findIt(const Object& key) const;
+
+    iterator findIt(const Object& key);
+
+    void
+    findIt(const Object& key, BidIt& it) const
+    {
+        const_cast_this->findIt(key, it);
+        IFDEBUG(it.setConst(true));
+    }
+
+    virtual void findIt(const Object& key, BidIt& it);
+
+    void
+    findFirstIt(const Object& key, BidIt& it, bool insert = false) const
+    {
+        const_cast_this->findFirstIt(key, it, insert);
+        IFDEBUG(it.setConst(true));
+    }
+
+    virtual void findFirstIt(const Object& key, BidIt& it, bool insert = false);
+
+    /**
+       Find the first object matching the given key.
+       \return const iterator for found object (= end if none found)
+       \param key search key
+       \param insert (optional : false) find insertion point?
+    */
+    iterator findFirstIt(const Object& key, bool insert = false) const;
+
+    /**
+       Find the first object matching the given key.
+       \return iterator for found object (= end if none found)
+       \param key search key
+       \param insert (optional : false) find insertion point?
+    */
+    iterator findFirstIt(const Object& key, bool insert = false);
+
+    void
+    findLastIt(const Object& key, BidIt& it) const
+    {
+        const_cast_this->findLastIt(key, it);
+        IFDEBUG(it.setConst(true));
+    }
+
+    virtual void findLastIt(const Object& key, BidIt& it);
+
+    /**
+       Find the last object matching the given key.
+       \return const iterator for found object (= end if none found)
+       \param key search key
+    */
+    iterator findLastIt(const Object& key) const;
+
+    /**
+       Find the last object matching the given key.
+       \return iterator for found object (= end if none found)
+       \param key search key
+    */
+    iterator findLastIt(const Object& key);
+    //@}
+
+    /// \name Adding Objects
+    //@{
+    bool
+    add(const Object& object)
+    {
+        return super::add(object);
+    }
+
+    virtual bool add(const Object* object);
+
+    void
+    add(const Collection& collection)
+    {
+        super::add(collection);
+    }
+
+    void
+    insert(const Object& object, const BidIt& it)
+    {
+        return super::insert(object, it);
+    }
+
+    virtual void insert(const Object* object, const BidIt& it);
+    //@}
+
+    /// \name Removing Objects
+    //@{
+    virtual void clear();
+
+    bool
+    remove(const Object* key)
+    {
+        ASSERTD(key != nullptr);
+        return remove(*key);
+    }
+
+    virtual bool remove(const Object& key);
+
+    virtual void removeIt(BidIt& it);
+    //@}
+
+    /// \name Iterators
+    //@{
+    inline iterator begin() const;
+
+    inline iterator begin();
+
+    virtual BidIt* beginNew() const;
+
+    virtual BidIt* beginNew();
+
+    inline iterator end() const;
+
+    inline iterator end();
+
+    virtual BidIt* endNew() const;
+
+    virtual BidIt* endNew();
+    //@}
+
+#ifdef DEBUG
+    virtual void sanityCheck() const;
+#endif
+
+private:
+    // maximum number of objects in a leaf
+    static constexpr uint_t leaf_max = 28;
+
+    // maximum number of children of an internal node
+    static constexpr uint_t inner_max = 15;
+
+    // minimum counts for nodes other than the root
+    static constexpr uint_t leaf_min = leaf_max / 2;
+    static constexpr uint_t inner_min = (inner_max + 1) / 2;
+
+    struct inner_t;
+
+    struct node_t
+    {
+        inner_t* parent;
+        uint_t count; // # of objects (leaf) or children (internal node)
+        bool isLeaf;
+    };
+
+    struct leaf_t : public node_t
+    {
+        leaf_t* prev;
+        leaf_t* next;
+        Object* objects[leaf_max];
+    };
+
+    struct inner_t : public node_t
+    {
+        Object* keys[inner_max - 1]; // keys[i] = first object under children[i + 1]
+        node_t* children[inner_max];
+    };
+
+private:
+    void init(bool owner = true, bool multiSet = false, Ordering* ordering = nullptr);
+    void deInit();
+
+    leaf_t* newLeaf();
+
+    inner_t* newInner();
+
+    void freeNodes(node_t* node);
+
+    static size_t nodesSize(const node_t* node);
+
+    size_t lowerBound(Object* const* objects, size_t num, const Object& key) const;
+
+    size_t upperBound(Object* const* objects, size_t num, const Object& key) const;
+
+    leaf_t* findLeaf(const Object& key, bool upper) const;
+
+    leaf_t* findPos(const Object& key, uint_t findType, size_t& idx) const;
+
+    void insertAt(leaf_t* leaf, size_t idx, const Object* object);
+
+    void insertChild(node_t* left, Object* key, node_t* right);
+
+    bool removeAt(leaf_t* leaf, size_t idx);
+
+    void removeChild(inner_t* node, size_t childIdx);
+
+    void rebalance(leaf_t* leaf);
+
+    void rebalance(inner_t* node);
+
+    void updateSeparator(leaf_t* leaf);
+
+    static size_t childIdx(const inner_t* parent, const node_t* child);
+
+#ifdef DEBUG
+    size_t sanityCheck(const node_t* node, uint_t depth, const Object*& first) const;
+#endif
+
+private:
+    node_t* _root;
+    leaf_t* _first;
+    leaf_t* _last;
+    uint_t _height;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/BTreeIt.h>
+#include <libutl/TBTree.h>
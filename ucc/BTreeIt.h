@@ -0,0 +1,155 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/BidIt.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Bi-directional BTree iterator.
+
+   \author Adam McKee
+   \ingroup collection
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class BTreeIt : public BidIt
+{
+    UTL_CLASS_DECL(BTreeIt, BidIt);
+    friend class BTree;
+
+public:
+    /**
+       Constructor.
+       \param tree associated BTree
+       \param leaf leaf node (nullptr for end)
+       \param idx index of object within leaf
+    */
+    BTreeIt(const BTree* tree, BTree::leaf_t* leaf, size_t idx)
+        : _tree(const_cast<BTree*>(tree))
+        , _leaf(leaf)
+        , _idx(idx)
+    {
+        IFDEBUG(FwdIt::setOwner(_tree));
+    }
+
+    /** Compare with another BTreeIt. */
+    virtual int compare(const Object& rhs) const;
+
+    /** Copy another BTreeIt. */
+    virtual void copy(const Object& rhs);
+
+    virtual void forward(size_t dist = 1);
+
+    virtual Object*
+    get() const
+    {
+        ASSERTD(isValid(_tree));
+        return (_leaf == nullptr) ? nullptr : _leaf->objects[_idx];
+    }
+
+    /** Get the associated BTree. */
+    BTree*
+    tree() const
+    {
+        return _tree;
+    }
+
+    virtual void reverse(size_t dist = 1);
+
+    virtual void set(const Object* object);
+
+    BTreeIt&
+    operator++()
+    {
+        forward();
+        return *this;
+    }
+
+    BTreeIt
+    operator++(int)
+    {
+        BTreeIt res = *this;
+        forward();
+        return res;
+    }
+
+    BTreeIt&
+    operator--()
+    {
+        reverse();
+        return *this;
+    }
+
+    BTreeIt
+    operator--(int)
+    {
+        BTreeIt res = *this;
+        reverse();
+        return res;
+    }
+
+private:
+    void
+    init()
+    {
+        _tree = nullptr;
+        _leaf = nullptr;
+        _idx = 0;
+    }
+    void
+    deInit()
+    {
+    }
+
+private:
+    BTree* _tree;
+    BTree::leaf_t* _leaf;
+    size_t _idx;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BTree::iterator
+BTree::begin() const
+{
+    iterator it(this, (_items == 0) ? nullptr : _first, 0);
+    IFDEBUG(it.setConst(true));
+    return it;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BTree::iterator
+BTree::begin()
+{
+    return iterator(this, (_items == 0) ? nullptr : _first, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BTree::iterator
+BTree::end() const
+{
+    iterator it(this, nullptr, 0);
+    IFDEBUG(it.setConst(true));
+    return it;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BTree::iterator
+BTree::end()
+{
+    return iterator(this, nullptr, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
@@ -330,6 +330,14 @@ BinTree::clear(BinTreeNode* node)
     }
 
     // delete the node
+    destroyNode(node);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BinTree::destroyNode(BinTreeNode* node)
+{
     delete node;
 }
 
@@ -611,7 +619,7 @@ BinTree::removeNode(BinTreeNode* node)
     }
 
     // delete the node
-    delete node;
+    destroyNode(node);
 
     // return the address of the deleted node
     return node;
@@ -646,7 +654,8 @@ void
 BinTree::deInit()
 {
     // remove all objects
-    clear(_root);
+    if (_root != nullptr)
+        clear(_root);
     _root = nullptr;
     _items = 0;
 }
@@ -274,6 +274,7 @@ protected:
     }
     void clear(BinTreeNode* node);
     virtual BinTreeNode* createNode(const Object* object) = 0;
+    virtual void destroyNode(BinTreeNode* node);
     BinTreeNode* findFirstMatch(const Object& key, BinTreeNode* node) const;
     BinTreeNode* findInsertionPoint(const Object& key, bool* insertLeft = nullptr) const;
     iterator findIt(const Object& key, uint_t findType) const;
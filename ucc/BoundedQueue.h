@@ -0,0 +1,341 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/Futex.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Thread-safe fixed-size queue (multi-producer, multi-consumer) with optional blocking.
+
+   BoundedQueue is a sibling of RingBuffer that is meant to be used as a pipe between stages of
+   a pipeline: when it's full, producers can wait for room (back-pressure), and when it's empty,
+   consumers can wait for values, in both cases without burning CPU in a spin loop.
+
+   Each slot carries a sequence number that tells producers and consumers whether the slot is
+   ready for them at their current position (D. Vyukov's bounded MPMC queue), so there is no
+   global lock, and no special "null" value is needed.  A producer claims a position by advancing
+   the enqueue position with compare-and-swap, stores its value and publishes the slot by
+   updating its sequence number; consumers do the same with the dequeue position.  The batch
+   versions of enQ() and deQ() claim as many consecutive ready slots as they can (up to the
+   requested number) with a single compare-and-swap.
+
+   If the queue is constructed with the blocking flag, enQwait() and deQwait() sleep (on a Futex)
+   until they can make progress or their timeout expires.  Queues that don't block skip the
+   wake-up checks.
+
+   \author Adam McKee
+   \ingroup collection
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+class BoundedQueue
+{
+public:
+    /** Default constructor. */
+    BoundedQueue()
+    {
+        _cells = nullptr;
+    }
+
+    /**
+       Constructor.
+       \param size capacity (rounded up to a power of 2)
+       \param blocking (optional : false) support enQwait() and deQwait()?
+    */
+    BoundedQueue(size_t size, bool blocking = false)
+    {
+        _cells = nullptr;
+        set(size, blocking);
+    }
+
+    /** Destructor. */
+    ~BoundedQueue()
+    {
+        reset();
+    }
+
+    /** Initialize. */
+    void set(size_t size, bool blocking = false);
+
+    /** Reset to default state (not thread-safe!). */
+    void reset();
+
+    /** Get the capacity. */
+    size_t
+    size() const
+    {
+        return _size;
+    }
+
+    /** Sample the number of contained values. */
+    size_t
+    count() const
+    {
+        auto deqPos = _deqPos.load(std::memory_order_relaxed);
+        auto enqPos = _enqPos.load(std::memory_order_relaxed);
+        return (enqPos > deqPos) ? min(enqPos - deqPos, _size) : 0;
+    }
+
+    /**
+       Try to queue a value (without blocking).
+       \return true iff the value was queued
+    */
+    bool
+    enQ(const T& value)
+    {
+        return (enQ(&value, 1) != 0);
+    }
+
+    /**
+       Queue as many of the given values as there is room for (without blocking).
+       \return number of values queued (from the start of \b values)
+       \param values values to queue
+       \param num number of values
+    */
+    size_t enQ(const T* values, size_t num);
+
+    /**
+       Try to dequeue a value (without blocking).
+       \return true iff a value was copied into \b value
+    */
+    bool
+    deQ(T& value)
+    {
+        return (deQ(&value, 1) != 0);
+    }
+
+    /**
+       Dequeue up to \b max values (without blocking).
+       \return number of values copied into \b values
+       \param values target array
+       \param max maximum number of values to dequeue
+    */
+    size_t deQ(T* values, size_t max);
+
+    /**
+       Queue a value, waiting for room if the queue is full.  The queue must have been constructed
+       with the blocking flag.
+       \return true iff the value was queued (false if the timeout expired)
+       \param value value to queue
+       \param msec (optional : uint_t_max) timeout in milliseconds (uint_t_max = wait forever)
+    */
+    bool
+    enQwait(const T& value, uint_t msec = uint_t_max)
+    {
+        ASSERTD(_blocking);
+        return _notFull.waitFor([this, &value]() { return enQ(value); }, msec);
+    }
+
+    /**
+       Dequeue a value, waiting for one to arrive if the queue is empty.  The queue must have been
+       constructed with the blocking flag.
+       \return true iff a value was dequeued (false if the timeout expired)
+       \param value target instance of T
+       \param msec (optional : uint_t_max) timeout in milliseconds (uint_t_max = wait forever)
+    */
+    bool
+    deQwait(T& value, uint_t msec = uint_t_max)
+    {
+        ASSERTD(_blocking);
+        return _notEmpty.waitFor([this, &value]() { return deQ(value); }, msec);
+    }
+
+    /** Execute the given function on each contained value (not thread-safe!). */
+    void forEach(std::function<void(T)> f) const;
+
+private:
+    struct Cell
+    {
+        T*
+        ptr()
+        {
+            return reinterpret_cast<T*>(&storage);
+        }
+
+    public:
+        std::atomic_size_t seq;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+private:
+    // constant values
+    Cell* _cells;
+    size_t _mask;
+    size_t _size;
+    bool _blocking;
+    // concurrently modified values
+    char pad0[UTL_ARCH_CACHE_LINE_SIZE - (3 * sizeof(size_t)) - sizeof(bool)];
+    std::atomic_size_t _enqPos;
+    char pad1[UTL_ARCH_CACHE_LINE_SIZE - sizeof(size_t)];
+    std::atomic_size_t _deqPos;
+    char pad2[UTL_ARCH_CACHE_LINE_SIZE - sizeof(size_t)];
+    Futex _notEmpty;
+    char pad3[UTL_ARCH_CACHE_LINE_SIZE - sizeof(Futex)];
+    Futex _notFull;
+    char pad4[UTL_ARCH_CACHE_LINE_SIZE - sizeof(Futex)];
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void
+BoundedQueue<T>::set(size_t size, bool blocking)
+{
+    ASSERTD(_cells == nullptr);
+
+    // _size is a power of 2
+    _size = 2;
+    while (_size < size)
+    {
+        _size <<= 1;
+    }
+    _mask = _size - 1;
+    _blocking = blocking;
+    _enqPos = _deqPos = 0;
+    _cells = new Cell[_size];
+    for (size_t i = 0; i != _size; ++i)
+    {
+        _cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void
+BoundedQueue<T>::reset()
+{
+    if (_cells == nullptr)
+        return;
+    auto enqPos = _enqPos.load(std::memory_order_relaxed);
+    for (auto pos = _deqPos.load(std::memory_order_relaxed); pos != enqPos; ++pos)
+    {
+        auto& cell = _cells[pos & _mask];
+        if (cell.seq.load(std::memory_order_relaxed) == (pos + 1))
+            cell.ptr()->~T();
+    }
+    delete[] _cells;
+    _cells = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#undef new
+template <typename T>
+size_t
+BoundedQueue<T>::enQ(const T* values, size_t num)
+{
+    auto pos = _enqPos.load(std::memory_order_relaxed);
+    while (num != 0)
+    {
+        // count the consecutive slots (up to num) that are free at their position
+        size_t n;
+        for (n = 0; n != num; ++n)
+        {
+            if (_cells[(pos + n) & _mask].seq.load(std::memory_order_acquire) != (pos + n))
+                break;
+        }
+
+        if (n == 0)
+        {
+            // full, or another producer got here first?
+            auto seq = _cells[pos & _mask].seq.load(std::memory_order_acquire);
+            if ((ssize_t)(seq - pos) < 0)
+                return 0;
+            pos = _enqPos.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        // claim [pos, pos + n)
+        if (!_enqPos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed,
+                                           std::memory_order_relaxed))
+        {
+            continue;
+        }
+        for (size_t i = 0; i != n; ++i)
+        {
+            auto& cell = _cells[(pos + i) & _mask];
+            ::new (&cell.storage) T(values[i]);
+            cell.seq.store(pos + i + 1, std::memory_order_release);
+        }
+        if (_blocking)
+            _notEmpty.notify((n == 1) ? 1 : int_t_max);
+        return n;
+    }
+    return 0;
+}
+#include <libutl/gblnew_macros.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+size_t
+BoundedQueue<T>::deQ(T* values, size_t max)
+{
+    auto pos = _deqPos.load(std::memory_order_relaxed);
+    while (max != 0)
+    {
+        // count the consecutive slots (up to max) that have been filled for their position
+        size_t n;
+        for (n = 0; n != max; ++n)
+        {
+            if (_cells[(pos + n) & _mask].seq.load(std::memory_order_acquire) != (pos + n + 1))
+                break;
+        }
+
+        if (n == 0)
+        {
+            // empty, or another consumer got here first?
+            auto seq = _cells[pos & _mask].seq.load(std::memory_order_acquire);
+            if ((ssize_t)(seq - (pos + 1)) < 0)
+                return 0;
+            pos = _deqPos.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        // claim [pos, pos + n)
+        if (!_deqPos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed,
+                                           std::memory_order_relaxed))
+        {
+            continue;
+        }
+        for (size_t i = 0; i != n; ++i)
+        {
+            auto& cell = _cells[(pos + i) & _mask];
+            values[i] = std::move(*cell.ptr());
+            cell.ptr()->~T();
+            cell.seq.store(pos + i + _size, std::memory_order_release);
+        }
+        if (_blocking)
+            _notFull.notify((n == 1) ? 1 : int_t_max);
+        return n;
+    }
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void
+BoundedQueue<T>::forEach(std::function<void(T)> func) const
+{
+    auto enqPos = _enqPos.load(std::memory_order_relaxed);
+    for (auto pos = _deqPos.load(std::memory_order_relaxed); pos != enqPos; ++pos)
+    {
+        auto& cell = _cells[pos & _mask];
+        if (cell.seq.load(std::memory_order_acquire) == (pos + 1))
+            func(*const_cast<Cell&>(cell).ptr());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
@@ -1,7 +1,9 @@
 #include <libutl/libutl.h>
 #include <libutl/Bool.h>
 #include <libutl/Collection.h>
+#include <libutl/MemoryCensus.h>
 #include <libutl/RBtree.h>
+#include <libutl/Rope.h>
 #include <libutl/AutoPtr.h>
 #include <libutl/Uint.h>
 #include <libutl/dlist.h>
@@ -161,6 +163,28 @@ Collection::innerAllocatedSize() const
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+Collection::censusOwned(MemoryCensus& census) const
+{
+    // ordering
+    if (_ordering != nullptr)
+        census.add(*_ordering);
+
+    // contained objects (if we own them)
+    if (isOwner())
+    {
+        AutoPtr<BidIt> it = beginNew();
+        while (!it->isEnd())
+        {
+            Object* object = **it;
+            census.add(*object);
+            it->forward();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 bool
 Collection::update(const Object* object)
 {
@@ -336,7 +360,7 @@ Collection::dump(Stream& os,
 String
 Collection::toString() const
 {
-    return "{ " + toString(", ") + " }";
+    return toString(false);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -344,7 +368,15 @@ Collection::toString() const
 String
 Collection::toString(bool key) const
 {
-    return "{ " + toString(", ", key) + " }";
+    // create iterators
+    AutoPtr<BidIt> begin = beginNew();
+    AutoPtr<BidIt> end = endNew();
+
+    // "{ " + utl::toString(...) + " }" without copying the whole string twice
+    Rope rope("{ ");
+    utl::toRope(*begin, *end, ", ", rope, key);
+    rope += " }";
+    return rope.toString();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -101,6 +101,8 @@ public:
 
     virtual size_t innerAllocatedSize() const;
 
+    virtual void censusOwned(MemoryCensus& census) const;
+
     /**
        Update the given object.
        \return true if object successfully found and updated, false otherwise
@@ -0,0 +1,263 @@
+#include <libutl/libutl.h>
+#include <libutl/ConcurrentHashtable.h>
+#include <libutl/MemoryCensus.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// ConcurrentHashtable /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+ConcurrentHashtable::innerAllocatedSize() const
+{
+    auto sz = _numShards * sizeof(shard_t);
+    for (size_t i = 0; i != _numShards; ++i)
+    {
+        auto& s = _shards[i];
+        RWlockLFguard guard(&s.lock, io_rd);
+        sz += s.ht.innerAllocatedSize();
+    }
+    return sz;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentHashtable::censusOwned(MemoryCensus& census) const
+{
+    for (size_t i = 0; i != _numShards; ++i)
+    {
+        auto& s = _shards[i];
+        RWlockLFguard guard(&s.lock, io_rd);
+        s.ht.censusOwned(census);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+ConcurrentHashtable::items() const
+{
+    size_t res = 0;
+    for (size_t i = 0; i != _numShards; ++i)
+    {
+        auto& s = _shards[i];
+        RWlockLFguard guard(&s.lock, io_rd);
+        res += s.ht.items();
+    }
+    return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentHashtable::reserve(size_t newSize)
+{
+    auto shardSize = (newSize + _numShards - 1) / _numShards;
+    for (size_t i = 0; i != _numShards; ++i)
+    {
+        auto& s = _shards[i];
+        RWlockLFguard guard(&s.lock, io_wr);
+        s.ht.reserve(shardSize);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Object*
+ConcurrentHashtable::find(const Object& key) const
+{
+    auto h = hash(&key);
+    auto& s = shard(h);
+    RWlockLFguard guard(&s.lock, io_rd);
+    auto idx = s.ht.findIdx(key, h);
+    return (idx == size_t_max) ? nullptr : s.ht._slots[idx].object;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool
+ConcurrentHashtable::add(const Object* object)
+{
+    auto h = hash(object);
+    auto& s = shard(h);
+    RWlockLFguard guard(&s.lock, io_wr);
+    if (!_multiSet && (s.ht.findIdx(*object, h) != size_t_max))
+    {
+        if (_owner)
+            delete object;
+        return false;
+    }
+    s.ht.insert(const_cast<Object*>(object), h);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Object*
+ConcurrentHashtable::addOrFind(const Object* object)
+{
+    auto h = hash(object);
+    auto& s = shard(h);
+    RWlockLFguard guard(&s.lock, io_wr);
+    if (!_multiSet)
+    {
+        auto idx = s.ht.findIdx(*object, h);
+        if (idx != size_t_max)
+        {
+            if (_owner)
+                delete object;
+            return s.ht._slots[idx].object;
+        }
+    }
+    s.ht.insert(const_cast<Object*>(object), h);
+    return const_cast<Object*>(object);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool
+ConcurrentHashtable::addOrUpdate(const Object* object)
+{
+    auto h = hash(object);
+    auto& s = shard(h);
+    RWlockLFguard guard(&s.lock, io_wr);
+    if (!_multiSet)
+    {
+        auto idx = s.ht.findIdx(*object, h);
+        if (idx != size_t_max)
+        {
+            auto& slot = s.ht._slots[idx];
+            if (_owner)
+                delete slot.object;
+            slot.object = const_cast<Object*>(object);
+            return false;
+        }
+    }
+    s.ht.insert(const_cast<Object*>(object), h);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentHashtable::clear()
+{
+    for (size_t i = 0; i != _numShards; ++i)
+    {
+        auto& s = _shards[i];
+        RWlockLFguard guard(&s.lock, io_wr);
+        s.ht.clear();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool
+ConcurrentHashtable::remove(const Object& key)
+{
+    auto h = hash(&key);
+    auto& s = shard(h);
+    RWlockLFguard guard(&s.lock, io_wr);
+    auto idx = s.ht.findIdx(key, h);
+    if (idx == size_t_max)
+        return false;
+    s.ht.remove(idx);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentHashtable::init(size_t numShards, bool owner, bool multiSet, const HashFunction* hashfn)
+{
+    if (numShards == 0)
+        numShards = 64;
+    _numShards = nextPow2((uint64_t)numShards);
+
+    // the shard is selected by the high bits of the hash (OpenHashtable uses the low bits)
+    _shardShift = 64;
+    for (auto n = _numShards; n > 1; n >>= 1)
+        --_shardShift;
+    if (_shardShift == 64)
+        _shardShift = 0;
+    _owner = owner;
+    _multiSet = multiSet;
+    _shards = new shard_t[_numShards];
+    for (size_t i = 0; i != _numShards; ++i)
+    {
+        auto& ht = _shards[i].ht;
+        ht.setOwner(owner);
+        ht.setMultiSet(multiSet);
+        if (hashfn != nullptr)
+            ht.setHashFunction((i == 0) ? hashfn : hashfn->clone());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentHashtable::deInit()
+{
+    delete[] _shards;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// ConcurrentHashtableIt ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentHashtableIt::forward()
+{
+    ASSERTD(_shardIdx < _ht->_numShards);
+    auto& ht = _ht->_shards[_shardIdx].ht;
+    _idx = ht.nextIdx(_idx);
+    if (_idx == size_t_max)
+    {
+        _ht->_shards[_shardIdx].lock.unlock();
+        ++_shardIdx;
+        seek();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentHashtableIt::seek()
+{
+    // find the first object at or after the start of _shardIdx, holding its shard's read-lock
+    for (; _shardIdx != _ht->_numShards; ++_shardIdx)
+    {
+        auto& s = _ht->_shards[_shardIdx];
+        s.lock.rdlock();
+        _idx = s.ht.nextIdx(size_t_max);
+        if (_idx != size_t_max)
+            return;
+        s.lock.unlock();
+    }
+    _idx = size_t_max;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentHashtableIt::release()
+{
+    if ((_ht != nullptr) && (_shardIdx < _ht->_numShards))
+    {
+        _ht->_shards[_shardIdx].lock.unlock();
+        _shardIdx = _ht->_numShards;
+        _idx = size_t_max;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_CLASS_IMPL(utl::ConcurrentHashtable);
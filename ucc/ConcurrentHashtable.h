@@ -0,0 +1,252 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/OpenHashtable.h>
+#include <libutl/RWlockLF.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ConcurrentHashtableIt;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// ConcurrentHashtable /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Sharded hashing collection for concurrent access.
+
+   Putting a single Mutex or RWlock around a Hashtable that is shared between many threads makes
+   every access go through the same lock (and the same cache line).  ConcurrentHashtable instead
+   splits its contents among a fixed number of <b>shards</b>, each of which is an OpenHashtable
+   guarded by its own RWlockLF.  An object's shard is chosen by the high bits of its (mixed) hash
+   code, so operations on different shards never contend with each other, and each shard is grown
+   independently as its own load factor requires.
+
+   Searching only takes a read-lock on a single shard, and RWlockLF makes that nearly free when
+   no writer is active in that shard.  add(), remove(), addOrFind() and addOrUpdate() take a
+   write-lock on a single shard, so each of them is atomic.
+
+   Iteration (see begin()) is <b>weakly consistent</b>: each shard is visited under its read-lock,
+   so the objects in a given shard are seen as they were at one moment in time, but changes made
+   to other shards while the iteration is in progress may or may not be seen.
+
+   <b>Caveats</b>
+
+   \arg find() returns a pointer to a contained object without holding any lock after it returns.
+   If other threads may remove (and thereby destroy) that object, use visit() instead.
+   \arg a thread that is iterating over the table holds a read-lock on the current shard, so it
+   must not modify the table until the iteration is finished.
+
+   \author Adam McKee
+   \ingroup collection
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ConcurrentHashtable : public Object
+{
+    UTL_CLASS_DECL(ConcurrentHashtable, Object);
+    UTL_CLASS_NO_COPY;
+    friend class ConcurrentHashtableIt;
+
+public:
+    typedef ConcurrentHashtableIt iterator;
+
+public:
+    /**
+       Constructor.
+       \param numShards number of shards (rounded up to a power of 2, 0 = default)
+       \param owner (optional : true) owner flag
+       \param multiSet (optional : false) multiSet flag
+       \param hfunc (optional) hash function
+    */
+    ConcurrentHashtable(size_t numShards,
+                        bool owner = true,
+                        bool multiSet = false,
+                        const HashFunction* hfunc = nullptr)
+    {
+        init(numShards, owner, multiSet, hfunc);
+    }
+
+    virtual size_t innerAllocatedSize() const;
+
+    virtual void censusOwned(MemoryCensus& census) const;
+
+    /** Get the number of shards. */
+    size_t
+    numShards() const
+    {
+        return _numShards;
+    }
+
+    /** Get the owner flag. */
+    bool
+    isOwner() const
+    {
+        return _owner;
+    }
+
+    /** Get the multiSet flag. */
+    bool
+    isMultiSet() const
+    {
+        return _multiSet;
+    }
+
+    /**
+       Determine the number of contained objects.  If other threads are modifying the table, the
+       result is only a snapshot of a moving target.
+    */
+    size_t items() const;
+
+    /** Determine whether the table is empty. */
+    bool
+    empty() const
+    {
+        return (items() == 0);
+    }
+
+    /**
+       Grow the table to a size large enough to contain the given number of objects (assuming an
+       even distribution among shards).
+    */
+    void reserve(size_t newSize);
+
+    /// \name Searching
+    //@{
+    /** Search for the given key, return the matching object (nullptr if none). */
+    Object* find(const Object& key) const;
+
+    /** Determine whether a matching object is present. */
+    bool
+    has(const Object& key) const
+    {
+        return (find(key) != nullptr);
+    }
+
+    /**
+       Search for the given key, and if a matching object is found, call the given function with
+       it while holding a read-lock on its shard.
+       \return true if a matching object was found
+    */
+    template <typename Function>
+    bool visit(const Object& key, Function fn) const;
+    //@}
+
+    /// \name Adding Objects
+    //@{
+    /** Add a copy of the given object (if isOwner()), or the object itself. */
+    bool
+    add(const Object& object)
+    {
+        return add(isOwner() ? object.clone() : &object);
+    }
+
+    /**
+       Add an object.
+       \return true if the object was added, false otherwise
+       \param object object to add
+    */
+    bool add(const Object* object);
+
+    /**
+       Atomically search for a matching object, and add the given object if none was found.  If a
+       matching object is found, the given object is destroyed if isOwner().
+       \return matching object (or the given object, if it was added)
+       \param object object to add
+    */
+    Object* addOrFind(const Object* object);
+
+    /**
+       Atomically add the given object, replacing (and destroying if isOwner()) a matching object
+       if one is present.
+       \return true if there was no matching object, false if one was replaced
+       \param object object to add
+    */
+    bool addOrUpdate(const Object* object);
+    //@}
+
+    /// \name Removing Objects
+    //@{
+    /** Remove all objects. */
+    void clear();
+
+    /**
+       Remove the object matching the given key.
+       \return true if an object was removed, false otherwise
+    */
+    bool remove(const Object& key);
+    //@}
+
+    /// \name Iterators
+    //@{
+    /** Return a (weakly consistent) iterator positioned at the first object. */
+    inline iterator begin() const;
+
+    /** Return an iterator positioned at the end. */
+    inline iterator end() const;
+    //@}
+
+private:
+    // RWlockLF is padded to cache-line size, which also keeps neighbouring shards apart
+    struct shard_t
+    {
+        mutable RWlockLF lock;
+        OpenHashtable ht;
+    };
+
+private:
+    void init(size_t numShards = 0,
+              bool owner = true,
+              bool multiSet = false,
+              const HashFunction* hashfn = nullptr);
+    void deInit();
+
+    size_t
+    hash(const Object* object) const
+    {
+        return _shards[0].ht.hash(object);
+    }
+
+    shard_t&
+    shard(size_t h) const
+    {
+        return _shards[(h >> _shardShift) & (_numShards - 1)];
+    }
+
+private:
+    shard_t* _shards;
+    size_t _numShards;
+    uint_t _shardShift;
+    bool _owner;
+    bool _multiSet;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Function>
+bool
+ConcurrentHashtable::visit(const Object& key, Function fn) const
+{
+    auto h = hash(&key);
+    auto& s = shard(h);
+    RWlockLFguard guard(&s.lock, io_rd);
+    auto idx = s.ht.findIdx(key, h);
+    if (idx == size_t_max)
+        return false;
+    fn(s.ht._slots[idx].object);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/ConcurrentHashtableIt.h>
@@ -0,0 +1,130 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Weakly consistent ConcurrentHashtable iterator.
+
+   While it's positioned at an object, the iterator holds a read-lock on that object's shard, so
+   the contents of the shard can't change under it.  The lock is released when the iterator moves
+   to the next shard, when release() is called, or when the iterator is destroyed.  Iterators can
+   be moved but not copied.
+
+   \author Adam McKee
+   \ingroup collection
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ConcurrentHashtableIt
+{
+public:
+    /**
+       Constructor.
+       \param ht associated ConcurrentHashtable
+       \param shardIdx index of the first shard to visit
+    */
+    ConcurrentHashtableIt(const ConcurrentHashtable* ht, size_t shardIdx)
+        : _ht(ht)
+        , _shardIdx(shardIdx)
+        , _idx(size_t_max)
+    {
+        seek();
+    }
+
+    /** Move constructor. */
+    ConcurrentHashtableIt(ConcurrentHashtableIt&& rhs) noexcept
+        : _ht(rhs._ht)
+        , _shardIdx(rhs._shardIdx)
+        , _idx(rhs._idx)
+    {
+        rhs._ht = nullptr;
+    }
+
+    ConcurrentHashtableIt(const ConcurrentHashtableIt&) = delete;
+
+    ConcurrentHashtableIt& operator=(const ConcurrentHashtableIt&) = delete;
+
+    /** Destructor. */
+    ~ConcurrentHashtableIt()
+    {
+        release();
+    }
+
+    /** Get the current object (nullptr at end). */
+    Object*
+    get() const
+    {
+        return (_idx == size_t_max) ? nullptr : _ht->_shards[_shardIdx].ht._slots[_idx].object;
+    }
+
+    /** At end? */
+    bool
+    isEnd() const
+    {
+        return (_idx == size_t_max);
+    }
+
+    /** Move to the next object. */
+    void forward();
+
+    /** Release the held read-lock and move to the end. */
+    void release();
+
+    Object*
+    operator*() const
+    {
+        return get();
+    }
+
+    ConcurrentHashtableIt&
+    operator++()
+    {
+        forward();
+        return *this;
+    }
+
+    bool
+    operator==(const ConcurrentHashtableIt& rhs) const
+    {
+        return (_idx == rhs._idx) && (isEnd() || (_shardIdx == rhs._shardIdx));
+    }
+
+    bool
+    operator!=(const ConcurrentHashtableIt& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+private:
+    void seek();
+
+private:
+    const ConcurrentHashtable* _ht;
+    size_t _shardIdx;
+    size_t _idx;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ConcurrentHashtableIt
+ConcurrentHashtable::begin() const
+{
+    return ConcurrentHashtableIt(this, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ConcurrentHashtableIt
+ConcurrentHashtable::end() const
+{
+    return ConcurrentHashtableIt(this, _numShards);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
@@ -2,12 +2,37 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <libutl/Futex.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 UTL_NS_BEGIN;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
-   Thread-safe queue structure.
+   Thread-safe queue structure (lock-free, multi-producer, multi-consumer).
+
+   Values are stored in a linked list of fixed-size <b>segments</b>, so there is no memory
+   allocation per queued value.  Producers claim slots in the tail segment with an atomic
+   fetch-and-add on its enqueue index, and consumers claim slots in the head segment the same way
+   on its dequeue index, so producers and consumers never wait for each other.  If a consumer gets
+   to a slot before the producer that claimed it has stored its value there, the consumer marks
+   the slot as taken and moves on, and the producer retries with a new slot.
+
+   A segment that consumers have finished with is unlinked, but other threads may still be looking
+   at it, so it's only freed after every operation that was in progress at the time has
+   completed.  Each operation registers itself in one of two counters (chosen by the low bit of a
+   global epoch number), and a retired segment is freed once the epoch has advanced twice past the
+   one it was retired in.  The counters are striped across cache lines to keep unrelated threads
+   from contending for them.
+
+   Values from a single producer are dequeued in the order they were queued.  The batch
+   operations (enQ(begin, end) and deQ(values, max)) claim a range of slots with one atomic
+   operation.
+
+   A queue that is constructed with the blocking flag also supports deQwait(), which puts the
+   calling thread to sleep (on a Futex) while the queue is empty.
 
    \author Adam McKee
    \ingroup collection
@@ -19,59 +44,163 @@ template <typename T>
 class ConcurrentQueue
 {
 public:
-    /** Constructor */
-    ConcurrentQueue();
+    /**
+       Constructor.
+       \param blocking (optional : false) support deQwait()?
+    */
+    ConcurrentQueue(bool blocking = false);
 
     /** Destructor. */
     ~ConcurrentQueue();
 
     /** Queue an object. */
-    void enQ(T value);
+    void
+    enQ(T value)
+    {
+        enQ(&value, &value + 1);
+    }
+
+    /**
+       Queue a sequence of objects.
+       \param begin start of sequence (forward iterator)
+       \param end end of sequence
+    */
+    template <typename FwdIt>
+    void enQ(FwdIt begin, FwdIt end);
 
     /** Dequeue an object. */
-    bool deQ(T& value);
+    bool
+    deQ(T& value)
+    {
+        return (deQ(&value, 1) != 0);
+    }
+
+    /**
+       Dequeue up to \b max objects.
+       \return number of objects copied into \b values
+       \param values target array
+       \param max maximum number of objects to dequeue
+    */
+    size_t deQ(T* values, size_t max);
+
+    /**
+       Dequeue an object, waiting for one to arrive if the queue is empty.  The queue must have
+       been constructed with the blocking flag.
+       \return true iff an object was dequeued (false if the timeout expired)
+       \param value target instance of T
+       \param msec (optional : uint_t_max) timeout in milliseconds (uint_t_max = wait forever)
+    */
+    bool deQwait(T& value, uint_t msec = uint_t_max);
+
+    /** Determine whether the queue is (momentarily) empty. */
+    bool empty() const;
 
     /** Execute the given function on each contained item (not thread-safe!). */
     void forEach(std::function<void(T)> f) const;
 
 private:
-    struct Node
+    static constexpr size_t segment_size = 1024;
+    static constexpr size_t num_stripes = 16;
+
+    // slot states
+    static constexpr byte_t slot_empty = 0;
+    static constexpr byte_t slot_full = 1;
+    static constexpr byte_t slot_taken = 2;
+
+    struct Slot
     {
-        Node()
-            : next(nullptr)
-        {
-        }
-        Node(T val)
-            : value(val)
-            , next(nullptr)
+        T*
+        ptr()
         {
+            return reinterpret_cast<T*>(&storage);
         }
 
     public:
-        T value;
-        Node* next;
+        std::atomic<byte_t> state;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    struct Segment
+    {
+        Segment();
+
+    public:
+        std::atomic_size_t deqIdx;
+        char pad0[UTL_ARCH_CACHE_LINE_SIZE - sizeof(size_t)];
+        std::atomic_size_t enqIdx;
+        char pad1[UTL_ARCH_CACHE_LINE_SIZE - sizeof(size_t)];
+        std::atomic<Segment*> next;
+        Segment* retiredNext;
+        size_t retiredEpoch;
+        Slot slots[segment_size];
     };
 
+    // per-thread counters of in-progress operations (one for each epoch parity)
+    struct Stripe
+    {
+        std::atomic_size_t active[2];
+        char pad[UTL_ARCH_CACHE_LINE_SIZE - (2 * sizeof(size_t))];
+    };
+
+private:
+    size_t enter();
+
+    void leave(size_t epoch);
+
+    void retire(Segment* seg, size_t epoch);
+
+    void reclaim();
+
+    static size_t stripeIdx();
+
 private:
     char pad0[UTL_ARCH_CACHE_LINE_SIZE];
-    Node* _head;
-    char pad1[UTL_ARCH_CACHE_LINE_SIZE - sizeof(Node*)];
-    std::atomic_bool _consumerLock;
-    char pad2[UTL_ARCH_CACHE_LINE_SIZE - sizeof(bool)];
-    Node* _tail;
-    char pad3[UTL_ARCH_CACHE_LINE_SIZE - sizeof(Node*)];
-    std::atomic_bool _producerLock;
-    char pad4[UTL_ARCH_CACHE_LINE_SIZE - sizeof(bool)];
+    std::atomic<Segment*> _head;
+    char pad1[UTL_ARCH_CACHE_LINE_SIZE - sizeof(Segment*)];
+    std::atomic<Segment*> _tail;
+    char pad2[UTL_ARCH_CACHE_LINE_SIZE - sizeof(Segment*)];
+    std::atomic_size_t _epoch;
+    std::atomic<Segment*> _retired;
+    std::atomic_bool _reclaiming;
+    bool _blocking;
+    char pad3[UTL_ARCH_CACHE_LINE_SIZE - (2 * sizeof(size_t)) - 2];
+    Stripe _stripes[num_stripes];
+    Futex _futex;
+    char pad4[UTL_ARCH_CACHE_LINE_SIZE - sizeof(Futex)];
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 template <typename T>
-ConcurrentQueue<T>::ConcurrentQueue()
-    : _consumerLock(false)
-    , _producerLock(false)
+ConcurrentQueue<T>::Segment::Segment()
+    : deqIdx(0)
+    , enqIdx(0)
+    , next(nullptr)
+    , retiredNext(nullptr)
+    , retiredEpoch(0)
 {
-    _head = _tail = new Node();
+    for (auto& slot : slots)
+    {
+        slot.state.store(slot_empty, std::memory_order_relaxed);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+ConcurrentQueue<T>::ConcurrentQueue(bool blocking)
+    : _epoch(0)
+    , _retired(nullptr)
+    , _reclaiming(false)
+    , _blocking(blocking)
+{
+    for (auto& stripe : _stripes)
+    {
+        stripe.active[0] = stripe.active[1] = 0;
+    }
+    auto seg = new Segment();
+    _head = seg;
+    _tail = seg;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -79,90 +208,314 @@ ConcurrentQueue<T>::ConcurrentQueue()
 template <typename T>
 ConcurrentQueue<T>::~ConcurrentQueue()
 {
-    while (_head != nullptr)
+    auto seg = _head.load(std::memory_order_relaxed);
+    while (seg != nullptr)
+    {
+        for (auto& slot : seg->slots)
+        {
+            if (slot.state.load(std::memory_order_relaxed) == slot_full)
+                slot.ptr()->~T();
+        }
+        auto next = seg->next.load(std::memory_order_relaxed);
+        delete seg;
+        seg = next;
+    }
+    seg = _retired.load(std::memory_order_relaxed);
+    while (seg != nullptr)
     {
-        Node* node = _head;
-        _head = node->next;
-        delete node;
+        auto next = seg->retiredNext;
+        delete seg;
+        seg = next;
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#undef new
 template <typename T>
+template <typename FwdIt>
 void
-ConcurrentQueue<T>::enQ(T value)
+ConcurrentQueue<T>::enQ(FwdIt begin, FwdIt end)
 {
-    Node* node = new Node(value);
+    size_t num = std::distance(begin, end);
+    if (num == 0)
+        return;
+    auto numQueued = num;
+    auto epoch = enter();
+    while (num != 0)
+    {
+        auto seg = _tail.load(std::memory_order_acquire);
+
+        // claim slots in the tail segment
+        auto idx = seg->enqIdx.fetch_add(num, std::memory_order_relaxed);
+        if (idx < segment_size)
+        {
+            auto lim = min(idx + num, segment_size);
+            for (; idx != lim; ++idx)
+            {
+                auto& slot = seg->slots[idx];
+                ::new (&slot.storage) T(*begin);
+                auto state = slot_empty;
+                if (!slot.state.compare_exchange_strong(state, slot_full, std::memory_order_release,
+                                                        std::memory_order_relaxed))
+                {
+                    // a consumer gave up on this slot: abandon the rest of the claim & retry
+                    slot.ptr()->~T();
+                    break;
+                }
+                ++begin;
+                --num;
+            }
+            continue;
+        }
+
+        // the tail segment is full: help move _tail forward, or append a new segment
+        if (seg != _tail.load(std::memory_order_acquire))
+            continue;
+        auto next = seg->next.load(std::memory_order_acquire);
+        if (next != nullptr)
+        {
+            _tail.compare_exchange_strong(seg, next, std::memory_order_release,
+                                          std::memory_order_relaxed);
+            continue;
+        }
+        auto newSeg = new Segment();
+        auto it = begin;
+        size_t newIdx;
+        for (newIdx = 0; (newIdx != segment_size) && (newIdx != num); ++newIdx, ++it)
+        {
+            auto& slot = newSeg->slots[newIdx];
+            ::new (&slot.storage) T(*it);
+            slot.state.store(slot_full, std::memory_order_relaxed);
+        }
+        newSeg->enqIdx.store(newIdx, std::memory_order_relaxed);
+        if (seg->next.compare_exchange_strong(next, newSeg, std::memory_order_release,
+                                              std::memory_order_relaxed))
+        {
+            _tail.compare_exchange_strong(seg, newSeg, std::memory_order_release,
+                                          std::memory_order_relaxed);
+            begin = it;
+            num -= newIdx;
+        }
+        else
+        {
+            for (size_t i = 0; i != newIdx; ++i)
+            {
+                newSeg->slots[i].ptr()->~T();
+            }
+            delete newSeg;
+        }
+    }
+    leave(epoch);
+    if (_blocking)
+        _futex.notify((numQueued == 1) ? 1 : int_t_max);
+}
+#include <libutl/gblnew_macros.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    // acquire producer lock
-    bool cur = false;
-    while (!_producerLock.compare_exchange_weak(cur, true, std::memory_order_acquire,
-                                                std::memory_order_relaxed))
+template <typename T>
+size_t
+ConcurrentQueue<T>::deQ(T* values, size_t max)
+{
+    size_t count = 0;
+    Segment* retired = nullptr;
+    auto epoch = enter();
+    while ((count == 0) && (max != 0))
     {
-        cur = false;
+        auto seg = _head.load(std::memory_order_acquire);
+        auto deqIdx = seg->deqIdx.load(std::memory_order_relaxed);
+        auto enqIdx = seg->enqIdx.load(std::memory_order_relaxed);
+        if ((deqIdx >= enqIdx) && (seg->next.load(std::memory_order_acquire) == nullptr))
+            break;
+
+        // claim slots in the head segment (but not many more than producers have claimed)
+        auto num = (enqIdx > deqIdx) ? min(max, enqIdx - deqIdx) : 1;
+        auto idx = seg->deqIdx.fetch_add(num, std::memory_order_relaxed);
+        if (idx < segment_size)
+        {
+            auto lim = min(idx + num, segment_size);
+            for (; idx != lim; ++idx)
+            {
+                auto& slot = seg->slots[idx];
+                if (slot.state.exchange(slot_taken, std::memory_order_acquire) == slot_full)
+                {
+                    values[count++] = std::move(*slot.ptr());
+                    slot.ptr()->~T();
+                }
+            }
+            continue;
+        }
+
+        // the head segment is used up: unlink it (after making sure _tail has moved past it)
+        auto next = seg->next.load(std::memory_order_acquire);
+        if (next == nullptr)
+            break;
+        auto tail = seg;
+        _tail.compare_exchange_strong(tail, next, std::memory_order_release,
+                                      std::memory_order_relaxed);
+        if (_head.compare_exchange_strong(seg, next, std::memory_order_release,
+                                          std::memory_order_relaxed))
+        {
+            retire(seg, epoch);
+            retired = seg;
+        }
     }
+    leave(epoch);
+    if (retired != nullptr)
+        reclaim();
+    return count;
+}
 
-    // link from tail, become new tail
-    _tail->next = node;
-    _tail = node;
+////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    // release producer lock
-    _producerLock.store(false, std::memory_order_release);
+template <typename T>
+bool
+ConcurrentQueue<T>::deQwait(T& value, uint_t msec)
+{
+    ASSERTD(_blocking);
+    return _futex.waitFor([this, &value]() { return deQ(value); }, msec);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 template <typename T>
 bool
-ConcurrentQueue<T>::deQ(T& value)
+ConcurrentQueue<T>::empty() const
 {
-    // acquire consumer lock
-    bool cur = false;
-    while (!_consumerLock.compare_exchange_weak(cur, true, std::memory_order_acquire,
-                                                std::memory_order_relaxed))
+    auto seg = _head.load(std::memory_order_acquire);
+    return (seg->deqIdx.load(std::memory_order_relaxed) >=
+            seg->enqIdx.load(std::memory_order_relaxed)) &&
+           (seg->next.load(std::memory_order_acquire) == nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void
+ConcurrentQueue<T>::forEach(std::function<void(T)> func) const
+{
+    for (auto seg = _head.load(std::memory_order_acquire); seg != nullptr;
+         seg = seg->next.load(std::memory_order_acquire))
     {
-        cur = false;
+        for (auto& slot : seg->slots)
+        {
+            if (slot.state.load(std::memory_order_acquire) == slot_full)
+                func(*const_cast<Slot&>(slot).ptr());
+        }
     }
+}
 
-    // remember head and its next
-    Node* head = _head;
-    Node* next = _head->next;
+////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    // empty?
-    if (next == nullptr)
+template <typename T>
+size_t
+ConcurrentQueue<T>::enter()
+{
+    auto& stripe = _stripes[stripeIdx()];
+    while (true)
     {
-        _consumerLock.store(false, std::memory_order_relaxed);
-        return false;
+        auto epoch = _epoch.load(std::memory_order_seq_cst);
+        auto& active = stripe.active[epoch & 1];
+        active.fetch_add(1, std::memory_order_seq_cst);
+        if (_epoch.load(std::memory_order_seq_cst) == epoch)
+            return epoch;
+        active.fetch_sub(1, std::memory_order_relaxed);
     }
+}
 
-    // copy value, and advance _head
-    value = next->value;
-    _head = next;
+////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    // release consumer lock
-    _consumerLock.store(false, std::memory_order_release);
+template <typename T>
+void
+ConcurrentQueue<T>::leave(size_t epoch)
+{
+    _stripes[stripeIdx()].active[epoch & 1].fetch_sub(1, std::memory_order_release);
+}
 
-    // clean up the old head
-    delete head;
+////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    return true;
+template <typename T>
+void
+ConcurrentQueue<T>::retire(Segment* seg, size_t epoch)
+{
+    seg->retiredEpoch = epoch;
+    auto head = _retired.load(std::memory_order_relaxed);
+    do
+    {
+        seg->retiredNext = head;
+    } while (!_retired.compare_exchange_weak(head, seg, std::memory_order_release,
+                                             std::memory_order_relaxed));
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 template <typename T>
 void
-ConcurrentQueue<T>::forEach(std::function<void(T)> func) const
+ConcurrentQueue<T>::reclaim()
 {
-    Node* node = _head;
-    while (true)
+    // only one thread reclaims at a time
+    if (_reclaiming.exchange(true, std::memory_order_acquire))
+        return;
+
+    // All operations from epochs before the previous one have completed (that was checked before
+    // the epoch was last advanced).  If the previous epoch's operations have also completed, the
+    // epoch can advance again.  A segment can be freed when no operation from its epoch or
+    // the following one is still in progress.
+    auto epoch = _epoch.load(std::memory_order_seq_cst);
+    size_t active = 0;
+    for (auto& stripe : _stripes)
     {
-        node = node->next;
-        if (node == nullptr)
-            break;
-        func(node->value);
+        active += stripe.active[(epoch - 1) & 1].load(std::memory_order_seq_cst);
+    }
+    size_t minAge = 3;
+    if (active == 0)
+    {
+        _epoch.store(epoch + 1, std::memory_order_seq_cst);
+        minAge = 2;
     }
+
+    // free old-enough segments, put the rest back
+    auto seg = _retired.exchange(nullptr, std::memory_order_acquire);
+    Segment* keepHead = nullptr;
+    Segment* keepTail = nullptr;
+    while (seg != nullptr)
+    {
+        auto next = seg->retiredNext;
+        if ((seg->retiredEpoch + minAge) <= epoch)
+        {
+            delete seg;
+        }
+        else
+        {
+            seg->retiredNext = keepHead;
+            keepHead = seg;
+            if (keepTail == nullptr)
+                keepTail = seg;
+        }
+        seg = next;
+    }
+    if (keepHead != nullptr)
+    {
+        auto head = _retired.load(std::memory_order_relaxed);
+        do
+        {
+            keepTail->retiredNext = head;
+        } while (!_retired.compare_exchange_weak(head, keepHead, std::memory_order_release,
+                                                 std::memory_order_relaxed));
+    }
+    _reclaiming.store(false, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+size_t
+ConcurrentQueue<T>::stripeIdx()
+{
+    static std::atomic_size_t nextIdx(0);
+    static thread_local size_t idx = nextIdx.fetch_add(1, std::memory_order_relaxed) % num_stripes;
+    return idx;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,521 @@
+#include <libutl/libutl.h>
+#include <libutl/ConcurrentSkipList.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// ConcurrentSkipList //////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+ConcurrentSkipList::innerAllocatedSize() const
+{
+    size_t stripe;
+    auto epoch = enter(stripe);
+    size_t sz = sizeof(node_t) + (_maxLevel * sizeof(std::atomic<uintptr_t>));
+    for (auto node = nextNode(_head); node != nullptr; node = nextNode(node))
+    {
+        sz += sizeof(node_t) + (node->level * sizeof(std::atomic<uintptr_t>));
+    }
+    leave(epoch, stripe);
+    return sz;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Object*
+ConcurrentSkipList::find(const Object& key) const
+{
+    size_t stripe;
+    auto epoch = enter(stripe);
+    auto node = findFirst(key);
+    Object* res = nullptr;
+    if ((node != nullptr) && (compareObjects(node->object, &key) == 0))
+        res = node->object;
+    leave(epoch, stripe);
+    return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Object*
+ConcurrentSkipList::addOrFind(const Object* object)
+{
+    ASSERTD(object != nullptr);
+    ASSERTD(_maxLevel < 32);
+    node_t* preds[32];
+    node_t* succs[32];
+    node_t* node = nullptr;
+    Object* res = nullptr;
+    size_t stripe;
+    auto epoch = enter(stripe);
+
+    // link the new node into the bottom level (which makes it present)
+    while (true)
+    {
+        if (findNode(*object, preds, succs))
+        {
+            res = succs[0]->object;
+            break;
+        }
+        if (node == nullptr)
+            node = newNode(object, randomLevel());
+        for (uint_t lvl = 0; lvl <= node->level; ++lvl)
+        {
+            node->next[lvl].store(reinterpret_cast<uintptr_t>(succs[lvl]),
+                                  std::memory_order_relaxed);
+        }
+        auto expected = reinterpret_cast<uintptr_t>(succs[0]);
+        if (preds[0]->next[0].compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(node),
+                                                      std::memory_order_release,
+                                                      std::memory_order_relaxed))
+        {
+            break;
+        }
+    }
+
+    // a matching object was found?
+    if (res != nullptr)
+    {
+        leave(epoch, stripe);
+        if (node != nullptr)
+            freeNode(node);
+        if (isOwner())
+            delete object;
+        return res;
+    }
+    _items.fetch_add(1, std::memory_order_relaxed);
+
+    // link the node into the higher levels (stopping if it's removed in the meantime)
+    for (uint_t lvl = 1; lvl <= node->level; ++lvl)
+    {
+        while (true)
+        {
+            // make the node's link point to the successor (unless the link has been marked)
+            auto succ = reinterpret_cast<uintptr_t>(succs[lvl]);
+            auto link = node->next[lvl].load(std::memory_order_acquire);
+            if ((link != succ) &&
+                (isMarked(link) ||
+                 !node->next[lvl].compare_exchange_strong(link, succ, std::memory_order_release,
+                                                          std::memory_order_relaxed)))
+            {
+                lvl = node->level;
+                break;
+            }
+            if (preds[lvl]->next[lvl].compare_exchange_strong(
+                    succ, reinterpret_cast<uintptr_t>(node), std::memory_order_release,
+                    std::memory_order_relaxed))
+            {
+                break;
+            }
+            if (!findNode(*object, preds, succs) || (succs[0] != node))
+            {
+                lvl = node->level;
+                break;
+            }
+        }
+    }
+
+    // if the node was removed while we were linking it, make sure it's unlinked from every level
+    if (isMarked(node->next[0].load(std::memory_order_acquire)))
+        findNode(*object, preds, succs);
+    leave(epoch, stripe);
+    release(node);
+    return const_cast<Object*>(object);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentSkipList::clear()
+{
+    // free the contained objects
+    auto node = ptr(_head->next[0].load(std::memory_order_acquire));
+    while (node != nullptr)
+    {
+        auto next = ptr(node->next[0].load(std::memory_order_relaxed));
+        if (isOwner())
+            delete node->object;
+        freeNode(node);
+        node = next;
+    }
+    for (uint_t lvl = 0; lvl <= _maxLevel; ++lvl)
+    {
+        _head->next[lvl].store(0, std::memory_order_relaxed);
+    }
+    _items.store(0, std::memory_order_relaxed);
+
+    // free the removed objects
+    node = _retired.exchange(nullptr, std::memory_order_acquire);
+    while (node != nullptr)
+    {
+        auto next = node->retiredNext;
+        if (isOwner())
+            delete node->object;
+        freeNode(node);
+        node = next;
+    }
+    _numRetired.store(0, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool
+ConcurrentSkipList::remove(const Object& key)
+{
+    ASSERTD(_maxLevel < 32);
+    node_t* preds[32];
+    node_t* succs[32];
+    node_t* node = nullptr;
+    size_t stripe;
+    auto epoch = enter(stripe);
+    if (findNode(key, preds, succs))
+    {
+        // mark the node's links from the top down (whoever marks the bottom link removes it)
+        auto candidate = succs[0];
+        for (uint_t lvl = candidate->level; lvl != 0; --lvl)
+        {
+            candidate->next[lvl].fetch_or(1, std::memory_order_acq_rel);
+        }
+        if (!isMarked(candidate->next[0].fetch_or(1, std::memory_order_acq_rel)))
+        {
+            node = candidate;
+            _items.fetch_sub(1, std::memory_order_relaxed);
+
+            // unlink it from every level
+            findNode(key, preds, succs);
+        }
+    }
+    leave(epoch, stripe);
+    if (node == nullptr)
+        return false;
+    release(node);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentSkipList::init(bool owner, Ordering* ordering, uint_t maxLevel)
+{
+    ASSERTD(maxLevel < 32);
+    _owner = owner;
+    _ordering = ordering;
+    _maxLevel = maxLevel;
+    _head = newNode(nullptr, _maxLevel);
+    _items = 0;
+    _epoch = 0;
+    _retired = nullptr;
+    _numRetired = 0;
+    _reclaiming = false;
+    for (auto& stripe : _stripes)
+    {
+        stripe.active[0] = stripe.active[1] = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentSkipList::deInit()
+{
+    clear();
+    freeNode(_head);
+    delete _ordering;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ConcurrentSkipList::node_t*
+ConcurrentSkipList::newNode(const Object* object, uint_t level)
+{
+    size_t size = sizeof(node_t) + (level * sizeof(std::atomic<uintptr_t>));
+    auto node = reinterpret_cast<node_t*>(new byte_t[size]);
+    node->object = const_cast<Object*>(object);
+    node->retiredNext = nullptr;
+    node->retiredEpoch = 0;
+    node->refs.store(2, std::memory_order_relaxed);
+    node->level = level;
+    for (uint_t lvl = 0; lvl <= level; ++lvl)
+    {
+        node->next[lvl].store(0, std::memory_order_relaxed);
+    }
+    return node;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentSkipList::freeNode(node_t* node)
+{
+    delete[] reinterpret_cast<byte_t*>(node);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint_t
+ConcurrentSkipList::randomLevel()
+{
+    // per-thread xorshift generator: each level is half as likely as the one below it
+    static std::atomic<uint64_t> nextSeed(0x9e3779b97f4a7c15ULL);
+    static thread_local uint64_t state =
+        nextSeed.fetch_add(0x9e3779b97f4a7c15ULL, std::memory_order_relaxed) | 1;
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    uint64_t bits = state * 0x2545f4914f6cdd1dULL;
+    uint_t level = 0;
+    while ((bits & 1) && (level < _maxLevel))
+    {
+        bits >>= 1;
+        ++level;
+    }
+    return level;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool
+ConcurrentSkipList::findNode(const Object& key, node_t** preds, node_t** succs)
+{
+    // For each level, find the last node < key and the first node >= key, unlinking marked
+    // nodes along the way.  If an unlink fails, start over.
+    bool retry;
+    do
+    {
+        retry = false;
+        node_t* pred = _head;
+        for (uint_t lvl = _maxLevel; (lvl != uint_t_max) && !retry; --lvl)
+        {
+            auto curr = ptr(pred->next[lvl].load(std::memory_order_acquire));
+            while (curr != nullptr)
+            {
+                auto succ = curr->next[lvl].load(std::memory_order_acquire);
+                if (isMarked(succ))
+                {
+                    auto expected = reinterpret_cast<uintptr_t>(curr);
+                    if (!pred->next[lvl].compare_exchange_strong(
+                            expected, succ & ~uintptr_t(1), std::memory_order_acq_rel,
+                            std::memory_order_relaxed))
+                    {
+                        retry = true;
+                        break;
+                    }
+                    curr = ptr(succ);
+                    continue;
+                }
+                if (compareObjects(curr->object, &key) >= 0)
+                    break;
+                pred = curr;
+                curr = ptr(succ);
+            }
+            preds[lvl] = pred;
+            succs[lvl] = curr;
+        }
+    } while (retry);
+    return (succs[0] != nullptr) && (compareObjects(succs[0]->object, &key) == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ConcurrentSkipList::node_t*
+ConcurrentSkipList::findFirst(const Object& key) const
+{
+    // like findNode(), but marked nodes are stepped over instead of unlinked
+    node_t* pred = _head;
+    node_t* curr = nullptr;
+    for (uint_t lvl = _maxLevel; lvl != uint_t_max; --lvl)
+    {
+        curr = ptr(pred->next[lvl].load(std::memory_order_acquire));
+        while (curr != nullptr)
+        {
+            auto succ = curr->next[lvl].load(std::memory_order_acquire);
+            if (!isMarked(succ))
+            {
+                if (compareObjects(curr->object, &key) >= 0)
+                    break;
+                pred = curr;
+            }
+            curr = ptr(succ);
+        }
+    }
+    return curr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ConcurrentSkipList::node_t*
+ConcurrentSkipList::nextNode(node_t* node) const
+{
+    auto next = ptr(node->next[0].load(std::memory_order_acquire));
+    while ((next != nullptr) && isMarked(next->next[0].load(std::memory_order_acquire)))
+    {
+        next = ptr(next->next[0].load(std::memory_order_acquire));
+    }
+    return next;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentSkipList::release(node_t* node)
+{
+    // retire the node when both add() and remove() are done with it
+    if (node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+    node->retiredEpoch = _epoch.load(std::memory_order_seq_cst);
+    auto head = _retired.load(std::memory_order_relaxed);
+    do
+    {
+        node->retiredNext = head;
+    } while (!_retired.compare_exchange_weak(head, node, std::memory_order_release,
+                                             std::memory_order_relaxed));
+    if ((_numRetired.fetch_add(1, std::memory_order_relaxed) % 64) == 63)
+        reclaim();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+ConcurrentSkipList::enter(size_t& stripe) const
+{
+    stripe = stripeIdx();
+    auto& s = _stripes[stripe];
+    while (true)
+    {
+        auto epoch = _epoch.load(std::memory_order_seq_cst);
+        auto& active = s.active[epoch & 1];
+        active.fetch_add(1, std::memory_order_seq_cst);
+        if (_epoch.load(std::memory_order_seq_cst) == epoch)
+            return epoch;
+        active.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentSkipList::leave(size_t epoch, size_t stripe) const
+{
+    _stripes[stripe].active[epoch & 1].fetch_sub(1, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentSkipList::reclaim()
+{
+    // only one thread reclaims at a time
+    if (_reclaiming.exchange(true, std::memory_order_acquire))
+        return;
+
+    // advance the epoch if the previous epoch's operations have completed (see ConcurrentQueue)
+    auto epoch = _epoch.load(std::memory_order_seq_cst);
+    size_t active = 0;
+    for (auto& stripe : _stripes)
+    {
+        active += stripe.active[(epoch - 1) & 1].load(std::memory_order_seq_cst);
+    }
+    size_t minAge = 3;
+    if (active == 0)
+    {
+        _epoch.store(epoch + 1, std::memory_order_seq_cst);
+        minAge = 2;
+    }
+
+    // free old-enough nodes, put the rest back
+    auto node = _retired.exchange(nullptr, std::memory_order_acquire);
+    node_t* keepHead = nullptr;
+    node_t* keepTail = nullptr;
+    while (node != nullptr)
+    {
+        auto next = node->retiredNext;
+        if ((node->retiredEpoch + minAge) <= epoch)
+        {
+            if (isOwner())
+                delete node->object;
+            freeNode(node);
+            _numRetired.fetch_sub(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            node->retiredNext = keepHead;
+            keepHead = node;
+            if (keepTail == nullptr)
+                keepTail = node;
+        }
+        node = next;
+    }
+    if (keepHead != nullptr)
+    {
+        auto head = _retired.load(std::memory_order_relaxed);
+        do
+        {
+            keepTail->retiredNext = head;
+        } while (!_retired.compare_exchange_weak(head, keepHead, std::memory_order_release,
+                                                 std::memory_order_relaxed));
+    }
+    _reclaiming.store(false, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+ConcurrentSkipList::stripeIdx()
+{
+    static std::atomic_size_t nextIdx(0);
+    static thread_local size_t idx = nextIdx.fetch_add(1, std::memory_order_relaxed) % num_stripes;
+    return idx;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// ConcurrentSkipListIt ////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ConcurrentSkipListIt::ConcurrentSkipListIt(const ConcurrentSkipList* list, const Object* key)
+    : _list(list)
+    , _node(nullptr)
+    , _epoch(0)
+    , _stripeIdx(0)
+{
+    if (_list == nullptr)
+        return;
+    _epoch = _list->enter(_stripeIdx);
+    _node = (key == nullptr) ? _list->nextNode(_list->_head) : _list->findFirst(*key);
+    if (_node == nullptr)
+        release();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentSkipListIt::forward()
+{
+    ASSERTD(_node != nullptr);
+    _node = _list->nextNode(_node);
+    if (_node == nullptr)
+        release();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ConcurrentSkipListIt::release()
+{
+    if (_list != nullptr)
+    {
+        _list->leave(_epoch, _stripeIdx);
+        _list = nullptr;
+    }
+    _node = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_CLASS_IMPL(utl::ConcurrentSkipList);
@@ -0,0 +1,294 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/Ordering.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ConcurrentSkipListIt;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// ConcurrentSkipList //////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Lock-free sorted collection for concurrent access.
+
+   ConcurrentSkipList is an ordered set of objects that many threads can search, add to, remove
+   from and iterate over at the same time, without any locks.  Like SkipList, it's made of
+   linked lists at several levels, where each node's level is chosen at random.  All links are
+   updated with compare-and-swap:
+
+   \arg add() links the new node into the bottom level first (at which point it's present), then
+   into the higher levels.
+   \arg remove() <b>marks</b> the node's links (setting the low bit of each pointer), from the top
+   level down.  Marking the bottom-level link is what removes the object, and it can only be done
+   once, by one thread.  Any thread that comes across a marked node while searching unlinks it.
+
+   A removed node may still be seen by other threads that were looking at it at the time, so it's
+   only freed (along with its object, if isOwner()) once every operation that was in progress
+   when it was unlinked has completed.  Each operation (and each iterator) registers itself in
+   one of two counters chosen by the low bit of a global epoch number, as in ConcurrentQueue.
+
+   Iterators (see begin() and findFirstIt()) are <b>weakly consistent</b>: they never see a node
+   that has been freed, and they skip objects that have been removed, but objects added or
+   removed during the iteration may or may not be seen.  An iterator keeps its epoch open while it
+   exists, which delays the freeing of removed nodes, so long-lived iterators should be
+   release()d when they're no longer needed.
+
+   Duplicate keys are not supported (there is no \b multiSet flag).
+
+   <b>Caveats</b>
+
+   \arg find() returns a pointer to a contained object after the search is finished.  If other
+   threads may remove that object (and isOwner()), use visit() or an iterator instead.
+   \arg clear() and the destructor are not thread-safe.
+
+   \author Adam McKee
+   \ingroup collection
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ConcurrentSkipList : public Object
+{
+    UTL_CLASS_DECL(ConcurrentSkipList, Object);
+    UTL_CLASS_NO_COPY;
+    friend class ConcurrentSkipListIt;
+
+public:
+    typedef ConcurrentSkipListIt iterator;
+
+public:
+    /**
+       Constructor.
+       \param owner \b owner flag
+       \param ordering (optional) ordering
+       \param maxLevel (optional : 19) number of levels minus one (see SkipList)
+    */
+    ConcurrentSkipList(bool owner, Ordering* ordering = nullptr, uint_t maxLevel = 19)
+    {
+        init(owner, ordering, maxLevel);
+    }
+
+    virtual size_t innerAllocatedSize() const;
+
+    /** Get the owner flag. */
+    bool
+    isOwner() const
+    {
+        return _owner;
+    }
+
+    /** Get the ordering (nullptr if objects are compared directly). */
+    const Ordering*
+    ordering() const
+    {
+        return _ordering;
+    }
+
+    /**
+       Determine the number of contained objects.  If other threads are modifying the list, the
+       result is only a snapshot of a moving target.
+    */
+    size_t
+    items() const
+    {
+        return _items.load(std::memory_order_relaxed);
+    }
+
+    /** Determine whether the list is empty. */
+    bool
+    empty() const
+    {
+        return (items() == 0);
+    }
+
+    /// \name Searching
+    //@{
+    /** Search for the given key, return the matching object (nullptr if none). */
+    Object* find(const Object& key) const;
+
+    /** Determine whether a matching object is present. */
+    bool
+    has(const Object& key) const
+    {
+        return (find(key) != nullptr);
+    }
+
+    /**
+       Search for the given key, and if a matching object is found, call the given function with
+       it (the object won't be destroyed before the function returns).
+       \return true if a matching object was found
+    */
+    template <typename Function>
+    bool visit(const Object& key, Function fn) const;
+
+    /** Return an iterator positioned at the first object that is >= the given key. */
+    inline iterator findFirstIt(const Object& key) const;
+    //@}
+
+    /// \name Adding Objects
+    //@{
+    /** Add a copy of the given object (if isOwner()), or the object itself. */
+    bool
+    add(const Object& object)
+    {
+        return add(isOwner() ? object.clone() : &object);
+    }
+
+    /**
+       Add an object.  If a matching object is already present, the given object is not added
+       (and it's destroyed if isOwner()).
+       \return true if the object was added, false otherwise
+       \param object object to add
+    */
+    bool
+    add(const Object* object)
+    {
+        return (addOrFind(object) == object);
+    }
+
+    /**
+       Atomically search for a matching object, and add the given object if none was found.  If a
+       matching object is found, the given object is destroyed if isOwner().
+       \return matching object (or the given object, if it was added)
+       \param object object to add
+    */
+    Object* addOrFind(const Object* object);
+    //@}
+
+    /// \name Removing Objects
+    //@{
+    /** Remove all objects (not thread-safe!). */
+    void clear();
+
+    /**
+       Remove the object matching the given key.
+       \return true if an object was removed, false otherwise
+    */
+    bool remove(const Object& key);
+    //@}
+
+    /// \name Iterators
+    //@{
+    /** Return a (weakly consistent) iterator positioned at the first object. */
+    inline iterator begin() const;
+
+    /** Return an iterator positioned at the end. */
+    inline iterator end() const;
+    //@}
+
+private:
+    static constexpr size_t num_stripes = 16;
+
+    struct node_t
+    {
+        Object* object;
+        node_t* retiredNext;
+        size_t retiredEpoch;
+        std::atomic_uint refs; // add() and remove() both release the node
+        uint_t level;
+        std::atomic<uintptr_t> next[1]; // [level + 1] links (low bit = marked)
+    };
+
+    // per-thread counters of in-progress operations (one for each epoch parity)
+    struct Stripe
+    {
+        std::atomic_size_t active[2];
+        char pad[UTL_ARCH_CACHE_LINE_SIZE - (2 * sizeof(size_t))];
+    };
+
+private:
+    void init(bool owner = true, Ordering* ordering = nullptr, uint_t maxLevel = 19);
+    void deInit();
+
+    int
+    compareObjects(const Object* lhs, const Object* rhs) const
+    {
+        return (_ordering == nullptr) ? lhs->compare(*rhs) : _ordering->cmp(lhs, rhs);
+    }
+
+    static node_t*
+    ptr(uintptr_t link)
+    {
+        return reinterpret_cast<node_t*>(link & ~uintptr_t(1));
+    }
+
+    static bool
+    isMarked(uintptr_t link)
+    {
+        return (link & 1);
+    }
+
+    node_t* newNode(const Object* object, uint_t level);
+
+    void freeNode(node_t* node);
+
+    uint_t randomLevel();
+
+    bool findNode(const Object& key, node_t** preds, node_t** succs);
+
+    node_t* findFirst(const Object& key) const;
+
+    node_t* nextNode(node_t* node) const;
+
+    void release(node_t* node);
+
+    size_t enter(size_t& stripe) const;
+
+    void leave(size_t epoch, size_t stripe) const;
+
+    void reclaim();
+
+    static size_t stripeIdx();
+
+private:
+    char pad0[UTL_ARCH_CACHE_LINE_SIZE];
+    node_t* _head;
+    Ordering* _ordering;
+    uint_t _maxLevel;
+    bool _owner;
+    std::atomic_size_t _items;
+    char pad1[UTL_ARCH_CACHE_LINE_SIZE];
+    std::atomic_size_t _epoch;
+    std::atomic<node_t*> _retired;
+    std::atomic_size_t _numRetired;
+    std::atomic_bool _reclaiming;
+    char pad2[UTL_ARCH_CACHE_LINE_SIZE - (3 * sizeof(size_t)) - 1];
+    mutable Stripe _stripes[num_stripes];
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/ConcurrentSkipListIt.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Function>
+bool
+ConcurrentSkipList::visit(const Object& key, Function fn) const
+{
+    iterator it = findFirstIt(key);
+    if (it.isEnd() || (compareObjects(it.get(), &key) != 0))
+        return false;
+    fn(it.get());
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
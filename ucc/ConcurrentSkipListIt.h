@@ -0,0 +1,132 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Weakly consistent ConcurrentSkipList iterator.
+
+   The iterator keeps its list's current epoch open, so the node it's positioned at (and the nodes
+   after it) can't be freed under it, even if their objects are removed.  Objects that have been
+   removed are skipped.  The epoch is closed when release() is called or when the iterator is
+   destroyed.  Iterators can be moved but not copied.
+
+   \author Adam McKee
+   \ingroup collection
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ConcurrentSkipListIt
+{
+public:
+    /**
+       Constructor.
+       \param list associated ConcurrentSkipList
+       \param key (optional) position at the first object >= key (nullptr = first object)
+    */
+    ConcurrentSkipListIt(const ConcurrentSkipList* list, const Object* key = nullptr);
+
+    /** Move constructor. */
+    ConcurrentSkipListIt(ConcurrentSkipListIt&& rhs) noexcept
+        : _list(rhs._list)
+        , _node(rhs._node)
+        , _epoch(rhs._epoch)
+        , _stripeIdx(rhs._stripeIdx)
+    {
+        rhs._list = nullptr;
+        rhs._node = nullptr;
+    }
+
+    ConcurrentSkipListIt(const ConcurrentSkipListIt&) = delete;
+
+    ConcurrentSkipListIt& operator=(const ConcurrentSkipListIt&) = delete;
+
+    /** Destructor. */
+    ~ConcurrentSkipListIt()
+    {
+        release();
+    }
+
+    /** Get the current object (nullptr at end). */
+    Object*
+    get() const
+    {
+        return (_node == nullptr) ? nullptr : _node->object;
+    }
+
+    /** At end? */
+    bool
+    isEnd() const
+    {
+        return (_node == nullptr);
+    }
+
+    /** Move to the next object. */
+    void forward();
+
+    /** Close the iterator's epoch and move to the end. */
+    void release();
+
+    Object*
+    operator*() const
+    {
+        return get();
+    }
+
+    ConcurrentSkipListIt&
+    operator++()
+    {
+        forward();
+        return *this;
+    }
+
+    bool
+    operator==(const ConcurrentSkipListIt& rhs) const
+    {
+        return (_node == rhs._node);
+    }
+
+    bool
+    operator!=(const ConcurrentSkipListIt& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+private:
+    const ConcurrentSkipList* _list;
+    ConcurrentSkipList::node_t* _node;
+    size_t _epoch;
+    size_t _stripeIdx;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ConcurrentSkipListIt
+ConcurrentSkipList::findFirstIt(const Object& key) const
+{
+    return ConcurrentSkipListIt(this, &key);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ConcurrentSkipListIt
+ConcurrentSkipList::begin() const
+{
+    return ConcurrentSkipListIt(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ConcurrentSkipListIt
+ConcurrentSkipList::end() const
+{
+    return ConcurrentSkipListIt(nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
@@ -16,10 +16,12 @@ Hashtable::steal(Object& rhs_)
     deInit();
     super::steal(rhs);
     _hashfn = rhs._hashfn;
+    _nodePool = rhs._nodePool;
     _limit = rhs._limit;
     _maxLF = rhs._maxLF;
     _array.steal(rhs._array);
     rhs._hashfn = nullptr;
+    rhs._nodePool = nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -45,8 +47,10 @@ Hashtable::innerAllocatedSize() const
     sz += _array.innerAllocatedSize();
 
     // add space for ListNodes
+    if (_nodePool != nullptr)
+        sz += sizeof(NodePool) + _nodePool->innerAllocatedSize();
     size_t i;
-    for (i = 0; i != _array.size(); ++i)
+    for (i = 0; (_nodePool == nullptr) && (i != _array.size()); ++i)
     {
         if (!isHead(i))
             continue;
@@ -84,6 +88,25 @@ Hashtable::reserve(size_t reqSize)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+Hashtable::setNodePool(bool nodePool)
+{
+    ASSERTD(empty());
+    if (nodePool == hasNodePool())
+        return;
+    if (nodePool)
+    {
+        _nodePool = new NodePool(sizeof(ListNode));
+    }
+    else
+    {
+        delete _nodePool;
+        _nodePool = nullptr;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 Object*
 Hashtable::find(const Object& key) const
 {
@@ -165,8 +188,8 @@ Hashtable::add(const Object* object)
                 return false;
             }
             // single object -> list
-            auto head = new ListNode(tableObj);
-            list_add(head, nullptr, object, true, ordering());
+            auto head = list_newNode(tableObj, _nodePool);
+            list_add(head, nullptr, object, true, ordering(), _nodePool);
             setHead(idx, head);
         }
     }
@@ -182,7 +205,7 @@ Hashtable::add(const Object* object)
                 delete object;
             return false;
         }
-        auto newNode = new ListNode(object);
+        auto newNode = list_newNode(object, _nodePool);
         if (cmpRes < 0)
         {
             newNode->addAfter(node);
@@ -231,8 +254,8 @@ Hashtable::addOrFind(const Object* object)
                 return tableObj;
             }
             // single object -> list
-            auto head = new ListNode(tableObj);
-            list_add(head, nullptr, object, true, ordering());
+            auto head = list_newNode(tableObj, _nodePool);
+            list_add(head, nullptr, object, true, ordering(), _nodePool);
             setHead(idx, head);
         }
     }
@@ -248,7 +271,7 @@ Hashtable::addOrFind(const Object* object)
                 delete object;
             return node->get();
         }
-        auto newNode = new ListNode(object);
+        auto newNode = list_newNode(object, _nodePool);
         if (cmpRes < 0)
         {
             newNode->addAfter(node);
@@ -297,8 +320,8 @@ Hashtable::addOrUpdate(const Object* object)
                 return false;
             }
             // single object -> list
-            auto head = new ListNode(tableObj);
-            list_add(head, nullptr, object, true, ordering());
+            auto head = list_newNode(tableObj, _nodePool);
+            list_add(head, nullptr, object, true, ordering(), _nodePool);
             setHead(idx, head);
         }
     }
@@ -315,7 +338,7 @@ Hashtable::addOrUpdate(const Object* object)
             node->set(object);
             return false;
         }
-        auto newNode = new ListNode(object);
+        auto newNode = list_newNode(object, _nodePool);
         if (cmpRes < 0)
         {
             newNode->addAfter(node);
@@ -349,14 +372,18 @@ Hashtable::clear()
             if (isOwner())
                 delete tableObj;
         }
-        else
+        else if (isOwner() || (_nodePool == nullptr))
         {
             auto head = getHead(i);
-            list_clear(head, nullptr, isOwner());
+            list_clear(head, nullptr, isOwner(), _nodePool);
         }
         setObject(i, nullptr);
     }
     _items = 0;
+
+    // release all list nodes at once
+    if (_nodePool != nullptr)
+        _nodePool->clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -523,6 +550,7 @@ void
 Hashtable::init(size_t size, uint_t maxLF, bool owner, bool multiSet, const HashFunction* hashfn)
 {
     _hashfn = hashfn;
+    _nodePool = nullptr;
     _limit = 0;
     _maxLF = maxLF;
     setOwner(owner);
@@ -542,6 +570,7 @@ Hashtable::deInit()
 {
     clear();
     delete _hashfn;
+    delete _nodePool;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -589,7 +618,7 @@ Hashtable::grow(size_t newSize)
             for_each_ln(head, Object, listObject);
             add(&listObject);
             for_each_end;
-            list_clear(head, nullptr, false);
+            list_clear(head, nullptr, false, _nodePool);
         }
     }
 
@@ -654,7 +683,7 @@ Hashtable::remove(size_t idx, ListNode* node)
     else
     {
         auto head = getHead(idx);
-        list_removeNode(head, nullptr, node, isOwner());
+        list_removeNode(head, nullptr, node, isOwner(), _nodePool);
         setHead(idx, head);
 
         // if only one item left, get rid of list
@@ -662,7 +691,7 @@ Hashtable::remove(size_t idx, ListNode* node)
         if (head->next() == nullptr)
         {
             auto object = head->get();
-            list_clear(head, nullptr, false);
+            list_clear(head, nullptr, false, _nodePool);
             setObject(idx, object);
         }
     }
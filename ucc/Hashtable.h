@@ -144,6 +144,19 @@ public:
 
     /** Grow the hash-table to a size large enough to contain the given number of objects. */
     void reserve(size_t newSize);
+
+    /**
+       Allocate list nodes (for objects that share a hash) from a pool that belongs to the
+       hashtable (see NodePool), or from the global heap.  The hashtable must be empty.
+    */
+    void setNodePool(bool nodePool);
+
+    /** Determine whether list nodes are allocated from a node pool. */
+    bool
+    hasNodePool() const
+    {
+        return (_nodePool != nullptr);
+    }
     //@}
 
     /// \name Searching
@@ -305,6 +318,7 @@ private:
 
 private:
     const HashFunction* _hashfn;
+    NodePool* _nodePool;
     size_t _limit;
     uint_t _maxLF;
     Vector<pip_t> _array;
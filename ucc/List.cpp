@@ -1,6 +1,7 @@
 #include <libutl/libutl.h>
 #include <libutl/List.h>
 #include <libutl/MaxObject.h>
+#include <libutl/dlist.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -27,7 +28,9 @@ List::steal(Object& rhs_)
     super::steal(rhs);
     _front = rhs._front;
     _back = rhs._back;
+    _nodePool = rhs._nodePool;
     rhs._front = rhs._back = new ListNode(&maxObject);
+    rhs._nodePool = nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -36,7 +39,14 @@ size_t
 List::innerAllocatedSize() const
 {
     size_t sz = super::innerAllocatedSize();
-    sz += (this->size() + 1) * sizeof(ListNode);
+    if (_nodePool == nullptr)
+    {
+        sz += (this->size() + 1) * sizeof(ListNode);
+    }
+    else
+    {
+        sz += sizeof(ListNode) + sizeof(NodePool) + _nodePool->innerAllocatedSize();
+    }
     return sz;
 }
 
@@ -104,6 +114,25 @@ List::moveBefore(const iterator& lhs, const iterator& rhs)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+List::setNodePool(bool nodePool)
+{
+    ASSERTD(empty());
+    if (nodePool == hasNodePool())
+        return;
+    if (nodePool)
+    {
+        _nodePool = new NodePool(sizeof(ListNode));
+    }
+    else
+    {
+        delete _nodePool;
+        _nodePool = nullptr;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 Object*
 List::find(const Object& key) const
 {
@@ -229,7 +258,7 @@ List::add(const Object* object)
                 delete object;
             return false;
         }
-        ListNode* ln = new ListNode(object);
+        ListNode* ln = list_newNode(object, _nodePool);
         ln->addBefore(node);
         if (node == _front)
         {
@@ -257,7 +286,7 @@ List::addBefore(const Object* object, const iterator& it)
 {
     ASSERTD(it.isValid(this));
     ListNode* node = it.getNode();
-    ListNode* ln = new ListNode(object);
+    ListNode* ln = list_newNode(object, _nodePool);
     ln->addBefore(node);
     if (node == _front)
     {
@@ -271,7 +300,7 @@ List::addBefore(const Object* object, const iterator& it)
 void
 List::pushFront(const Object* object)
 {
-    ListNode* ln = new ListNode(object);
+    ListNode* ln = list_newNode(object, _nodePool);
     ln->addBefore(_front);
     _front = ln;
     ++_items;
@@ -282,7 +311,7 @@ List::pushFront(const Object* object)
 void
 List::pushBack(const Object* object)
 {
-    ListNode* ln = new ListNode(object);
+    ListNode* ln = list_newNode(object, _nodePool);
     ln->addBefore(_back);
     if (_front == _back)
     {
@@ -307,20 +336,27 @@ void
 List::clear()
 {
     ListNode* curNode = _front;
-    while (curNode != _back)
+    if (isOwner() || (_nodePool == nullptr))
     {
-        ListNode* next = curNode->next();
-        if (isOwner())
+        while (curNode != _back)
         {
-            delete curNode->get();
+            ListNode* next = curNode->next();
+            if (isOwner())
+            {
+                delete curNode->get();
+            }
+            list_deleteNode(curNode, _nodePool);
+            curNode = next;
         }
-        delete curNode;
-        curNode = next;
     }
 
     _front = _back;
     _back->setPrev(nullptr);
     _items = 0;
+
+    // release all nodes at once
+    if (_nodePool != nullptr)
+        _nodePool->clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -423,6 +459,7 @@ List::init(bool owner, bool multiSet, bool keepSorted, Ordering* ordering)
     if (ordering != nullptr)
         setOrdering(ordering, sort_none);
     _front = _back = new ListNode(&maxObject);
+    _nodePool = nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -432,6 +469,7 @@ List::deInit()
 {
     clear();
     delete _front;
+    delete _nodePool;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -638,7 +676,7 @@ List::removeNode(ListNode* node)
     if (isOwner())
         delete object;
     --_items;
-    delete node;
+    list_deleteNode(node, _nodePool);
 
     // might have changed the front of the list
     // (can't ever change the back b/c it's a sentinel)
@@ -12,6 +12,7 @@ UTL_NS_BEGIN;
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 class ListIt;
+class NodePool;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -134,6 +135,13 @@ public:
     {
         return getFlag(flg_sorted);
     }
+
+    /** Determine whether nodes are allocated from a node pool. */
+    bool
+    hasNodePool() const
+    {
+        return (_nodePool != nullptr);
+    }
     //@}
 
     /// \name Misc. Modification
@@ -178,6 +186,12 @@ public:
        \param rhs specifies rhs node
     */
     void moveBefore(const iterator& lhs, const iterator& rhs);
+
+    /**
+       Allocate nodes from a pool that belongs to the list (see NodePool), or from the global
+       heap.  The list must be empty.
+    */
+    void setNodePool(bool nodePool);
     //@}
 
     /// \name Searching
@@ -373,6 +387,7 @@ private:
 
 private:
     ListNode *_front, *_back;
+    NodePool* _nodePool;
     enum flg_t
     {
         flg_keepSorted = 4,
@@ -0,0 +1,70 @@
+#include <libutl/libutl.h>
+#include <libutl/NodePool.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// block header size (keeps nodes aligned as well as the global allocator would)
+static const size_t blockHeaderSize = alignof(max_align_t);
+
+static const size_t minBlockSize = 1024;
+static const size_t maxBlockSize = 64 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+NodePool::NodePool(size_t nodeSize)
+{
+    // a free node holds the free-list link, and nodes are pointer-aligned
+    nodeSize = max(nodeSize, sizeof(void*));
+    _nodeSize = nextMultipleOfPow2(sizeof(void*), nodeSize);
+    _blockSize = minBlockSize;
+    _allocatedSize = 0;
+    _blocks = nullptr;
+    _blockPtr = _blockLim = nullptr;
+    _freeList = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+NodePool::clear()
+{
+    block_t* block = _blocks;
+    while (block != nullptr)
+    {
+        block_t* next = block->next;
+        delete[] reinterpret_cast<byte_t*>(block);
+        block = next;
+    }
+    _blockSize = minBlockSize;
+    _allocatedSize = 0;
+    _blocks = nullptr;
+    _blockPtr = _blockLim = nullptr;
+    _freeList = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+NodePool::addBlock()
+{
+    size_t blockSize = max(_blockSize, blockHeaderSize + _nodeSize);
+    size_t numNodes = (blockSize - blockHeaderSize) / _nodeSize;
+    auto block = reinterpret_cast<block_t*>(new byte_t[blockSize]);
+    block->next = _blocks;
+    _blocks = block;
+    _blockPtr = reinterpret_cast<byte_t*>(block) + blockHeaderSize;
+    _blockLim = _blockPtr + (numNodes * _nodeSize);
+    _allocatedSize += blockSize;
+
+    // next block is twice as large
+    if (_blockSize < maxBlockSize)
+        _blockSize *= 2;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
@@ -0,0 +1,139 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Pool of fixed-size nodes (for node-based collections).
+
+   NodePool carves nodes out of large blocks instead of allocating each one from the global heap.
+   Nodes that are allocated together (e.g. while a collection is being filled) are adjacent in
+   memory, which reduces cache misses when the collection is traversed, and allocation is reduced
+   to popping a free list or bumping a pointer.  Freed nodes go onto the free list for re-use.
+   Blocks start small and double in size (up to 64 KB), so a pool that only ever holds a few
+   nodes doesn't waste much memory.
+
+   clear() releases all blocks at once, so a collection that doesn't own its objects can be
+   cleared without visiting each node.
+
+   NodePool is not thread-safe: each collection that uses one has its own.
+
+   \author Adam McKee
+   \ingroup collection
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class NodePool
+{
+public:
+    /**
+       Constructor.
+       \param nodeSize size of each node (in bytes)
+    */
+    NodePool(size_t nodeSize);
+
+    NodePool(const NodePool&) = delete;
+
+    NodePool& operator=(const NodePool&) = delete;
+
+    /** Destructor (releases all blocks). */
+    ~NodePool()
+    {
+        clear();
+    }
+
+    /** Allocate a node. */
+    void*
+    alloc()
+    {
+        void* ptr = _freeList;
+        if (ptr != nullptr)
+        {
+            _freeList = *reinterpret_cast<void**>(ptr);
+            return ptr;
+        }
+        if (_blockPtr == _blockLim)
+            addBlock();
+        ptr = _blockPtr;
+        _blockPtr += _nodeSize;
+        return ptr;
+    }
+
+    /** Free a node that was allocated by alloc(). */
+    void
+    free(void* ptr)
+    {
+        *reinterpret_cast<void**>(ptr) = _freeList;
+        _freeList = ptr;
+    }
+
+    /** Construct a T in a node allocated from the pool. */
+    template <typename T, typename... Args>
+    T* create(Args&&... args);
+
+    /** Destroy a T that was made by create(). */
+    template <typename T>
+    void
+    destroy(T* node)
+    {
+        node->~T();
+        free(node);
+    }
+
+    /** Release all blocks (invalidating all allocated nodes). */
+    void clear();
+
+    /** Get the node size. */
+    size_t
+    nodeSize() const
+    {
+        return _nodeSize;
+    }
+
+    /** Get the total size of the allocated blocks. */
+    size_t
+    innerAllocatedSize() const
+    {
+        return _allocatedSize;
+    }
+
+private:
+    void addBlock();
+
+private:
+    struct block_t
+    {
+        block_t* next;
+    };
+
+private:
+    size_t _nodeSize;
+    size_t _blockSize;
+    size_t _allocatedSize;
+    block_t* _blocks;
+    byte_t* _blockPtr;
+    byte_t* _blockLim;
+    void* _freeList;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#undef new
+
+template <typename T, typename... Args>
+T*
+NodePool::create(Args&&... args)
+{
+    ASSERTD(sizeof(T) <= _nodeSize);
+    return new (alloc()) T(std::forward<Args>(args)...);
+}
+
+#include <libutl/gblnew_macros.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
@@ -1,4 +1,5 @@
 #include <libutl/libutl.h>
+#include <libutl/MemoryCensus.h>
 #include <libutl/ObjectCache.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -12,6 +13,32 @@ UTL_NS_BEGIN;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+CachedObject::censusOwned(MemoryCensus& census) const
+{
+    if (_object != nullptr)
+        census.add(*_object);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+ObjectCache::innerAllocatedSize() const
+{
+    // (_ht owns the CachedObjects, _list just refers to them)
+    return _ht.innerAllocatedSize() + _list.innerAllocatedSize();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+ObjectCache::censusOwned(MemoryCensus& census) const
+{
+    _ht.censusOwned(census);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void
 ObjectCache::access(const Object* object)
 {
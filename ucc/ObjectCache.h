@@ -40,6 +40,7 @@ enum cache_t
 class CachedObject : public Object
 {
     UTL_CLASS_DECL(CachedObject, Object);
+    UTL_CLASS_POOLED;
 
 public:
     void
@@ -57,6 +58,14 @@ public:
         return _object->getKey();
     }
 
+    virtual size_t
+    innerAllocatedSize() const
+    {
+        return (_object == nullptr) ? 0 : _object->allocatedSize();
+    }
+
+    virtual void censusOwned(MemoryCensus& census) const;
+
     ListNode*
     getNode() const
     {
@@ -146,6 +155,10 @@ public:
         init(size);
     }
 
+    virtual size_t innerAllocatedSize() const;
+
+    virtual void censusOwned(MemoryCensus& census) const;
+
     /** Access the given object, so that it becomes the MRU object. */
     void access(const Object* object);
 
@@ -1,5 +1,6 @@
 #include <libutl/libutl.h>
 #include <libutl/MaxObject.h>
+#include <libutl/MemoryCensus.h>
 #include <libutl/ObjectRegistry.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -29,6 +30,12 @@ public:
         return _object->allocatedSize();
     }
 
+    virtual void
+    censusOwned(MemoryCensus& census) const
+    {
+        census.add(*_object);
+    }
+
     Object*
     get() const
     {
@@ -150,6 +157,15 @@ ObjectRegistry::innerAllocatedSize() const
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+ObjectRegistry::censusOwned(MemoryCensus& census) const
+{
+    RWlockGuard lock(_lock, io_rd);
+    _objects.censusOwned(census);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void
 ObjectRegistry::setOrdering(Ordering* ordering)
 {
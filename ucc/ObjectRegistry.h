@@ -49,6 +49,8 @@ public:
 
     virtual size_t innerAllocatedSize() const;
 
+    virtual void censusOwned(MemoryCensus& census) const;
+
     /** Set the ordering (registry must be empty). */
     void setOrdering(Ordering* ordering);
 
@@ -0,0 +1,716 @@
+#include <libutl/libutl.h>
+#include <libutl/OpenHashtable.h>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define UTL_OPENHASHTABLE_SSE2
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Each function below examines the 16 control codes starting at ctrl, and returns a bit-mask
+// where bit i is set iff ctrl[i] satisfies the condition.
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline uint32_t
+matchTag(const byte_t* ctrl, byte_t tag)
+{
+#ifdef UTL_OPENHASHTABLE_SSE2
+    auto group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)tag)));
+#else
+    uint32_t res = 0;
+    for (uint_t i = 0; i != 16; ++i)
+        res |= (uint32_t)(ctrl[i] == tag) << i;
+    return res;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline uint32_t
+matchEmpty(const byte_t* ctrl)
+{
+    // empty slots (and only empty slots) have the high bit set
+#ifdef UTL_OPENHASHTABLE_SSE2
+    auto group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+    return _mm_movemask_epi8(group);
+#else
+    uint32_t res = 0;
+    for (uint_t i = 0; i != 16; ++i)
+        res |= (uint32_t)(ctrl[i] >> 7) << i;
+    return res;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline void
+prefetch(const void* ptr)
+{
+#if UTL_CC == UTL_CC_MSVC
+    _mm_prefetch(reinterpret_cast<const char*>(ptr), _MM_HINT_T0);
+#else
+    __builtin_prefetch(ptr);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// murmur3 finalizer: spread every bit of the object's hash over the whole word
+static inline size_t
+mixHash(uint64_t h)
+{
+    h ^= (h >> 33);
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= (h >> 33);
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= (h >> 33);
+    return h;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// number of slots past the end of the home range that probe sequences may run into
+static size_t
+overflowFor(size_t capacity)
+{
+    size_t lg = 0;
+    while ((capacity >>= 1) != 0)
+        ++lg;
+    return max((size_t)32, lg * 8);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// OpenHashtable //////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+OpenHashtable::steal(Object& rhs_)
+{
+    auto& rhs = utl::cast<OpenHashtable>(rhs_);
+    deInit();
+    super::steal(rhs);
+    _hashfn = rhs._hashfn;
+    _ctrl = rhs._ctrl;
+    _slots = rhs._slots;
+    _capacity = rhs._capacity;
+    _numSlots = rhs._numSlots;
+    _limit = rhs._limit;
+    _maxDist = rhs._maxDist;
+    _maxLF = rhs._maxLF;
+    rhs._hashfn = nullptr;
+    rhs._ctrl = nullptr;
+    rhs._slots = nullptr;
+    rhs._capacity = 0;
+    rhs._numSlots = 0;
+    rhs._limit = 0;
+    rhs._maxDist = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+OpenHashtable::vclone(const Object& rhs)
+{
+    auto& ht = cast<OpenHashtable>(rhs);
+    ASSERTD(_hashfn == nullptr);
+    if (ht._hashfn != nullptr)
+    {
+        setHashFunction(ht._hashfn->clone());
+    }
+    super::vclone(rhs);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+OpenHashtable::innerAllocatedSize() const
+{
+    auto sz = super::innerAllocatedSize();
+    if (_numSlots != 0)
+    {
+        sz += _numSlots * sizeof(slot_t);
+        sz += _numSlots + group_size;
+    }
+
+    // assume _hashfn is same size as utl::HashFunction
+    if (_hashfn != nullptr)
+        sz += sizeof(HashFunction);
+
+    return sz;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+OpenHashtable::reserve(size_t reqSize)
+{
+    if (reqSize <= _limit)
+        return;
+
+    // smallest power-of-2 capacity where the table is no more than maxLF % full with reqSize objects
+    size_t newCapacity = (double)reqSize * (100.0 / (double)_maxLF) + 1.0;
+    newCapacity = max(nextPow2(newCapacity), group_size);
+    rehash(newCapacity, overflowFor(newCapacity));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Object*
+OpenHashtable::find(const Object& key) const
+{
+    auto idx = findIdx(key, hash(key));
+    return (idx == size_t_max) ? nullptr : _slots[idx].object;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+OpenHashtable::iterator
+OpenHashtable::findIt(const Object& key) const
+{
+    iterator it = const_cast_this->findIt(key);
+    IFDEBUG(it.setConst(true));
+    return it;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+OpenHashtable::iterator
+OpenHashtable::findIt(const Object& key)
+{
+    return iterator(this, findIdx(key, hash(key)));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+OpenHashtable::findIt(const Object& key, BidIt& it)
+{
+    it = findIt(key);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool
+OpenHashtable::add(const Object* object)
+{
+    auto h = hash(object);
+    if (!isMultiSet() && (findIdx(*object, h) != size_t_max))
+    {
+        if (isOwner())
+            delete object;
+        return false;
+    }
+    insert(const_cast<Object*>(object), h);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Object*
+OpenHashtable::addOrFind(const Object* object)
+{
+    auto h = hash(object);
+    if (!isMultiSet())
+    {
+        auto idx = findIdx(*object, h);
+        if (idx != size_t_max)
+        {
+            if (isOwner())
+                delete object;
+            return _slots[idx].object;
+        }
+    }
+    insert(const_cast<Object*>(object), h);
+    return const_cast<Object*>(object);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool
+OpenHashtable::addOrUpdate(const Object* object)
+{
+    auto h = hash(object);
+    if (!isMultiSet())
+    {
+        auto idx = findIdx(*object, h);
+        if (idx != size_t_max)
+        {
+            auto& slot = _slots[idx];
+            if (isOwner())
+                delete slot.object;
+            slot.object = const_cast<Object*>(object);
+            return false;
+        }
+    }
+    insert(const_cast<Object*>(object), h);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+OpenHashtable::clear()
+{
+    if (_items == 0)
+        return;
+    if (isOwner())
+    {
+        for (size_t idx = nextIdx(size_t_max); idx != size_t_max; idx = nextIdx(idx))
+        {
+            delete _slots[idx].object;
+        }
+    }
+    memset(_ctrl, ctrl_empty, _numSlots);
+    _items = 0;
+    _maxDist = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+OpenHashtable::excise()
+{
+    clear();
+    delete[] _ctrl;
+    delete[] _slots;
+    _ctrl = nullptr;
+    _slots = nullptr;
+    _capacity = 0;
+    _numSlots = 0;
+    _limit = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool
+OpenHashtable::remove(const Object& key)
+{
+    auto idx = findIdx(key, hash(key));
+    if (idx == size_t_max)
+        return false;
+    remove(idx);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+OpenHashtable::removeIt(BidIt& it)
+{
+    ASSERTD(*it != nullptr);
+    auto& hit = utl::cast<iterator>(it.getProxiedObject());
+    ASSERTD(hit.isValid(this));
+    auto idx = hit.getIdx();
+    remove(idx);
+
+    // the successor was either shifted back into idx, or it lies beyond idx
+    if (_ctrl[idx] == ctrl_empty)
+        ++hit;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+OpenHashtable::iterator
+OpenHashtable::begin() const
+{
+    iterator it(this, nextIdx(size_t_max));
+    IFDEBUG(it.setConst(true));
+    return it;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+OpenHashtable::iterator
+OpenHashtable::begin()
+{
+    return iterator(this, nextIdx(size_t_max));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BidIt*
+OpenHashtable::beginNew() const
+{
+    auto it = new iterator(this, nextIdx(size_t_max));
+    IFDEBUG(it->setConst(true));
+    return it;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BidIt*
+OpenHashtable::beginNew()
+{
+    return new iterator(this, nextIdx(size_t_max));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BidIt*
+OpenHashtable::endNew() const
+{
+    auto it = new iterator(this, size_t_max);
+    IFDEBUG(it->setConst(true));
+    return it;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BidIt*
+OpenHashtable::endNew()
+{
+    return new iterator(this, size_t_max);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+OpenHashtable::init(size_t size, uint_t maxLF, bool owner, bool multiSet, const HashFunction* hashfn)
+{
+    ASSERTD((maxLF > 0) && (maxLF < 100));
+    _hashfn = hashfn;
+    _ctrl = nullptr;
+    _slots = nullptr;
+    _capacity = 0;
+    _numSlots = 0;
+    _limit = 0;
+    _maxDist = 0;
+    _maxLF = maxLF;
+    setOwner(owner);
+    setMultiSet(multiSet);
+    reserve(size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+OpenHashtable::deInit()
+{
+    excise();
+    delete _hashfn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+OpenHashtable::rehash(size_t capacity, size_t overflow)
+{
+    ASSERTD(capacity == nextPow2(capacity));
+
+    // remember the old arrays
+    auto oldCtrl = _ctrl;
+    auto oldSlots = _slots;
+    auto oldNumSlots = _numSlots;
+    IFDEBUG(auto items = _items);
+
+    // re-insert into new arrays, enlarging the overflow area until every probe sequence fits
+    // (only a badly clustered hash function should ever require that)
+    while (true)
+    {
+        _capacity = capacity;
+        _numSlots = capacity + overflow;
+        _ctrl = new byte_t[_numSlots + group_size];
+        _slots = new slot_t[_numSlots];
+        memset(_ctrl, ctrl_empty, _numSlots + group_size);
+        _items = 0;
+        _maxDist = 0;
+        _limit = size_t_max;
+
+        size_t i;
+        for (i = 0; i != oldNumSlots; ++i)
+        {
+            if (oldCtrl[i] == ctrl_empty)
+                continue;
+            auto& slot = oldSlots[i];
+            if (!insert(slot.object, slot.hash))
+                break;
+        }
+        if (i == oldNumSlots)
+            break;
+
+        delete[] _ctrl;
+        delete[] _slots;
+        overflow *= 2;
+    }
+    ASSERTD(_items == items);
+
+    // set _limit based on capacity & max-percentage
+    _limit = (double)capacity * ((double)_maxLF / 100.0);
+
+    delete[] oldCtrl;
+    delete[] oldSlots;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+OpenHashtable::findIdx(const Object& key, size_t h) const
+{
+    if (_items == 0)
+        return size_t_max;
+
+    auto keyTag = tag(h);
+    auto pos = home(h);
+    auto lim = pos + _maxDist;
+
+    // the first matching slot is usually the home slot, so fetch it alongside the control codes
+    prefetch(_slots + pos);
+    for (; pos <= lim; pos += group_size)
+    {
+        auto ctrl = _ctrl + pos;
+        auto matches = matchTag(ctrl, keyTag);
+        auto empties = matchEmpty(ctrl);
+
+        // no object belonging to this probe sequence lies beyond an empty slot
+        if (empties != 0)
+            matches &= (empties & (~empties + 1)) - 1;
+
+        while (matches != 0)
+        {
+            auto idx = pos + lowestBit(matches);
+            auto& slot = _slots[idx];
+            if ((slot.hash == h) && (compareObjects(slot.object, key) == 0))
+                return idx;
+            matches &= (matches - 1);
+        }
+
+        if (empties != 0)
+            break;
+    }
+    return size_t_max;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool
+OpenHashtable::insert(Object* object, size_t h)
+{
+    // grow if necessary
+    if (_items >= _limit)
+        rehash(max(_capacity * 2, group_size), overflowFor(_capacity * 2));
+
+    // the insertion will fill the first empty slot at or after the home slot
+    size_t pos, end;
+    while (true)
+    {
+        pos = home(h);
+        for (end = pos; end < _numSlots; end += group_size)
+        {
+            auto empties = matchEmpty(_ctrl + end);
+            if (empties != 0)
+            {
+                end += lowestBit(empties);
+                break;
+            }
+        }
+        if (end < _numSlots)
+            break;
+
+        // no room for this probe sequence: fail (if rehashing), else make more room
+        if (_limit == size_t_max)
+            return false;
+        if (_items >= (_limit / 2))
+            rehash(_capacity * 2, overflowFor(_capacity * 2));
+        else
+            rehash(_capacity, (_numSlots - _capacity) * 2);
+    }
+
+    // Robin Hood: walk toward end, taking the place of any object that is closer to its home
+    slot_t cur = {object, h};
+    size_t dist = 0;
+    for (; pos != end; ++pos, ++dist)
+    {
+        auto& slot = _slots[pos];
+        auto slotDist = pos - home(slot.hash);
+        if (slotDist < dist)
+        {
+            std::swap(cur, slot);
+            _ctrl[pos] = tag(slot.hash);
+            _maxDist = max(_maxDist, dist);
+            dist = slotDist;
+        }
+    }
+    _slots[end] = cur;
+    _ctrl[end] = tag(cur.hash);
+    _maxDist = max(_maxDist, dist);
+    ++_items;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+OpenHashtable::remove(size_t idx)
+{
+    ASSERTD(idx < _numSlots);
+    ASSERTD(_ctrl[idx] != ctrl_empty);
+    if (isOwner())
+        delete _slots[idx].object;
+
+    // backward-shift: pull back following objects that aren't in their home slot
+    auto pos = idx;
+    for (auto next = pos + 1; next < _numSlots; pos = next++)
+    {
+        if ((_ctrl[next] == ctrl_empty) || (home(_slots[next].hash) == next))
+            break;
+        _slots[pos] = _slots[next];
+        _ctrl[pos] = _ctrl[next];
+    }
+    _ctrl[pos] = ctrl_empty;
+    --_items;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+OpenHashtable::nextIdx(size_t idx) const
+{
+    // trailing control codes are all empty, so we can scan whole groups without bounds checks
+    for (++idx; idx < _numSlots; idx += group_size)
+    {
+        auto occupied = ~matchEmpty(_ctrl + idx) & 0xffff;
+        if (occupied != 0)
+        {
+            idx += lowestBit(occupied);
+            return (idx < _numSlots) ? idx : size_t_max;
+        }
+    }
+    return size_t_max;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+OpenHashtable::prevIdx(size_t idx) const
+{
+    if (idx > _numSlots)
+        idx = _numSlots;
+    while (idx-- != 0)
+    {
+        if (_ctrl[idx] != ctrl_empty)
+            return idx;
+    }
+    return size_t_max;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+OpenHashtable::hash(const Object* object) const
+{
+    ASSERTD(object != nullptr);
+    if (_hashfn == nullptr)
+        return mixHash(object->hash(size_t_max));
+    return mixHash(_hashfn->hash(object, size_t_max));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// OpenHashtableIt /////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+OpenHashtableIt::compare(const Object& rhs) const
+{
+    auto& hit = utl::cast<OpenHashtableIt>(rhs);
+    ASSERTD(hasSameOwner(hit));
+    return utl::compare(_idx, hit._idx);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+OpenHashtableIt::copy(const Object& rhs)
+{
+    auto& hit = utl::cast<OpenHashtableIt>(rhs);
+    super::copy(hit);
+    _ht = hit._ht;
+    _idx = hit._idx;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+OpenHashtableIt::forward(size_t dist)
+{
+    ASSERTD(isValid(_ht));
+    while ((dist-- > 0) && (_idx != size_t_max))
+    {
+        _idx = _ht->nextIdx(_idx);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Object*
+OpenHashtableIt::get() const
+{
+    ASSERTD(isValid(_ht));
+    if (_idx >= _ht->_numSlots)
+        return nullptr;
+    ASSERTD(_ht->_ctrl[_idx] != OpenHashtable::ctrl_empty);
+    return _ht->_slots[_idx].object;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+OpenHashtableIt::reverse(size_t dist)
+{
+    ASSERTD(isValid(_ht));
+    auto idx = _idx;
+    while (dist-- > 0)
+    {
+        idx = _ht->prevIdx(idx);
+        if (idx == size_t_max)
+            break;
+    }
+    _idx = idx;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+OpenHashtableIt::set(const Object* object)
+{
+    ASSERTD(!isConst());
+    ASSERTD(isValid(_ht));
+
+    // adding the object
+    if (get() == nullptr)
+    {
+        ASSERTD(object != nullptr);
+        _ht->add(object);
+        return;
+    }
+
+    // removing the object
+    if (object == nullptr)
+    {
+        _ht->removeIt(self);
+        return;
+    }
+
+    // replacing an object
+    auto& slot = _ht->_slots[_idx];
+    ASSERTD(_ht->hash(object) == slot.hash);
+    if (object == slot.object)
+        return;
+    if (_ht->isOwner())
+        delete slot.object;
+    slot.object = const_cast<Object*>(object);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_CLASS_IMPL(utl::OpenHashtable);
+UTL_CLASS_IMPL(utl::OpenHashtableIt);
@@ -0,0 +1,273 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/Collection.h>
+#include <libutl/Hashtable.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class OpenHashtableIt;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// OpenHashtable ///////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Open-addressing hashing collection.
+
+   OpenHashtable provides the same interface as Hashtable, but it doesn't chain colliding objects
+   together in linked lists.  Every object is stored directly in a flat slot array, and collisions
+   are resolved by linear probing with Robin Hood displacement: when an object being inserted has
+   probed further from its home slot than the object already occupying a slot, the two trade
+   places.  This keeps probe sequences short and uniform even at high load factors.
+
+   A separate array of one-byte control codes (one per slot) records whether each slot is empty,
+   and if not, holds 7 bits of the contained object's hash code.  Searching compares a whole group
+   of control codes against the search key's hash bits at once (with SSE2 where available), so
+   contained objects are only compared (via Object::compare() or the collection's ordering) when
+   their hash bits already match.
+
+   The full hash code of each contained object is remembered, so the table can be grown without
+   calling the hash function again.  The hash function is invoked as <code>hash(size_t_max)</code>
+   (see Object::hash()), and its result is further mixed, so a weak hash function (such as the
+   identity hash used for integers) is acceptable.
+
+   <b>Advantages</b>
+
+   \arg add(const utl::Object*), find(), remove() are practically O(1) for any reasonable hash
+   \arg no memory allocation on insertion (except when the table is grown)
+   \arg a search touches very few cache lines (no pointer chasing through chains)
+
+   <b>Disadvantages</b>
+
+   \arg contained objects are not sorted
+   \arg more memory per slot than Hashtable (object pointer + hash code + control byte)
+
+   \author Adam McKee
+   \ingroup collection
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class OpenHashtable : public Collection
+{
+    UTL_CLASS_DECL(OpenHashtable, Collection);
+    friend class OpenHashtableIt;
+    friend class ConcurrentHashtable;
+    friend class ConcurrentHashtableIt;
+
+public:
+    typedef OpenHashtableIt iterator;
+
+public:
+    /**
+       Constructor.
+       \param size initial size of hash-table
+       \param maxLF (optional : 85) maximum load factor
+       \param owner (optional : true) owner flag
+       \param multiSet (optional : false) multiSet flag
+       \param hfunc (optional) hash function
+    */
+    OpenHashtable(size_t size,
+                  uint_t maxLF = 85,
+                  bool owner = true,
+                  bool multiSet = false,
+                  const HashFunction* hfunc = nullptr)
+    {
+        init(size, maxLF, owner, multiSet, hfunc);
+    }
+
+    /**
+       Constructor.
+       \param owner owner flag
+       \param multiSet multiSet flag
+       \param hfunc (optional) hash function
+    */
+    OpenHashtable(bool owner, bool multiSet = false, const HashFunction* hfunc = nullptr)
+    {
+        init(0, 85, owner, multiSet, hfunc);
+    }
+
+    virtual void steal(Object& rhs);
+
+    virtual void vclone(const Object& rhs);
+
+    virtual size_t innerAllocatedSize() const;
+
+    /// \name Misc. Modification
+    //@{
+    /** Set the hash function. */
+    void
+    setHashFunction(const HashFunction* hashfn)
+    {
+        ASSERTD(empty());
+        delete _hashfn;
+        _hashfn = hashfn;
+    }
+
+    /** Grow the hash-table to a size large enough to contain the given number of objects. */
+    void reserve(size_t newSize);
+    //@}
+
+    /// \name Searching
+    //@{
+    virtual Object* find(const Object& key) const;
+
+    iterator findIt(const Object& key) const;
+
+    iterator findIt(const Object& key);
+
+    void
+    findIt(const Object& key, BidIt& it) const
+    {
+        const_cast_this->findIt(key, it);
+        IFDEBUG(it.setConst(true));
+    }
+
+    virtual void findIt(const Object& key, BidIt& it);
+    //@}
+
+    /// \name Adding Objects
+    //@{
+    bool
+    add(const Object& object)
+    {
+        return super::add(object);
+    }
+
+    virtual bool add(const Object* object);
+
+    void
+    add(const Collection& collection)
+    {
+        super::add(collection);
+    }
+
+    Object*
+    addOrFind(const Object& object)
+    {
+        return super::addOrFind(object);
+    }
+
+    virtual Object* addOrFind(const Object* object);
+
+    bool
+    addOrUpdate(const Object& object)
+    {
+        return super::addOrUpdate(object);
+    }
+
+    virtual bool addOrUpdate(const Object* object);
+    //@}
+
+    /// \name Removing Objects
+    //@{
+    virtual void clear();
+
+    /**
+       Same as clear(), but in addition the slot arrays are deleted.  Call this method instead
+       of clear() when you want to minimize memory usage as much as possible.
+    */
+    void excise();
+
+    bool
+    remove(const Object* key)
+    {
+        ASSERTD(key != nullptr);
+        return remove(*key);
+    }
+
+    virtual bool remove(const Object& key);
+
+    virtual void removeIt(BidIt& it);
+    //@}
+
+    /// \name Iterators
+    //@{
+    iterator begin() const;
+
+    iterator begin();
+
+    virtual BidIt* beginNew() const;
+
+    virtual BidIt* beginNew();
+
+    inline iterator end() const;
+
+    inline iterator end();
+
+    virtual BidIt* endNew() const;
+
+    virtual BidIt* endNew();
+    //@}
+
+private:
+    struct slot_t
+    {
+        Object* object;
+        size_t hash;
+    };
+
+    // control code for an empty slot (occupied slots hold 7 bits of the hash)
+    static constexpr byte_t ctrl_empty = 0x80;
+
+    // number of control codes examined at once
+    static constexpr size_t group_size = 16;
+
+private:
+    void init(size_t size = 0,
+              uint_t maxLF = 85,
+              bool owner = true,
+              bool multiSet = false,
+              const HashFunction* hashfn = nullptr);
+    void deInit();
+
+    void rehash(size_t capacity, size_t overflow);
+
+    size_t findIdx(const Object& key, size_t h) const;
+
+    bool insert(Object* object, size_t h);
+
+    void remove(size_t idx);
+
+    size_t nextIdx(size_t idx) const;
+
+    size_t prevIdx(size_t idx) const;
+
+    size_t hash(const Object* object) const;
+
+    size_t
+    home(size_t h) const
+    {
+        return (h >> 7) & (_capacity - 1);
+    }
+
+    static byte_t
+    tag(size_t h)
+    {
+        return (byte_t)(h & 0x7f);
+    }
+
+private:
+    const HashFunction* _hashfn;
+    byte_t* _ctrl;
+    slot_t* _slots;
+    size_t _capacity;
+    size_t _numSlots;
+    size_t _limit;
+    size_t _maxDist;
+    uint_t _maxLF;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/OpenHashtableIt.h>
@@ -0,0 +1,134 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/BidIt.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Bi-directional OpenHashtable iterator.
+
+   \author Adam McKee
+   \ingroup collection
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class OpenHashtableIt : public BidIt
+{
+    UTL_CLASS_DECL(OpenHashtableIt, BidIt);
+
+public:
+    /**
+       Constructor.
+       \param ht associated OpenHashtable
+       \param idx slot index
+    */
+    OpenHashtableIt(const OpenHashtable* ht, size_t idx)
+        : _ht(const_cast<OpenHashtable*>(ht))
+        , _idx(idx)
+    {
+        IFDEBUG(FwdIt::setOwner(_ht));
+    }
+
+    /** Compare with another OpenHashtableIt. */
+    virtual int compare(const Object& rhs) const;
+
+    /** Copy another OpenHashtableIt. */
+    virtual void copy(const Object& rhs);
+
+    virtual void forward(size_t dist = 1);
+
+    virtual Object* get() const;
+
+    /** Get the associated OpenHashtable. */
+    OpenHashtable*
+    getHashtable() const
+    {
+        return _ht;
+    }
+
+    /** Get the slot index. */
+    size_t
+    getIdx() const
+    {
+        return _idx;
+    }
+
+    virtual void reverse(size_t dist = 1);
+
+    virtual void set(const Object* object);
+
+    OpenHashtableIt&
+    operator++()
+    {
+        forward();
+        return *this;
+    }
+
+    OpenHashtableIt
+    operator++(int)
+    {
+        OpenHashtableIt res = *this;
+        forward();
+        return res;
+    }
+
+    OpenHashtableIt&
+    operator--()
+    {
+        reverse();
+        return *this;
+    }
+
+    OpenHashtableIt
+    operator--(int)
+    {
+        OpenHashtableIt res = *this;
+        reverse();
+        return res;
+    }
+
+private:
+    void
+    init()
+    {
+        _ht = nullptr;
+        _idx = size_t_max;
+    }
+    void
+    deInit()
+    {
+    }
+
+private:
+    OpenHashtable* _ht;
+    size_t _idx;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+OpenHashtableIt
+OpenHashtable::end() const
+{
+    OpenHashtableIt it(this, size_t_max);
+    IFDEBUG(it.setConst(true));
+    return it;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+OpenHashtableIt
+OpenHashtable::end()
+{
+    return OpenHashtableIt(this, size_t_max);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
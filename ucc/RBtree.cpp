@@ -1,5 +1,6 @@
 #include <libutl/libutl.h>
 #include <libutl/MaxObject.h>
+#include <libutl/NodePool.h>
 #include <libutl/RBtree.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -27,6 +28,8 @@ RBtree::steal(Object& rhs_)
     deInit();
     super::steal(rhs);
     _root = rhs._root;
+    _nodePool = rhs._nodePool;
+    rhs._nodePool = nullptr;
     // fix pointers to _leaf
     auto rhsLeaf = &rhs._leaf;
     iterator it = this->begin();
@@ -43,7 +46,7 @@ RBtree::steal(Object& rhs_)
         }
         ++it;
     }
-    rhs.init();
+    rhs.initRoot();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -52,7 +55,10 @@ size_t
 RBtree::innerAllocatedSize() const
 {
     size_t sz = super::innerAllocatedSize();
-    sz += (this->size() + 1) * sizeof(RBtreeNode);
+    if (_nodePool == nullptr)
+        sz += (this->size() + 1) * sizeof(RBtreeNode);
+    else
+        sz += sizeof(NodePool) + _nodePool->innerAllocatedSize();
     return sz;
 }
 
@@ -61,8 +67,36 @@ RBtree::innerAllocatedSize() const
 void
 RBtree::clear()
 {
+    // no objects to delete -> release all nodes at once
+    if ((_nodePool != nullptr) && !isOwner())
+        _root = nullptr;
     super::clear();
-    init();
+    if (_nodePool != nullptr)
+        _nodePool->clear();
+    initRoot();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+RBtree::setNodePool(bool nodePool)
+{
+    ASSERTD(empty());
+    if (nodePool == hasNodePool())
+        return;
+
+    // the root (sentinel) node is allocated in the same way as the others
+    destroyNode(_root);
+    if (nodePool)
+    {
+        _nodePool = new NodePool(sizeof(RBtreeNode));
+    }
+    else
+    {
+        delete _nodePool;
+        _nodePool = nullptr;
+    }
+    initRoot();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -70,7 +104,11 @@ RBtree::clear()
 BinTreeNode*
 RBtree::createNode(const Object* object)
 {
-    BinTreeNode* node = new RBtreeNode(object);
+    BinTreeNode* node;
+    if (_nodePool == nullptr)
+        node = new RBtreeNode(object);
+    else
+        node = _nodePool->create<RBtreeNode>(object);
     node->setLeft(&_leaf);
     node->setRight(&_leaf);
     return node;
@@ -78,6 +116,17 @@ RBtree::createNode(const Object* object)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+RBtree::destroyNode(BinTreeNode* node)
+{
+    if (_nodePool == nullptr)
+        delete node;
+    else
+        _nodePool->destroy(node);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void
 RBtree::resetRoot()
 {
@@ -95,14 +144,28 @@ RBtree::resetRoot()
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void
-RBtree::init()
+RBtree::deInit()
+{
+    // BinTree::deInit() can't free pooled nodes (it doesn't know about the pool)
+    if (_nodePool == nullptr)
+        return;
+    if (isOwner())
+        BinTree::clear(_root);
+    _root = nullptr;
+    delete _nodePool;
+    _nodePool = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+RBtree::initRoot()
 {
     _leaf.setLeft(&_leaf);
     _leaf.setRight(&_leaf);
     _leaf.setColor(RBtreeNode::BLACK);
-    _root = new RBtreeNode(&maxObject, RBtreeNode::BLACK);
-    _root->setLeft(&_leaf);
-    _root->setRight(&_leaf);
+    _root = createNode(&maxObject);
+    static_cast<RBtreeNode*>(_root)->setColor(RBtreeNode::BLACK);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -11,6 +11,10 @@ UTL_NS_BEGIN;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+class NodePool;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /**
    Red/black tree.
 
@@ -54,17 +58,37 @@ public:
     /** Remove all objects from the tree. */
     virtual void clear();
 
+    /**
+       Allocate nodes from a pool that belongs to the tree (see NodePool), or from the global
+       heap.  The tree must be empty.
+    */
+    void setNodePool(bool nodePool);
+
+    /** Determine whether nodes are allocated from a node pool. */
+    bool
+    hasNodePool() const
+    {
+        return (_nodePool != nullptr);
+    }
+
 protected:
     virtual BinTreeNode* createNode(const Object* object);
+    virtual void destroyNode(BinTreeNode* node);
     virtual void resetRoot();
     RBtreeNode _leaf;
 
 private:
-    void init();
     void
-    deInit()
+    init()
     {
+        _nodePool = nullptr;
+        initRoot();
     }
+    void deInit();
+    void initRoot();
+
+private:
+    NodePool* _nodePool;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1,6 +1,7 @@
 #include <libutl/libutl.h>
 #include <libutl/SkipList.h>
 #include <libutl/MaxObject.h>
+#include <libutl/NodePool.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -20,6 +21,7 @@ SkipList::steal(Object& rhs_)
     super::steal(rhs);
     _head = rhs._head;
     _tail = rhs._tail;
+    _nodePools = rhs._nodePools;
     _level = rhs._level;
     _maxLevel = rhs._maxLevel;
 #ifdef UTL_SKIPLIST_RNG
@@ -39,6 +41,19 @@ SkipList::innerAllocatedSize() const
     size_t sz = super::innerAllocatedSize();
     sz += sizeof(SkipListNode); // tail
 
+    // head, pools
+    if (_nodePools != nullptr)
+    {
+        sz += sizeof(SkipListNode) + (_maxLevel * sizeof(SkipListNode*));
+        sz += (_maxLevel + 1) * sizeof(NodePool*);
+        for (uint_t lvl = 0; lvl <= _maxLevel; ++lvl)
+        {
+            if (_nodePools[lvl] != nullptr)
+                sz += sizeof(NodePool) + _nodePools[lvl]->innerAllocatedSize();
+        }
+        return sz;
+    }
+
     // initially count the size of nodes at level 0
     SkipListNode* node;
     for (node = _head; node != _tail; node = node->next(0))
@@ -60,6 +75,31 @@ SkipList::innerAllocatedSize() const
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+SkipList::setNodePool(bool nodePool)
+{
+    ASSERTD(empty());
+    if (nodePool == hasNodePool())
+        return;
+    if (nodePool)
+    {
+        // pools are made as needed (see newNode())
+        _nodePools = new NodePool*[_maxLevel + 1];
+        memset(_nodePools, 0, (_maxLevel + 1) * sizeof(NodePool*));
+    }
+    else
+    {
+        for (uint_t lvl = 0; lvl <= _maxLevel; ++lvl)
+        {
+            delete _nodePools[lvl];
+        }
+        delete[] _nodePools;
+        _nodePools = nullptr;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 Object*
 SkipList::find(const Object& key) const
 {
@@ -173,8 +213,7 @@ SkipList::add(const Object* object)
     ASSERTD(lvl <= _maxLevel);
 
     // make new node
-    uint_t newNodeSize = sizeof(SkipListNode) + (lvl * sizeof(SkipListNode*));
-    SkipListNode* newNode = (SkipListNode*)(new byte_t[newNodeSize]);
+    SkipListNode* newNode = this->newNode(lvl);
     newNode->set(object);
 
     // integrate the new node into the structure
@@ -197,7 +236,7 @@ SkipList::add(const Object* object)
             {
                 if (isOwner())
                     delete object;
-                delete[](byte_t*) newNode;
+                deleteNode(newNode, lvl);
                 return false;
             }
             newNode->setPrev(node);
@@ -216,6 +255,7 @@ SkipList::add(const Object* object)
         }
         _level = lvl;
     }
+    ++_items;
     return true;
 }
 
@@ -259,9 +299,9 @@ SkipList::insert(const Object* object, const BidIt& it_)
     }
 
     // make new node
-    uint_t nodeSize = sizeof(SkipListNode) + (lvl * sizeof(SkipListNode*));
-    node = (SkipListNode*)(new byte_t[nodeSize]);
+    node = newNode(lvl);
     node->set(object, lvl, update);
+    ++_items;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -271,13 +311,29 @@ SkipList::clear()
 {
     // delete all nodes except _head and _tail
     SkipListNode* curNode = _head->next();
-    while (curNode != _tail)
+    if (_nodePools == nullptr)
+    {
+        while (curNode != _tail)
+        {
+            SkipListNode* next = curNode->next();
+            if (isOwner())
+                delete curNode->get();
+            delete[](byte_t*) curNode;
+            curNode = next;
+        }
+    }
+    else
     {
-        SkipListNode* next = curNode->next();
-        if (isOwner())
+        // nodes are released all at once
+        for (; isOwner() && (curNode != _tail); curNode = curNode->next())
+        {
             delete curNode->get();
-        delete curNode;
-        curNode = next;
+        }
+        for (uint_t lvl = 0; lvl <= _maxLevel; ++lvl)
+        {
+            if (_nodePools[lvl] != nullptr)
+                _nodePools[lvl]->clear();
+        }
     }
 
     _tail->_prev = _head;
@@ -366,6 +422,7 @@ SkipList::init(bool owner, bool multiSet, Ordering* ordering, uint_t maxLevel)
     _tail->_object = const_cast<MaxObject*>(&maxObject);
     _tail->_prev = _head;
     _tail->_next[0] = nullptr;
+    _nodePools = nullptr;
 
     // list level = 0 initially
     _level = 0;
@@ -386,6 +443,7 @@ void
 SkipList::deInit()
 {
     clear();
+    setNodePool(false);
     delete[](byte_t*) _head;
     delete[](byte_t*) _tail;
 #ifdef UTL_SKIPLIST_RNG
@@ -492,11 +550,11 @@ SkipList::removeNode(SkipListNode* node, SkipListNode** update)
 {
     // remove the node
     Object* object = node->get();
-    node->remove(_level, update);
+    uint_t nodeLevel = node->remove(_level, update);
     if (isOwner())
         delete object;
     _items--;
-    delete[](byte_t*) node;
+    deleteNode(node, nodeLevel);
 
     // adjust level
     while ((_level > 0) && (_head->next(_level) == _tail))
@@ -507,4 +565,29 @@ SkipList::removeNode(SkipListNode* node, SkipListNode** update)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+SkipListNode*
+SkipList::newNode(uint_t level)
+{
+    size_t nodeSize = sizeof(SkipListNode) + (level * sizeof(SkipListNode*));
+    if (_nodePools == nullptr)
+        return reinterpret_cast<SkipListNode*>(new byte_t[nodeSize]);
+    auto& pool = _nodePools[level];
+    if (pool == nullptr)
+        pool = new NodePool(nodeSize);
+    return reinterpret_cast<SkipListNode*>(pool->alloc());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+SkipList::deleteNode(SkipListNode* node, uint_t level)
+{
+    if (_nodePools == nullptr)
+        delete[](byte_t*) node;
+    else
+        _nodePools[level]->free(node);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 UTL_NS_END;
@@ -17,6 +17,7 @@ UTL_NS_BEGIN;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+class NodePool;
 class SkipListIt;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -73,6 +74,19 @@ public:
 
     virtual size_t innerAllocatedSize() const;
 
+    /**
+       Allocate nodes from pools that belong to the list (one NodePool for each node level), or
+       from the global heap.  The list must be empty.
+    */
+    void setNodePool(bool nodePool);
+
+    /** Determine whether nodes are allocated from node pools. */
+    bool
+    hasNodePool() const
+    {
+        return (_nodePools != nullptr);
+    }
+
     /// \name Searching
     //@{
     virtual Object* find(const Object& key) const;
@@ -215,9 +229,12 @@ private:
                            uint_t findType = find_first,
                            SkipListNode** update = nullptr) const;
     void removeNode(SkipListNode* node, SkipListNode** update);
+    SkipListNode* newNode(uint_t level);
+    void deleteNode(SkipListNode* node, uint_t level);
 
 private:
     SkipListNode *_head, *_tail;
+    NodePool** _nodePools;
     uint_t _level;
     uint_t _maxLevel;
 #ifdef UTL_SKIPLIST_RNG
@@ -23,7 +23,7 @@ SkipListNode::set(const Object* object, uint_t level, SkipListNode** update)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void
+uint_t
 SkipListNode::remove(uint_t level, SkipListNode** update)
 {
     _object = nullptr;
@@ -37,6 +37,7 @@ SkipListNode::remove(uint_t level, SkipListNode** update)
         }
         update[i]->_next[i] = _next[i];
     }
+    return i - 1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -91,8 +91,11 @@ public:
         _prev = node;
     }
 
-    /** Remove self from the list. */
-    void remove(uint_t level, SkipListNode** update);
+    /**
+       Remove self from the list.
+       \return self's level
+    */
+    uint_t remove(uint_t level, SkipListNode** update);
 
 private:
     Object* _object;
@@ -1,4 +1,5 @@
 #include <libutl/libutl.h>
+#include <libutl/MemoryCensus.h>
 #include <libutl/Pair.h>
 #include <libutl/RBtree.h>
 #include <libutl/StringVars.h>
@@ -42,6 +43,14 @@ StringVars::innerAllocatedSize() const
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+StringVars::censusOwned(utl::MemoryCensus& census) const
+{
+    _vars.censusOwned(census);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void
 StringVars::serialize(utl::Stream& stream, uint_t io, uint_t mode)
 {
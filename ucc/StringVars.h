@@ -3,6 +3,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <libutl/Hashtable.h>
+#include <libutl/InternedString.h>
 #include <libutl/Pair.h>
 #include <libutl/SortedCollection.h>
 
@@ -38,6 +39,8 @@ public:
 
     virtual size_t innerAllocatedSize() const;
 
+    virtual void censusOwned(utl::MemoryCensus& census) const;
+
     /** Empty? */
     bool
     empty() const
@@ -112,7 +115,7 @@ public:
     Pair*
     setValue(const char* name, const char* value)
     {
-        return setValue(new String(name, false), new String(value, false));
+        return setValue(InternedString::make(name, strlen(name)), new String(value, false));
     }
 
     /**
@@ -136,7 +139,7 @@ public:
     Pair*
     setValue(const char* name, const String& value)
     {
-        return setValue(new String(name, false), value.clone());
+        return setValue(InternedString::make(name, strlen(name)), value.clone());
     }
 
     /**
@@ -0,0 +1,194 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/TBTreeIt.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Template version of BTree.
+
+   TBTree's main purpose is to minimize the need for typecasts.
+
+   \author Adam McKee
+   \ingroup collection
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class TBTree : public BTree
+{
+    UTL_CLASS_DECL_TPL(TBTree, T, BTree);
+    UTL_CLASS_DEFID;
+
+public:
+    /**
+       Constructor.
+       \param owner \b owner flag
+       \param multiSet (optional : false) \b multiSet flag
+       \param ordering (optional) ordering
+    */
+    TBTree(bool owner, bool multiSet = false, Ordering* ordering = nullptr);
+
+    bool
+    add(const T& object)
+    {
+        return super::add(const_cast<T&>(object));
+    }
+
+    bool
+    add(const T* object)
+    {
+        return super::add(const_cast<T*>(object));
+    }
+
+    void
+    add(const Collection& collection)
+    {
+        super::add(collection);
+    }
+
+    TBTreeIt<T>
+    begin() const
+    {
+        TBTreeIt<T> res;
+        res.copy(BTree::begin());
+        return res;
+    }
+
+    TBTreeIt<T>
+    end() const
+    {
+        TBTreeIt<T> res;
+        res.copy(BTree::end());
+        return res;
+    }
+
+    TBTreeIt<T>
+    begin()
+    {
+        TBTreeIt<T> res;
+        res.copy(BTree::begin());
+        return res;
+    }
+
+    TBTreeIt<T>
+    end()
+    {
+        TBTreeIt<T> res;
+        res.copy(BTree::end());
+        return res;
+    }
+
+    /** See find(). */
+    T*
+    findT(const Object& key) const
+    {
+        return utl::cast<T>(BTree::find(key));
+    }
+
+    TBTreeIt<T>
+    findIt(const Object& key) const
+    {
+        TBTreeIt<T> res;
+        res.copy(BTree::findIt(key));
+        return res;
+    }
+
+    TBTreeIt<T>
+    findIt(const Object& key)
+    {
+        TBTreeIt<T> res;
+        res.copy(BTree::findIt(key));
+        return res;
+    }
+
+    void
+    findFirstIt(const Object& key, BidIt& it, bool insert = false) const
+    {
+        super::findFirstIt(key, it, insert);
+    }
+
+    virtual void
+    findFirstIt(const Object& key, BidIt& it, bool insert = false)
+    {
+        super::findFirstIt(key, it, insert);
+    }
+
+    TBTreeIt<T>
+    findFirstIt(const Object& key, bool insert = false) const
+    {
+        TBTreeIt<T> res;
+        res.copy(BTree::findFirstIt(key, insert));
+        return res;
+    }
+
+    TBTreeIt<T>
+    findFirstIt(const Object& key, bool insert = false)
+    {
+        TBTreeIt<T> res;
+        res.copy(BTree::findFirstIt(key, insert));
+        return res;
+    }
+
+    void
+    findLastIt(const Object& key, BidIt& it) const
+    {
+        super::findLastIt(key, it);
+    }
+
+    virtual void
+    findLastIt(const Object& key, BidIt& it)
+    {
+        super::findLastIt(key, it);
+    }
+
+    TBTreeIt<T>
+    findLastIt(const Object& key) const
+    {
+        TBTreeIt<T> res;
+        res.copy(BTree::findLastIt(key));
+        return res;
+    }
+
+    TBTreeIt<T>
+    findLastIt(const Object& key)
+    {
+        TBTreeIt<T> res;
+        res.copy(BTree::findLastIt(key));
+        return res;
+    }
+
+    bool
+    remove(const Object& key)
+    {
+        return super::remove(key);
+    }
+
+public:
+    typedef T type;
+    typedef TBTreeIt<T> iterator;
+    typedef T* value_type; // for STL
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+TBTree<T>::TBTree(bool owner, bool multiSet, Ordering* ordering)
+    : BTree(owner, multiSet, ordering)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_CLASS_IMPL_TPL(utl::TBTree, T);
@@ -0,0 +1,871 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/String.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// THashMapHash ////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Default hash function for THashMap.
+
+   The generic version is for Object-derived keys, and calls Object::hash().  There are
+   specializations for integral, enumeration, and pointer types (which hash to their own value),
+   and for String (which hashes the characters without a virtual call, and can also hash a
+   <code>const char*</code> the same way).  THashMap mixes the result, so it needn't be uniform.
+
+   \author Adam McKee
+   \ingroup collection
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T, typename Enable = void>
+struct THashMapHash
+{
+    size_t
+    operator()(const T& key) const
+    {
+        return key.hash(size_t_max);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+struct THashMapHash<
+    T,
+    typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value ||
+                            std::is_pointer<T>::value>::type>
+{
+    size_t
+    operator()(T key) const
+    {
+        return (size_t)key;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <>
+struct THashMapHash<String>
+{
+    size_t
+    operator()(const String& key) const
+    {
+        return hash(key.get(), key.length());
+    }
+
+    size_t
+    operator()(const char* key) const
+    {
+        return hash(key, strlen(key));
+    }
+
+    /** FNV-1a hash of the given characters. */
+    static size_t
+    hash(const char* s, size_t len)
+    {
+        uint64_t h = 14695981039346656037ULL;
+        auto ptr = reinterpret_cast<const byte_t*>(s);
+        auto lim = ptr + len;
+        for (; ptr != lim; ++ptr)
+        {
+            h ^= static_cast<uint64_t>(*ptr);
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// THashMapEqual ///////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Default key equality predicate for THashMap.
+
+   Compares a contained key against a search key with <code>operator==</code>.  The search key
+   may be of any type that can be compared with the key type, so (for example) a String-keyed map
+   can be searched with a <code>const char*</code> without constructing a String.
+
+   \author Adam McKee
+   \ingroup collection
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+struct THashMapEqual
+{
+    template <typename U>
+    bool
+    operator()(const T& lhs, const U& rhs) const
+    {
+        return (lhs == rhs);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <>
+struct THashMapEqual<String>
+{
+    bool
+    operator()(const String& lhs, const String& rhs) const
+    {
+        return (lhs.length() == rhs.length()) && (memcmp(lhs.get(), rhs.get(), lhs.length()) == 0);
+    }
+
+    bool
+    operator()(const String& lhs, const char* rhs) const
+    {
+        return (::strcmp(lhs.get(), rhs) == 0);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// THashMapIt //////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   THashMap iterator.
+
+   Like the Object-based iterators (see TFwdIt), a THashMapIt supports get(), the dereference
+   operator, and forward movement; it also has the typedefs needed by the STL.  As with
+   <code>std::unordered_map</code>, an entry is seen as a <code>std::pair\<const K, V\></code>,
+   so its key can't be modified through an iterator.
+
+   \author Adam McKee
+   \ingroup collection
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename MapT, typename EntryT>
+class THashMapIt
+{
+public:
+    /** Constructor. */
+    THashMapIt()
+        : _map(nullptr)
+        , _idx(size_t_max)
+    {
+    }
+
+    /**
+       Constructor.
+       \param map associated map
+       \param idx slot index
+    */
+    THashMapIt(MapT* map, size_t idx)
+        : _map(map)
+        , _idx(idx)
+    {
+    }
+
+    /** Conversion to a const iterator. */
+    template <typename OtherMapT, typename OtherEntryT>
+    operator THashMapIt<OtherMapT, OtherEntryT>() const
+    {
+        return THashMapIt<OtherMapT, OtherEntryT>(_map, _idx);
+    }
+
+    /** Get the current entry (nullptr if at end). */
+    EntryT*
+    get() const
+    {
+        // (an entry is stored as std::pair<K, V>, and seen through the const-key pair type)
+        return (_idx == size_t_max) ? nullptr : reinterpret_cast<EntryT*>(_map->_entries + _idx);
+    }
+
+    /** Get the current entry's key. */
+    const typename MapT::key_type&
+    key() const
+    {
+        ASSERTD(!isEnd());
+        return _map->_entries[_idx].first;
+    }
+
+    /** Get the current entry's value. */
+    auto&
+    value() const
+    {
+        ASSERTD(!isEnd());
+        return get()->second;
+    }
+
+    /** Get the slot index. */
+    size_t
+    getIdx() const
+    {
+        return _idx;
+    }
+
+    /** Determine whether the iterator points to the end of the sequence. */
+    bool
+    isEnd() const
+    {
+        return (_idx == size_t_max);
+    }
+
+    /** Move forward the given number of entries. */
+    void
+    forward(size_t dist = 1)
+    {
+        while ((dist-- > 0) && (_idx != size_t_max))
+        {
+            _idx = _map->nextIdx(_idx);
+        }
+    }
+
+    EntryT& operator*() const
+    {
+        ASSERTD(!isEnd());
+        return *get();
+    }
+
+    EntryT* operator->() const
+    {
+        ASSERTD(!isEnd());
+        return get();
+    }
+
+    THashMapIt&
+    operator++()
+    {
+        forward();
+        return *this;
+    }
+
+    THashMapIt
+    operator++(int)
+    {
+        THashMapIt res = *this;
+        forward();
+        return res;
+    }
+
+    bool
+    operator==(const THashMapIt& rhs) const
+    {
+        return (_idx == rhs._idx);
+    }
+
+    bool
+    operator!=(const THashMapIt& rhs) const
+    {
+        return (_idx != rhs._idx);
+    }
+
+public:
+    // for STL
+    typedef EntryT value_type;
+    typedef EntryT& reference;
+    typedef EntryT* pointer;
+    typedef std::forward_iterator_tag iterator_category;
+    typedef std::ptrdiff_t difference_type;
+
+private:
+    MapT* _map;
+    size_t _idx;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// THashMap ////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Value-based hash map.
+
+   Unlike Hashtable, THashMap doesn't require its keys or values to be Object-derived, and it
+   doesn't box them: each (key, value) pair is stored inline in a single flat array, so adding an
+   entry does no memory allocation (except when the array is grown), and finding an entry makes
+   no virtual calls (unless the key type's hash or equality does).
+
+   Collisions are resolved by linear probing with Robin Hood displacement, and removal shifts
+   following entries back (so there are no tombstones).  A one-byte probe distance is kept for
+   each slot, which lets an unsuccessful search stop as soon as it reaches a slot whose entry is
+   closer to its home slot than the search key would be.
+
+   All lookup functions are templates on the search key's type, so a search key need only be
+   acceptable to \b Hash and \b Eq.  For example, a <code>THashMap\<String, V\></code> can be
+   searched with a <code>const char*</code>.
+
+   Adding or removing entries invalidates iterators, except that removeIt() updates the given
+   iterator so it points to the removed entry's successor.
+
+   \author Adam McKee
+   \ingroup collection
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename K,
+          typename V,
+          typename Hash = THashMapHash<K>,
+          typename Eq = THashMapEqual<K>>
+class THashMap
+{
+    friend class THashMapIt<THashMap, std::pair<const K, V>>;
+    friend class THashMapIt<const THashMap, const std::pair<const K, V>>;
+
+public:
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef std::pair<const K, V> value_type;
+    typedef THashMapIt<THashMap, value_type> iterator;
+    typedef THashMapIt<const THashMap, const value_type> const_iterator;
+
+public:
+    /**
+       Constructor.
+       \param size (optional : 0) initial number of entries to make room for
+       \param maxLF (optional : 85) maximum load factor
+    */
+    THashMap(size_t size = 0, uint_t maxLF = 85);
+
+    /** Copy constructor. */
+    THashMap(const THashMap& rhs);
+
+    /** Move constructor. */
+    THashMap(THashMap&& rhs) noexcept;
+
+    /** Destructor. */
+    ~THashMap()
+    {
+        excise();
+    }
+
+    /** Copy assignment. */
+    THashMap& operator=(const THashMap& rhs);
+
+    /** Move assignment. */
+    THashMap& operator=(THashMap&& rhs) noexcept;
+
+    /// \name Accessors
+    //@{
+    /** Determine whether the map is empty. */
+    bool
+    empty() const
+    {
+        return (_items == 0);
+    }
+
+    /** Get the number of contained entries. */
+    size_t
+    items() const
+    {
+        return _items;
+    }
+
+    /** Get the number of contained entries. */
+    size_t
+    size() const
+    {
+        return _items;
+    }
+
+    /** Get the number of slots. */
+    size_t
+    capacity() const
+    {
+        return _numSlots;
+    }
+
+    /** Get the amount of memory allocated by the map itself (not counting keys' or values'). */
+    size_t
+    innerAllocatedSize() const
+    {
+        return _numSlots * (sizeof(entry_t) + 1);
+    }
+    //@}
+
+    /// \name Searching
+    //@{
+    /** Find the entry with the given key (end() if none). */
+    template <typename KeyT>
+    iterator
+    find(const KeyT& key)
+    {
+        return iterator(this, findIdx(key));
+    }
+
+    /** Find the entry with the given key (end() if none). */
+    template <typename KeyT>
+    const_iterator
+    find(const KeyT& key) const
+    {
+        return const_iterator(this, findIdx(key));
+    }
+
+    /** Determine whether an entry with the given key exists. */
+    template <typename KeyT>
+    bool
+    has(const KeyT& key) const
+    {
+        return (findIdx(key) != size_t_max);
+    }
+
+    /** Get the value for the given key (nullptr if none). */
+    template <typename KeyT>
+    V*
+    get(const KeyT& key)
+    {
+        auto idx = findIdx(key);
+        return (idx == size_t_max) ? nullptr : &_entries[idx].second;
+    }
+
+    /** Get the value for the given key (nullptr if none). */
+    template <typename KeyT>
+    const V*
+    get(const KeyT& key) const
+    {
+        auto idx = findIdx(key);
+        return (idx == size_t_max) ? nullptr : &_entries[idx].second;
+    }
+    //@}
+
+    /// \name Adding Entries
+    //@{
+    /**
+       Add an entry, unless the key is already present.
+       \return true if the entry was added, false if the key was already present
+    */
+    bool
+    add(K key, V value)
+    {
+        if (findIdx(key) != size_t_max)
+            return false;
+        insert(std::move(key), std::move(value));
+        return true;
+    }
+
+    /**
+       Add an entry, or replace the value of the existing entry with the same key.
+       \return true if the entry was added, false if an existing value was replaced
+    */
+    bool
+    addOrUpdate(K key, V value)
+    {
+        auto idx = findIdx(key);
+        if (idx != size_t_max)
+        {
+            _entries[idx].second = std::move(value);
+            return false;
+        }
+        insert(std::move(key), std::move(value));
+        return true;
+    }
+
+    /**
+       Find the value for the given key, adding an entry with a default-constructed value if
+       the key isn't present.
+    */
+    template <typename KeyT>
+    V&
+    operator[](const KeyT& key)
+    {
+        auto idx = findIdx(key);
+        if (idx == size_t_max)
+            idx = insert(K(key), V());
+        return _entries[idx].second;
+    }
+
+    /** Grow the map to a size large enough to contain the given number of entries. */
+    void reserve(size_t reqSize);
+    //@}
+
+    /// \name Removing Entries
+    //@{
+    /** Remove all entries. */
+    void clear();
+
+    /** Remove all entries, and free the slot array. */
+    void excise();
+
+    /**
+       Remove the entry with the given key.
+       \return true if the entry was found and removed, false otherwise
+    */
+    template <typename KeyT>
+    bool
+    remove(const KeyT& key)
+    {
+        auto idx = findIdx(key);
+        if (idx == size_t_max)
+            return false;
+        remove(idx);
+        return true;
+    }
+
+    /**
+       Remove the entry the given iterator points to.  The iterator will be updated so that it
+       points to the removed entry's successor.
+    */
+    void
+    removeIt(iterator& it)
+    {
+        ASSERTD(!it.isEnd());
+        auto idx = it.getIdx();
+        remove(idx);
+        if (_dist[idx] == 0)
+            it.forward();
+    }
+    //@}
+
+    /// \name Iterators
+    //@{
+    iterator
+    begin()
+    {
+        return iterator(this, nextIdx(size_t_max));
+    }
+
+    iterator
+    end()
+    {
+        return iterator(this, size_t_max);
+    }
+
+    const_iterator
+    begin() const
+    {
+        return const_iterator(this, nextIdx(size_t_max));
+    }
+
+    const_iterator
+    end() const
+    {
+        return const_iterator(this, size_t_max);
+    }
+    //@}
+
+private:
+    // entries are stored with a mutable key, so they can be moved around within the slot array
+    typedef std::pair<K, V> entry_t;
+    static_assert(sizeof(entry_t) == sizeof(value_type), "entry_t and value_type must match");
+
+private:
+    template <typename KeyT>
+    size_t findIdx(const KeyT& key) const;
+
+    size_t insert(K&& key, V&& value);
+
+    void remove(size_t idx);
+
+    void rehash(size_t capacity);
+
+    size_t
+    nextIdx(size_t idx) const
+    {
+        for (++idx; idx < _numSlots; ++idx)
+        {
+            if (_dist[idx] != 0)
+                return idx;
+        }
+        return size_t_max;
+    }
+
+    template <typename KeyT>
+    size_t
+    hash(const KeyT& key) const
+    {
+        // murmur3 finalizer: spread every bit of the key's hash over the whole word
+        uint64_t h = _hash(key);
+        h ^= (h >> 33);
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= (h >> 33);
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= (h >> 33);
+        return h;
+    }
+
+    size_t
+    home(size_t h) const
+    {
+        return h & (_capacity - 1);
+    }
+
+    static size_t
+    overflowFor(size_t capacity)
+    {
+        size_t lg = 0;
+        while ((capacity >>= 1) != 0)
+            ++lg;
+        return max((size_t)32, lg * 8);
+    }
+
+private:
+    // probe distance is limited to what fits into a byte (0 means the slot is empty)
+    static constexpr size_t max_dist = 254;
+
+private:
+    Hash _hash;
+    Eq _eq;
+    entry_t* _entries;
+    byte_t* _dist;
+    size_t _capacity;
+    size_t _numSlots;
+    size_t _items;
+    size_t _limit;
+    uint_t _maxLF;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename K, typename V, typename Hash, typename Eq>
+THashMap<K, V, Hash, Eq>::THashMap(size_t size, uint_t maxLF)
+    : _entries(nullptr)
+    , _dist(nullptr)
+    , _capacity(0)
+    , _numSlots(0)
+    , _items(0)
+    , _limit(0)
+    , _maxLF(maxLF)
+{
+    ASSERTD((maxLF > 0) && (maxLF < 100));
+    reserve(size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename K, typename V, typename Hash, typename Eq>
+THashMap<K, V, Hash, Eq>::THashMap(const THashMap& rhs)
+    : THashMap(rhs._items, rhs._maxLF)
+{
+    *this = rhs;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename K, typename V, typename Hash, typename Eq>
+THashMap<K, V, Hash, Eq>::THashMap(THashMap&& rhs) noexcept
+    : THashMap(0, rhs._maxLF)
+{
+    *this = std::move(rhs);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename K, typename V, typename Hash, typename Eq>
+THashMap<K, V, Hash, Eq>&
+THashMap<K, V, Hash, Eq>::operator=(const THashMap& rhs)
+{
+    if (&rhs == this)
+        return *this;
+    clear();
+    reserve(rhs._items);
+    for (auto& entry : rhs)
+    {
+        insert(K(entry.first), V(entry.second));
+    }
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename K, typename V, typename Hash, typename Eq>
+THashMap<K, V, Hash, Eq>&
+THashMap<K, V, Hash, Eq>::operator=(THashMap&& rhs) noexcept
+{
+    if (&rhs == this)
+        return *this;
+    excise();
+    std::swap(_entries, rhs._entries);
+    std::swap(_dist, rhs._dist);
+    std::swap(_capacity, rhs._capacity);
+    std::swap(_numSlots, rhs._numSlots);
+    std::swap(_items, rhs._items);
+    std::swap(_limit, rhs._limit);
+    _maxLF = rhs._maxLF;
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename K, typename V, typename Hash, typename Eq>
+void
+THashMap<K, V, Hash, Eq>::reserve(size_t reqSize)
+{
+    if (reqSize <= _limit)
+        return;
+
+    // smallest power-of-2 capacity where the map is no more than maxLF % full with reqSize entries
+    size_t newCapacity = (double)reqSize * (100.0 / (double)_maxLF) + 1.0;
+    rehash(max(nextPow2(newCapacity), (size_t)16));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename K, typename V, typename Hash, typename Eq>
+void
+THashMap<K, V, Hash, Eq>::clear()
+{
+    if (_items == 0)
+        return;
+    for (size_t idx = 0; idx != _numSlots; ++idx)
+    {
+        if (_dist[idx] == 0)
+            continue;
+        _entries[idx].~entry_t();
+        _dist[idx] = 0;
+    }
+    _items = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename K, typename V, typename Hash, typename Eq>
+void
+THashMap<K, V, Hash, Eq>::excise()
+{
+    clear();
+    free(_entries);
+    free(_dist);
+    _entries = nullptr;
+    _dist = nullptr;
+    _capacity = 0;
+    _numSlots = 0;
+    _limit = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename K, typename V, typename Hash, typename Eq>
+template <typename KeyT>
+size_t
+THashMap<K, V, Hash, Eq>::findIdx(const KeyT& key) const
+{
+    if (_items == 0)
+        return size_t_max;
+
+    // the key can't be any further from home than the entry we're looking at
+    auto pos = home(hash(key));
+    for (size_t dist = 1; _dist[pos] >= dist; ++pos, ++dist)
+    {
+        if ((_dist[pos] == dist) && _eq(_entries[pos].first, key))
+            return pos;
+    }
+    return size_t_max;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#undef new
+template <typename K, typename V, typename Hash, typename Eq>
+size_t
+THashMap<K, V, Hash, Eq>::insert(K&& key, V&& value)
+{
+    // grow if necessary
+    if (_items >= _limit)
+        rehash(max(_capacity * 2, (size_t)16));
+
+    // find the first empty slot at or after home, and make more room if that slot doesn't exist
+    // or if any probe distance could become too large to record
+    auto h = hash(key);
+    size_t pos, end;
+    while (true)
+    {
+        pos = home(h);
+        byte_t runMaxDist = 0;
+        for (end = pos; (end < _numSlots) && (_dist[end] != 0); ++end)
+            runMaxDist = max(runMaxDist, _dist[end]);
+        if ((end < _numSlots) && ((end - pos) < max_dist) && (runMaxDist < max_dist))
+            break;
+        rehash(_capacity * 2);
+    }
+
+    // Robin Hood: walk toward end, taking the place of any entry that is closer to its home
+    entry_t cur(std::move(key), std::move(value));
+    size_t res = size_t_max;
+    size_t dist = 1;
+    for (; pos != end; ++pos, ++dist)
+    {
+        size_t slotDist = _dist[pos];
+        if (slotDist < dist)
+        {
+            std::swap(cur, _entries[pos]);
+            _dist[pos] = (byte_t)dist;
+            dist = slotDist;
+            if (res == size_t_max)
+                res = pos;
+        }
+    }
+    new (_entries + end) entry_t(std::move(cur));
+    _dist[end] = (byte_t)dist;
+    ++_items;
+    return (res == size_t_max) ? end : res;
+}
+#include <libutl/gblnew_macros.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename K, typename V, typename Hash, typename Eq>
+void
+THashMap<K, V, Hash, Eq>::remove(size_t idx)
+{
+    ASSERTD(_dist[idx] != 0);
+    _entries[idx].~entry_t();
+
+    // backward-shift: pull back following entries that aren't in their home slot
+#undef new
+    auto pos = idx;
+    for (auto next = pos + 1; (next < _numSlots) && (_dist[next] > 1); pos = next++)
+    {
+        new (_entries + pos) entry_t(std::move(_entries[next]));
+        _entries[next].~entry_t();
+        _dist[pos] = _dist[next] - 1;
+    }
+#include <libutl/gblnew_macros.h>
+    _dist[pos] = 0;
+    --_items;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename K, typename V, typename Hash, typename Eq>
+void
+THashMap<K, V, Hash, Eq>::rehash(size_t capacity)
+{
+    ASSERTD(capacity == nextPow2(capacity));
+
+    // remember the old arrays
+    auto oldEntries = _entries;
+    auto oldDist = _dist;
+    auto oldNumSlots = _numSlots;
+
+    // allocate new arrays
+    _capacity = capacity;
+    _numSlots = capacity + overflowFor(capacity);
+    _entries = static_cast<entry_t*>(malloc(_numSlots * sizeof(entry_t)));
+    _dist = static_cast<byte_t*>(calloc(_numSlots + 1, 1)); // + sentinel for findIdx()
+    _items = 0;
+    _limit = size_t_max;
+
+    // move entries over
+    for (size_t i = 0; i != oldNumSlots; ++i)
+    {
+        if (oldDist[i] == 0)
+            continue;
+        auto& entry = oldEntries[i];
+        insert(std::move(entry.first), std::move(entry.second));
+        entry.~entry_t();
+    }
+
+    // set _limit based on capacity & max-percentage
+    _limit = (double)_capacity * ((double)_maxLF / 100.0);
+
+    free(oldEntries);
+    free(oldDist);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
@@ -150,7 +150,7 @@ list_serialize(ListNode*& list, ListNode** tail, bool owner, Stream& stream, uin
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void
-list_clear(ListNode*& list, ListNode** tail, bool owner)
+list_clear(ListNode*& list, ListNode** tail, bool owner, NodePool* pool)
 {
     ListNode* node = list;
     while (node != nullptr)
@@ -159,7 +159,7 @@ list_clear(ListNode*& list, ListNode** tail, bool owner)
         Object* object = node->get();
         if (owner && (object != maxObject))
             delete object;
-        delete node;
+        list_deleteNode(node, pool);
         node = nextNode;
     }
     list = nullptr;
@@ -211,10 +211,14 @@ list_tail(const ListNode* list)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void
-list_add(
-    ListNode*& list, ListNode** tail, const Object* object, bool sorted, const Ordering* ordering)
+list_add(ListNode*& list,
+         ListNode** tail,
+         const Object* object,
+         bool sorted,
+         const Ordering* ordering,
+         NodePool* pool)
 {
-    ListNode* newNode = new ListNode(object);
+    ListNode* newNode = list_newNode(object, pool);
 
     // empty list ?
     if (list == nullptr)
@@ -271,7 +275,8 @@ list_remove(ListNode*& list,
             const Object& key,
             bool owner,
             bool sorted,
-            const Ordering* ordering)
+            const Ordering* ordering,
+            NodePool* pool)
 {
     auto node = list_findNode(list, key, sorted, ordering);
     if (node == nullptr)
@@ -280,7 +285,7 @@ list_remove(ListNode*& list,
     }
     else
     {
-        list_removeNode(list, tail, node, owner);
+        list_removeNode(list, tail, node, owner, pool);
         return true;
     }
 }
@@ -288,7 +293,7 @@ list_remove(ListNode*& list,
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void
-list_removeNode(ListNode*& list, ListNode** tail, ListNode* node, bool owner)
+list_removeNode(ListNode*& list, ListNode** tail, ListNode* node, bool owner, NodePool* pool)
 {
     // removing head node?
     if (node == list)
@@ -310,7 +315,7 @@ list_removeNode(ListNode*& list, ListNode** tail, ListNode* node, bool owner)
 
     // unlink a node and delete it
     node->remove();
-    delete node;
+    list_deleteNode(node, pool);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -3,11 +3,41 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <libutl/ListNode.h>
+#include <libutl/NodePool.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 UTL_NS_BEGIN;
 
+/**
+   Make a new node.
+   \param object the node's object
+   \param pool (optional) node pool to allocate from (nullptr = global heap)
+*/
+inline ListNode*
+list_newNode(const Object* object, NodePool* pool = nullptr)
+{
+    return (pool == nullptr) ? new ListNode(object) : pool->create<ListNode>(object);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Destroy a node that was made by list_newNode().
+   \param node node to destroy
+   \param pool (optional) node pool the node was allocated from
+*/
+inline void
+list_deleteNode(ListNode* node, NodePool* pool = nullptr)
+{
+    if (pool == nullptr)
+        delete node;
+    else
+        pool->destroy(node);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /**
    Compare two lists.
    \return < 0 if self < rhs, 0 if self = rhs, > 0 if self > rhs
@@ -53,8 +83,9 @@ void list_serialize(ListNode*& list,
    \param list head of list to clear
    \param tail tail of list to clear (can be nullptr)
    \param owner (optional : true) ownership flag
+   \param pool (optional) node pool the nodes were allocated from
 */
-void list_clear(ListNode*& list, ListNode** tail, bool owner = true);
+void list_clear(ListNode*& list, ListNode** tail, bool owner = true, NodePool* pool = nullptr);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -92,12 +123,14 @@ const ListNode* list_tail(const ListNode* list);
    \param object object to be added
    \param sorted (optional : true) add in correct order?
    \param ordering (optional) ordering
+   \param pool (optional) node pool to allocate the new node from
 */
 void list_add(ListNode*& list,
               ListNode** tail,
               const Object* object,
               bool sorted = false,
-              const Ordering* ordering = nullptr);
+              const Ordering* ordering = nullptr,
+              NodePool* pool = nullptr);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -110,13 +143,15 @@ void list_add(ListNode*& list,
    \param owner (optional : true) ownership flag
    \param sorted (optional : false) sorted list?
    \param ordering (optional) ordering
+   \param pool (optional) node pool the nodes were allocated from
 */
 bool list_remove(ListNode*& list,
                  ListNode** tail,
                  const Object& key,
                  bool owner = true,
                  bool sorted = false,
-                 const Ordering* ordering = nullptr);
+                 const Ordering* ordering = nullptr,
+                 NodePool* pool = nullptr);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -126,8 +161,10 @@ bool list_remove(ListNode*& list,
    \param tail tail of list (can be nullptr)
    \param node node to be removed
    \param owner ownership flag
+   \param pool (optional) node pool the node was allocated from
 */
-void list_removeNode(ListNode*& list, ListNode** tail, ListNode* node, bool owner);
+void list_removeNode(
+    ListNode*& list, ListNode** tail, ListNode* node, bool owner, NodePool* pool = nullptr);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
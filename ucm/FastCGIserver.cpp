@@ -135,9 +135,14 @@ FCGI_record::serialize(Stream& stream, uint_t io, uint_t)
         header.contentLengthB0 = (contentLength & 0xff);
         header.paddingLength = 0;
         header.reserved = 0;
-        stream.write((byte_t*)&header, sizeof(header));
-        if (contentLength > 0)
-            stream.write(contentData, contentLength);
+
+        // header and content -> one gather write
+        struct iovec iov[2];
+        iov[0].iov_base = &header;
+        iov[0].iov_len = sizeof(header);
+        iov[1].iov_base = contentData;
+        iov[1].iov_len = contentLength;
+        stream.writev(iov, (contentLength > 0) ? 2 : 1);
     }
 }
 
@@ -331,7 +336,8 @@ FastCGIserver::readParams(StringVars& params, MemStream& paramsData)
         else
         {
             // add variable
-            String* name = new String(nameStr, true, false);
+            String* name = InternedString::make(nameStr, nameLen);
+            delete[] nameStr;
             String* value = new String(valueStr, true, false);
             params.setValue(name, value);
         }
@@ -33,13 +33,56 @@ HttpChunkWriter::overflow()
 {
     if (_oBufPos == 0)
         return;
+    ASSERTD(_oBufPos <= KB(64));
+    writeChunk(nullptr, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+HttpChunkWriter::overflowv(const struct iovec* iov, size_t iovcnt)
+{
+    // the buffered output and the blocks go out as a single chunk
+    const size_t maxBlocks = 16;
+    while (iovcnt > maxBlocks)
+    {
+        writeChunk(iov, maxBlocks);
+        iov += maxBlocks;
+        iovcnt -= maxBlocks;
+    }
+    writeChunk(iov, iovcnt);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+HttpChunkWriter::writeChunk(const struct iovec* iov, size_t iovcnt)
+{
     ASSERTD(_stream != nullptr);
+    ASSERTD(iovcnt <= 16);
 
-    // write a chunk
-    ASSERTD(_oBufPos <= KB(64));
-    *_stream << Uint(_oBufPos).toHex() << "\r\n";
-    _stream->write(_oBuf.get(), _oBufPos);
-    *_stream << "\r\n";
+    // chunk size
+    size_t size = _oBufPos;
+    auto iovLim = iov + iovcnt;
+    for (auto iovPtr = iov; iovPtr != iovLim; ++iovPtr)
+    {
+        size += iovPtr->iov_len;
+    }
+    if (size == 0)
+        return;
+
+    // header, buffered output, blocks, trailer -> one gather write
+    String header = Uint(size).toHex() + "\r\n";
+    struct iovec allIOV[19];
+    allIOV[0].iov_base = (void*)header.get();
+    allIOV[0].iov_len = header.length();
+    allIOV[1].iov_base = _oBuf.get();
+    allIOV[1].iov_len = _oBufPos;
+    if (iovcnt > 0)
+        memcpy(allIOV + 2, iov, iovcnt * sizeof(struct iovec));
+    allIOV[iovcnt + 2].iov_base = (void*)"\r\n";
+    allIOV[iovcnt + 2].iov_len = 2;
+    _stream->writev(allIOV, iovcnt + 3);
     _oBufPos = 0;
 }
 
@@ -33,6 +33,10 @@ private:
     virtual void underflow();
 
     virtual void overflow();
+
+    virtual void overflowv(const struct iovec* iov, size_t iovcnt);
+
+    void writeChunk(const struct iovec* iov, size_t iovcnt);
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
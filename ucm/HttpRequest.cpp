@@ -53,7 +53,7 @@ HttpRequest::header(const char* name, const String& value)
     if (pair == nullptr)
     {
         String* valueCopy = value.clone()->assertOwner();
-        pair = new Pair(new String(name, true, true, false), valueCopy);
+        pair = new Pair(InternedString::make(name, strlen(name), false), valueCopy);
         _headersArray += pair;
         _headersHT += pair;
     }
@@ -126,8 +126,7 @@ HttpRequest::execute(Stream& stream) const
         size_t colonIdx = line.find(':');
         if (colonIdx == size_t_max)
             throw StreamErrorEx();
-        String* name = new String(line.subString(0, colonIdx));
-        name->trim();
+        String* name = InternedString::make(line.subString(0, colonIdx).trim());
         String* value = new String(line.subString(colonIdx + 2));
         value->trim();
         response->header(name, value);
@@ -186,8 +185,7 @@ HttpRequest::execute(Stream& stream) const
             size_t colonIdx = line.find(':');
             if (colonIdx == size_t_max)
                 throw StreamErrorEx();
-            String* name = new String(line.subString(0, colonIdx));
-            name->trim();
+            String* name = InternedString::make(line.subString(0, colonIdx).trim());
             String* value = new String(line.subString(colonIdx + 2));
             value->trim();
             response->header(name, value);
@@ -1,5 +1,6 @@
 #include <libutl/libutl.h>
 #include <libutl/LogMgr.h>
+#include <libutl/MemStream.h>
 #include <libutl/NetCmdServer.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -30,4 +31,25 @@ NetCmdServer::clientReadMsg(NetServerClient* client)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+bool
+NetCmdServer::handleMemProfileCmd(NetServerClient* client, const Array& cmd)
+{
+    if (!cmd[0]->isA(String) || (utl::cast<String>(*cmd[0]) != "memProfile"))
+        return false;
+
+    String report;
+#if UTL_GBLNEW_PROFILE
+    bool collapsed = (cmd.items() > 1) && (*cmd[1] == String("collapsed"));
+    MemStream ms;
+    memProfileReport(ms, collapsed ? memprofile_collapsed : memprofile_pprof);
+    report = String(ms.takeString(), true, false);
+#endif
+    Stream& socket = client->socket();
+    report.serializeOut(socket);
+    socket.flush();
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 UTL_NS_END;
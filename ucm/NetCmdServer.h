@@ -34,6 +34,19 @@ public:
     {
     }
 
+protected:
+    /**
+       Handle the \b memProfile command, if that's what the given command is.  A subclass can
+       call this at the start of handleCmd() to let clients fetch an allocation profile report
+       (see utl::memProfileReport()).  The command is <code>["memProfile"]</code> or
+       <code>["memProfile", "collapsed"]</code>, and the report is sent back as a String.  If
+       libutl wasn't built with \c UTL_GBLNEW_PROFILE, the report is empty.
+       \return true if the command was handled, false otherwise
+       \param client client that sent the command
+       \param cmd command
+    */
+    bool handleMemProfileCmd(NetServerClient* client, const Array& cmd);
+
 private:
     virtual void clientReadMsg(NetServerClient* client);
     virtual void handleCmd(NetServerClient* client, const Array& cmd) = 0;
@@ -32,6 +32,7 @@ class QueuedConnection : public utl::Object
 {
     UTL_CLASS_DECL(QueuedConnection, Object);
     UTL_CLASS_NO_COPY;
+    UTL_CLASS_POOLED;
 
 public:
     QueuedConnection(FDstream* socket_, const InetHostAddress& addr_)
@@ -6,6 +6,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <libutl/FDstream.h>
 #include <libutl/SSLsocket.h>
 #include <libutl/String.h>
 #include <openssl/bio.h>
@@ -50,6 +51,11 @@ SSLsocket::open(const InetHostAddress& hostAddr, uint16_t port)
     // enable auto-retry (to simplify reading/writing logic)
     SSL_set_mode(ssl, SSL_MODE_AUTO_RETRY);
 
+#ifdef SSL_OP_ENABLE_KTLS
+    // let the kernel do the encryption if it can (see transferFrom())
+    SSL_set_options(ssl, SSL_OP_ENABLE_KTLS);
+#endif
+
     // set the IP address and port number for the connection
     auto ip_nbo = hostAddr.get();
 #ifdef UTL_ARCH_LITTLE_ENDIAN
@@ -172,6 +178,40 @@ SSLsocket::write(const byte_t* array, size_t num)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+size_t
+SSLsocket::transferFrom(FDstream& src, off_t offset, size_t num)
+{
+    ASSERTD(isOutput());
+#ifdef SSL_OP_ENABLE_KTLS
+    SSL* ssl;
+    BIO_get_ssl(_bio, &ssl);
+    if (BIO_get_ktls_send(SSL_get_wbio(ssl)))
+    {
+        size_t res = 0;
+        while (res != num)
+        {
+            auto numSent = SSL_sendfile(ssl, src.fd(), offset + res, num - res, 0);
+
+            // end of file?
+            if (numSent == 0)
+                break;
+
+            // problem?
+            if (numSent < 0)
+                throwStreamErrorEx();
+
+            // sent <numSent> bytes
+            res += numSent;
+        }
+        return res;
+    }
+#endif
+    // no kTLS -> read and encrypt the file ourselves
+    return super::transferFrom(src, offset, num);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 UTL_NS_END;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
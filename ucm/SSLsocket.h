@@ -61,6 +61,15 @@ public:
 
     virtual void write(const byte_t* array, size_t num);
 
+#if UTL_HOST_TYPE == UTL_HT_UNIX
+    /**
+       Copy part of a file to the connection.  If the kernel is doing the encryption (kTLS), the
+       file is sent with SSL_sendfile() (without copying it through user space); otherwise it's
+       read and encrypted as usual.
+    */
+    virtual size_t transferFrom(FDstream& src, off_t offset, size_t num);
+#endif
+
 private:
     void
     init()
@@ -3,6 +3,7 @@
 #include <libutl/Pair.h>
 #include <libutl/RBtree.h>
 #include <libutl/URI.h>
+#include <libutl/MemoryCensus.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -140,6 +141,20 @@ URI::innerAllocatedSize() const
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+URI::censusOwned(MemoryCensus& census) const
+{
+    const Object* parts[] = {_scheme, _username,  _password,  _hostname, _path,
+                             _filename, _extension, _queryVars, _fragment};
+    for (auto part : parts)
+    {
+        if (part != nullptr)
+            census.add(*part);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 String
 URI::get() const
 {
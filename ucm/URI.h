@@ -72,6 +72,8 @@ public:
 
     virtual size_t innerAllocatedSize() const;
 
+    virtual void censusOwned(MemoryCensus& census) const;
+
     /// \name Getters
     //@{
     /** Relative URI? */
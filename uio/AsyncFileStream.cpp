@@ -0,0 +1,326 @@
+#include <libutl/libutl.h>
+#include <libutl/AsyncFileStream.h>
+
+#if UTL_HOST_TYPE == UTL_HT_UNIX
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_CLASS_IMPL(utl::AsyncFileStream);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct AsyncFileStream::slot_t
+{
+    byte_t* buf;
+    int bufIdx;   // registered buffer index (-1 if we allocated the buffer)
+    uint64_t off; // file offset of the request
+    size_t len;   // length of the request
+    ssize_t res;  // result of the request (bytes transferred, or -errno)
+    bool busy;    // request is in flight?
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+AsyncFileStream::open(
+    const Pathname& path, uint_t mode, uint_t numBufs, size_t bufSize, IOuring* ring)
+{
+    // close any currently open file
+    close();
+
+    // one direction only
+    if ((mode & fs_clobber) != 0)
+        mode = (mode & ~io_rd) | io_wr;
+    ASSERT(((mode & io_rdwr) == io_rd) || ((mode & io_rdwr) == io_wr));
+
+    auto fileStream = new FileStream(path, mode);
+    setStream(fileStream, true, 0, 0);
+    setName(path);
+
+    // engine
+    _numSlots = max(numBufs, 2U);
+    _ring = ring;
+    _ringOwner = (_ring == nullptr);
+    if (_ringOwner)
+        _ring = new IOuring(_numSlots, _numSlots, bufSize);
+
+    // buffers (from the engine's pool if it has any, otherwise our own)
+    _bufSize = (_ring->numBufs() != 0) ? _ring->bufSize() : bufSize;
+    _slots = new slot_t[_numSlots];
+    for (uint_t i = 0; i != _numSlots; ++i)
+    {
+        auto& slot = _slots[i];
+        slot.buf = _ring->takeBuf(slot.bufIdx);
+        if (slot.buf == nullptr)
+            slot.buf = new byte_t[_bufSize];
+        slot.res = 0;
+        slot.busy = false;
+    }
+
+    // start reading ahead (or set up the first output buffer)
+    if ((mode & fs_append) != 0)
+        _off = fileStream->length();
+    else
+        _off = fileStream->tell();
+    if (isInput())
+    {
+        _restart = true;
+    }
+    else
+    {
+        _curSlot = _slots;
+        setBuf(_oBuf, *_curSlot);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+AsyncFileStream::seek(uint64_t offset)
+{
+    flush(io_rdwr);
+    _off = offset;
+    setEOF(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint64_t
+AsyncFileStream::tell() const
+{
+    if (isOutput())
+        return _off + _oBufPos;
+    if (_curSlot != nullptr)
+        return _curSlot->off + _iBufPos;
+    return _restart ? _off : _slots[_slotIdx].off;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BufferedStream&
+AsyncFileStream::flush(uint_t mode)
+{
+    if (_slots == nullptr)
+        return self;
+
+    // discard read-ahead (reading will continue from the current position)
+    if (isInput() && ((mode & io_rd) != 0))
+    {
+        _off = tell();
+        waitIdle();
+        _restart = true;
+        _curSlot = nullptr;
+        _iBufPos = _iBufLim = 0;
+    }
+
+    // write the output buffer, and wait for all writes to complete
+    if (isOutput() && ((mode & io_wr) != 0))
+    {
+        putBits();
+        overflow();
+        waitIdle();
+        for (uint_t i = 0; i != _numSlots; ++i)
+        {
+            auto& slot = _slots[i];
+            if (slot.res >= 0)
+                continue;
+            errno = -slot.res;
+            slot.res = 0;
+            throwStreamErrorEx();
+        }
+    }
+    return self;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+AsyncFileStream::clear()
+{
+    // (flushes output, and waits for requests in flight)
+    super::clear();
+
+    for (uint_t i = 0; i != _numSlots; ++i)
+    {
+        auto& slot = _slots[i];
+        if (slot.bufIdx >= 0)
+            _ring->returnBuf(slot.bufIdx);
+        else
+            delete[] slot.buf;
+    }
+    delete[] _slots;
+    if (_ringOwner)
+        delete _ring;
+    init();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+AsyncFileStream::underflow()
+{
+    ASSERTD(_slots != nullptr);
+    _iBufPos = _iBufLim = 0;
+
+    // (re-)start reading ahead from _off, or re-use the buffer we just finished with
+    if (_restart)
+    {
+        waitIdle();
+        _restart = false;
+        _curSlot = nullptr;
+        for (uint_t i = 0; i != _numSlots; ++i)
+        {
+            submitRead(_slots[(_slotIdx + i) % _numSlots]);
+        }
+    }
+    else if (_curSlot != nullptr)
+    {
+        submitRead(*_curSlot);
+        _curSlot = nullptr;
+    }
+    _ring->submit();
+
+    // wait for the next buffer
+    auto& slot = _slots[_slotIdx];
+    while (slot.busy)
+    {
+        _ring->wait();
+    }
+
+    // error or EOF -> start over (from the same place) next time
+    if (slot.res <= 0)
+    {
+        _off = slot.off;
+        _restart = true;
+        if (slot.res == 0)
+            throwStreamEOFex();
+        errno = -slot.res;
+        throwStreamErrorEx();
+    }
+    _slotIdx = (_slotIdx + 1) % _numSlots;
+
+    // short read (reached EOF) -> the buffers after this one hold nothing
+    if ((size_t)slot.res < _bufSize)
+    {
+        _off = slot.off + slot.res;
+        _restart = true;
+    }
+
+    _curSlot = &slot;
+    setBuf(_iBuf, slot);
+    _iBufLim = slot.res;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+AsyncFileStream::overflow()
+{
+    if (_oBufPos == 0)
+        return;
+    ASSERTD(_curSlot != nullptr);
+
+    // write the buffer
+    auto& slot = *_curSlot;
+    slot.off = _off;
+    slot.len = _oBufPos;
+    slot.busy = true;
+    _ring->write(fd(), slot.buf, slot.len, slot.off,
+                 [&slot](ssize_t res) {
+                     // (a short write to a disk file means it's out of space)
+                     if ((res >= 0) && ((size_t)res != slot.len))
+                         res = -ENOSPC;
+                     slot.res = res;
+                     slot.busy = false;
+                 },
+                 slot.bufIdx);
+    _ring->submit();
+    _off += _oBufPos;
+    _oBufPos = 0;
+
+    // fill the next buffer (once it's free)
+    _slotIdx = (_slotIdx + 1) % _numSlots;
+    auto& next = _slots[_slotIdx];
+    while (next.busy)
+    {
+        _ring->wait();
+    }
+    _curSlot = &next;
+    setBuf(_oBuf, next);
+    if (next.res < 0)
+    {
+        errno = -next.res;
+        next.res = 0;
+        throwStreamErrorEx();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+AsyncFileStream::init()
+{
+    _ring = nullptr;
+    _ringOwner = false;
+    _slots = nullptr;
+    _numSlots = 0;
+    _slotIdx = 0;
+    _curSlot = nullptr;
+    _bufSize = 0;
+    _off = 0;
+    _restart = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+AsyncFileStream::submitRead(slot_t& slot)
+{
+    slot.off = _off;
+    slot.len = _bufSize;
+    slot.busy = true;
+    _ring->read(fd(), slot.buf, slot.len, slot.off,
+                [&slot](ssize_t res) {
+                    slot.res = res;
+                    slot.busy = false;
+                },
+                slot.bufIdx);
+    _off += _bufSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+AsyncFileStream::waitIdle()
+{
+    for (uint_t i = 0; i != _numSlots; ++i)
+    {
+        auto& slot = _slots[i];
+        while (slot.busy)
+        {
+            _ring->wait();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+AsyncFileStream::setBuf(Vector<byte_t>& buf, slot_t& slot)
+{
+    buf.excise();
+    buf.set(slot.buf, _bufSize, false, 1);
+    bufsChanged();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // UTL_HOST_TYPE == UTL_HT_UNIX
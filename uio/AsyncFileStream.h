@@ -0,0 +1,162 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if UTL_HOST_TYPE == UTL_HT_UNIX
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/BufferedStream.h>
+#include <libutl/FileStream.h>
+#include <libutl/IOuring.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Asynchronous (read-ahead / write-behind) disk file stream.
+
+   AsyncFileStream is a BufferedStream that keeps several buffers' worth of I/O in flight through
+   an IOuring engine.  When reading, it asks for the next few buffers of the file before they're
+   needed, so that a read rarely has to wait for the device.  When writing, a full buffer is
+   handed to the kernel and the stream goes on filling the next one.  flush() waits for all
+   outstanding writes to finish.
+
+   A stream either reads or writes (its mode is io_rd or io_wr).  Streams can share an engine (so
+   that their requests are submitted together), or each can have its own.  If the engine has a
+   pool of registered buffers, the stream takes its buffers from the pool.
+
+   \author Adam McKee
+   \ingroup io
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class AsyncFileStream : public BufferedStream
+{
+    UTL_CLASS_DECL(AsyncFileStream, BufferedStream);
+    UTL_CLASS_NO_COPY;
+
+public:
+    /**
+       Constructor.
+       \param path file pathname
+       \param mode (optional : io_rd) io_rd, or io_wr (possibly with utl::fs_flags_t flags)
+       \param numBufs (optional : 4) number of buffers (and the maximum number of requests in
+                      flight)
+       \param bufSize (optional : 64 KB) buffer size (ignored if the engine has a buffer pool)
+       \param ring (optional) engine to use (if nullptr, the stream makes its own)
+    */
+    AsyncFileStream(const Pathname& path,
+                    uint_t mode = io_rd,
+                    uint_t numBufs = 4,
+                    size_t bufSize = KB(64),
+                    IOuring* ring = nullptr)
+    {
+        init();
+        open(path, mode, numBufs, bufSize, ring);
+    }
+
+    /**
+       Close the currently open file, and open a new file.
+       \param path file pathname
+       \param mode (optional : io_rd) io_rd, or io_wr (possibly with utl::fs_flags_t flags)
+       \param numBufs (optional : 4) number of buffers (and the maximum number of requests in
+                      flight)
+       \param bufSize (optional : 64 KB) buffer size (ignored if the engine has a buffer pool)
+       \param ring (optional) engine to use (if nullptr, the stream makes its own)
+    */
+    void open(const Pathname& path,
+              uint_t mode = io_rd,
+              uint_t numBufs = 4,
+              size_t bufSize = KB(64),
+              IOuring* ring = nullptr);
+
+    /** Get the engine. */
+    IOuring*
+    ring() const
+    {
+        return _ring;
+    }
+
+    /** Get the file descriptor. */
+    int
+    fd() const
+    {
+        return pget()->fd();
+    }
+
+    /** Get the file length. */
+    size_t
+    length() const
+    {
+        return pget()->length();
+    }
+
+    /** Seek to the start of the file. */
+    void
+    rewind()
+    {
+        seek(0);
+    }
+
+    /**
+       Seek to the given file offset (any read-ahead is discarded, and pending writes are
+       completed first).
+    */
+    void seek(uint64_t offset);
+
+    /** Get the current position. */
+    uint64_t tell() const;
+
+    virtual BufferedStream& flush(uint_t mode = io_wr);
+
+protected:
+    virtual void clear();
+
+    virtual void underflow();
+
+    virtual void overflow();
+
+private:
+    struct slot_t;
+
+private:
+    void init();
+    void
+    deInit()
+    {
+        clear();
+    }
+    FileStream*
+    pget() const
+    {
+        ASSERTD(_stream != nullptr);
+        return utl::cast<FileStream>(_stream);
+    }
+    void submitRead(slot_t& slot);
+    void waitIdle();
+    void setBuf(Vector<byte_t>& buf, slot_t& slot);
+
+private:
+    IOuring* _ring;
+    bool _ringOwner;
+    slot_t* _slots;
+    uint_t _numSlots;
+    uint_t _slotIdx;
+    slot_t* _curSlot;
+    size_t _bufSize;
+    uint64_t _off;
+    bool _restart;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // UTL_HOST_TYPE == UTL_HT_UNIX
@@ -26,6 +26,26 @@ BufferedFDstream::blockRead(uint32_t usec)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+BufferedFDstream::overflowv(const struct iovec* iov, size_t iovcnt)
+{
+    // the output buffer goes in front of the first few blocks
+    const size_t maxBlocks = 16;
+    struct iovec allIOV[maxBlocks];
+    size_t num = min(iovcnt, maxBlocks - 1);
+    allIOV[0].iov_base = _oBuf.get();
+    allIOV[0].iov_len = _oBufPos;
+    memcpy(allIOV + 1, iov, num * sizeof(struct iovec));
+    pget()->writev(allIOV, num + 1);
+    _oBufPos = 0;
+
+    // write any remaining blocks
+    if (num < iovcnt)
+        pget()->writev(iov + num, iovcnt - num);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 BufferedFDstream cin(0, io_rd);
 BufferedFDstream cout(1, io_wr);
 BufferedFDstream cerr(2, io_wr);
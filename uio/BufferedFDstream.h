@@ -67,6 +67,10 @@ public:
 #if UTL_HOST_TYPE == UTL_HT_UNIX
     bool blockRead(uint32_t usec = 0);
 #endif
+protected:
+    /** Write the buffered output and the given blocks with FDstream::writev(). */
+    virtual void overflowv(const struct iovec* iov, size_t iovcnt);
+
 private:
     const FDstream*
     pget() const
@@ -23,6 +23,7 @@ BufferedStream::copy(const Object& rhs)
     _oBufPos = stream._oBufPos;
     _oBuf = stream._oBuf;
     _stream = stream._stream;
+    bufsChanged();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -112,6 +113,9 @@ BufferedStream::setError(bool error)
         super::setError(error);
     else
         _stream->setError(error);
+
+    // Stream::put() mustn't write to the buffer while there's an error
+    _oBufSize = error ? 0 : _oBuf.size();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -223,75 +227,21 @@ BufferedStream::readLine(String& p_str)
             if (_iBufPos == _iBufLim)
                 underflow();
 
-            // define the range of characters to be consumed: [start,end)
+            // the characters to be consumed are [start,end) (plus the terminator if we found it)
             byte_t* start = _iBuf.get() + _iBufPos;
-            byte_t* end = start;
             byte_t* lim = _iBuf.get() + _iBufLim;
-
-            // search 8 bytes at a time
-            for (byte_t* endPlus8 = end + 8; endPlus8 <= lim; endPlus8 += 8)
-            {
-                byte_t c;
-                c = *end;
-                if ((c == 0) || (c == '\n'))
-                    goto found;
-                ++end;
-                c = *end;
-                if ((c == 0) || (c == '\n'))
-                    goto found;
-                ++end;
-                c = *end;
-                if ((c == 0) || (c == '\n'))
-                    goto found;
-                ++end;
-                c = *end;
-                if ((c == 0) || (c == '\n'))
-                    goto found;
-                ++end;
-                c = *end;
-                if ((c == 0) || (c == '\n'))
-                    goto found;
-                ++end;
-                c = *end;
-                if ((c == 0) || (c == '\n'))
-                    goto found;
-                ++end;
-                c = *end;
-                if ((c == 0) || (c == '\n'))
-                    goto found;
-                ++end;
-                c = *end;
-                if ((c == 0) || (c == '\n'))
-                    goto found;
-                ++end;
-            }
-
-            // one char at a time for the remainder
-            for (; end < lim; ++end)
-            {
-                if ((*end == '\0') || (*end == '\n'))
-                    goto found;
-            }
-
-            // set done flag
-            goto notfound;
-        found:
-            done = true;
-            ++end;
-        notfound:
+            auto end = findLineEnd(start, lim);
+            done = (end != lim);
 
             // consume the characters from the input buffer
             size_t copyLen = (end - start);
-            _iBufPos += copyLen;
+            _iBufPos += copyLen + (done ? 1 : 0);
 
-            if (done)
+            // the whole line was in the buffer?
+            if (done && (str == nullptr))
             {
-                --copyLen;
-                if (str == nullptr)
-                {
-                    p_str.set(reinterpret_cast<char*>(start), true, true, copyLen);
-                    return self;
-                }
+                p_str.set(reinterpret_cast<char*>(start), true, true, copyLen);
+                return self;
             }
 
             // grow the character array to receive the data
@@ -328,6 +278,60 @@ BufferedStream::readLine(String& p_str)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+size_t
+BufferedStream::readLineView(const char*& line)
+{
+    ASSERTD(isInput());
+
+    // read more data if we ran out
+    if (_iBufPos == _iBufLim)
+        underflow();
+
+    // the whole line is in the buffer -> return a pointer to it
+    byte_t* start = _iBuf.get() + _iBufPos;
+    byte_t* lim = _iBuf.get() + _iBufLim;
+    auto end = findLineEnd(start, lim);
+    if (end != lim)
+    {
+        _iBufPos += (end - start) + 1;
+        line = reinterpret_cast<const char*>(start);
+        return (end - start);
+    }
+
+    // the line crosses the end of the buffer -> collect it in _lineBuf
+    size_t len = 0;
+    for (;;)
+    {
+        size_t copyLen = (end - start);
+        _lineBuf.grow(len + copyLen, size_t_max);
+        memcpy(_lineBuf.get() + len, start, copyLen);
+        len += copyLen;
+        if (end != lim)
+        {
+            _iBufPos += copyLen + 1;
+            break;
+        }
+
+        // read more data (EOF -> the last line has no terminator)
+        _iBufPos = _iBufLim;
+        try
+        {
+            underflow();
+        }
+        catch (StreamEOFex&)
+        {
+            break;
+        }
+        start = _iBuf.get();
+        lim = start + _iBufLim;
+        end = findLineEnd(start, lim);
+    }
+    line = reinterpret_cast<const char*>(_lineBuf.get());
+    return len;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 size_t
 BufferedStream::read(byte_t* array, size_t maxBytes, size_t minBytes)
 {
@@ -388,29 +392,70 @@ BufferedStream::write(const byte_t* array, size_t num)
     // can't be an error
     checkOK();
 
+    // (re-)enable Stream::put()'s direct access to the output buffer
+    _oBufSize = _oBuf.size();
+
     _outCount += num;
-    byte_t* oBufPtr = _oBuf.get() + _oBufPos;
-    byte_t* oBufLim = _oBuf.get() + _oBuf.size();
-    const byte_t* arrayPtr = array;
-    const byte_t* arrayLim = array + num;
-    while (arrayPtr < arrayLim)
+    copyOut(array, num);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+BufferedStream::writev(const struct iovec* iov, size_t iovcnt)
+{
+    ASSERTD(isOutput());
+
+    // can't be an error
+    checkOK();
+
+    // total size of the blocks
+    auto iovLim = iov + iovcnt;
+    size_t num = 0;
+    for (auto iovPtr = iov; iovPtr != iovLim; ++iovPtr)
     {
-        size_t curNum = min(oBufLim - oBufPtr, arrayLim - arrayPtr);
-        memcpy(oBufPtr, arrayPtr, curNum);
-        arrayPtr += curNum;
-        oBufPtr += curNum;
-        if (oBufPtr == oBufLim)
+        num += iovPtr->iov_len;
+    }
+    _outCount += num;
+
+    // blocks fit in the output buffer -> copy them
+    if (num < (_oBuf.size() - _oBufPos))
+    {
+        for (auto iovPtr = iov; iovPtr != iovLim; ++iovPtr)
         {
-            _oBufPos = _oBuf.size();
-            overflow();
-            oBufPtr = _oBuf.get();
+            copyOut(static_cast<const byte_t*>(iovPtr->iov_base), iovPtr->iov_len);
         }
+        return;
     }
-    _oBufPos = oBufPtr - _oBuf.get();
+
+    // write the buffered output along with the blocks
+    putBits();
+    _oBufSize = 0;
+    overflowv(iov, iovcnt);
+    _oBufSize = _oBuf.size();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#if UTL_HOST_TYPE == UTL_HT_UNIX
+size_t
+BufferedStream::transferFrom(FDstream& src, off_t offset, size_t num)
+{
+    ASSERTD(isOutput());
+    ASSERTD(_stream != nullptr);
+    checkOK();
+    putBits();
+    _oBufSize = 0;
+    overflow();
+    _oBufSize = _oBuf.size();
+    size_t res = _stream->transferFrom(src, offset, num);
+    _outCount += res;
+    return res;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 BufferedStream&
 BufferedStream::flush(uint_t mode)
 {
@@ -421,7 +466,11 @@ BufferedStream::flush(uint_t mode)
     if (isOutput() && ((mode & io_wr) != 0))
     {
         putBits();
+
+        // if the write fails, Stream::put() goes through write() (and checkOK()) from now on
+        _oBufSize = 0;
         overflow();
+        _oBufSize = _oBuf.size();
     }
     return self;
 }
@@ -446,6 +495,7 @@ BufferedStream::setInputBuf(size_t size)
         _iBuf.excise();
         _iBuf.setSize(size);
     }
+    bufsChanged();
     _bitMask = 0x80;
     _bitByte = 0;
 }
@@ -461,6 +511,7 @@ BufferedStream::setOutputBuf(size_t size)
         _oBuf.excise();
         _oBuf.setSize(size);
     }
+    bufsChanged();
     _bitMask = 0x80;
     _bitByte = 0;
 }
@@ -511,6 +562,18 @@ BufferedStream::overflow()
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+BufferedStream::overflowv(const struct iovec* iov, size_t iovcnt)
+{
+    auto iovLim = iov + iovcnt;
+    for (; iov != iovLim; ++iov)
+    {
+        copyOut(static_cast<const byte_t*>(iov->iov_base), iov->iov_len);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void
 BufferedStream::init()
 {
@@ -538,6 +601,34 @@ BufferedStream::deInit()
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+BufferedStream::copyOut(const byte_t* array, size_t num)
+{
+    byte_t* oBufPtr = _oBuf.get() + _oBufPos;
+    byte_t* oBufLim = _oBuf.get() + _oBuf.size();
+    const byte_t* arrayPtr = array;
+    const byte_t* arrayLim = array + num;
+    while (arrayPtr < arrayLim)
+    {
+        size_t curNum = min(oBufLim - oBufPtr, arrayLim - arrayPtr);
+        memcpy(oBufPtr, arrayPtr, curNum);
+        arrayPtr += curNum;
+        oBufPtr += curNum;
+        if (oBufPtr == oBufLim)
+        {
+            _oBufPos = _oBuf.size();
+            overflow();
+
+            // (overflow() may have switched to another buffer)
+            oBufPtr = _oBuf.get();
+            oBufLim = oBufPtr + _oBuf.size();
+        }
+    }
+    _oBufPos = oBufPtr - _oBuf.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 UTL_NS_END;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -153,6 +153,17 @@ public:
 
     virtual Stream& readLine(String& str);
 
+    /**
+       Read a line without copying it into a String.  If the whole line is in the input buffer,
+       line points into the buffer, otherwise the line is collected in a buffer that belongs to
+       the stream.  Either way, line is only valid until the next operation on the stream, and it
+       is not nul-terminated.  Like readLine(), a line ends with a newline or nul (which is
+       consumed but not included), and StreamEOFex is thrown if there are no more lines.
+       \return length of the line
+       \param line (out) start of the line
+    */
+    size_t readLineView(const char*& line);
+
     virtual size_t read(byte_t* array, size_t maxBytes, size_t minBytes = size_t_max);
 
     /** Un-get a byte.  You may not un-get more than one byte in a row. */
@@ -225,6 +236,17 @@ public:
     }
 
     virtual void write(const byte_t* array, size_t num);
+
+    /**
+       Write a sequence of blocks of bytes.  Blocks that fit in the output buffer are copied into
+       it, otherwise the buffered output and the blocks are handed to overflowv() together.
+    */
+    virtual void writev(const struct iovec* iov, size_t iovcnt);
+
+#if UTL_HOST_TYPE == UTL_HT_UNIX
+    /** Flush the output buffer, then copy the file with the buffered stream's transferFrom(). */
+    virtual size_t transferFrom(FDstream& src, off_t offset, size_t num);
+#endif
     //@}
 
     /// \name Buffering
@@ -445,14 +467,33 @@ protected:
        Upon return, _oBufPos = 0.
     */
     virtual void overflow();
+
+    /**
+       Write the contents of the output buffer, followed by the given blocks (gather-on-flush).
+       The default implementation copies the blocks through the output buffer.  A derived class
+       whose underlying stream can do a gather write should override this to write everything
+       with one call to writev().
+    */
+    virtual void overflowv(const struct iovec* iov, size_t iovcnt);
     //@}
+
+    /**
+       Update the buffer addresses and sizes that Stream's inline get() and put() use.  This must
+       be called after the storage of _iBuf or _oBuf is changed.
+    */
+    void
+    bufsChanged()
+    {
+        _iBufPtr = _iBuf.get();
+        _oBufPtr = _oBuf.get();
+        _oBufSize = _oBuf.size();
+    }
+
 protected:
-    // input buffer
-    size_t _iBufPos, _iBufLim;
+    // input buffer (_iBufPos and _iBufLim are in Stream)
     Vector<byte_t> _iBuf;
 
-    // output buffer
-    size_t _oBufPos;
+    // output buffer (_oBufPos is in Stream)
     Vector<byte_t> _oBuf;
 
     // buffered stream
@@ -461,6 +502,11 @@ protected:
 private:
     void init();
     void deInit();
+    void copyOut(const byte_t* array, size_t num);
+
+private:
+    // line that crosses the end of the input buffer (for readLineView())
+    Vector<byte_t> _lineBuf;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -10,6 +10,9 @@
 #include <poll.h>
 #include <sys/socket.h>
 #endif
+#if UTL_HOST_OS == UTL_OS_LINUX
+#include <sys/sendfile.h>
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -229,6 +232,122 @@ FDstream::write(const byte_t* array, size_t num)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#if UTL_HOST_TYPE == UTL_HT_UNIX
+void
+FDstream::writev(const struct iovec* p_iov, size_t iovcnt)
+{
+    ASSERTD(isOutput());
+    checkOK();
+    bool nonBlock = !this->blockingIO();
+
+    // make a copy of the blocks that we can adjust after a partial write
+    const size_t maxBlocks = 64;
+    struct iovec iov[maxBlocks];
+    while (iovcnt != 0)
+    {
+        size_t num = min(iovcnt, maxBlocks);
+        memcpy(iov, p_iov, num * sizeof(struct iovec));
+        p_iov += num;
+        iovcnt -= num;
+
+        struct iovec* iovPtr = iov;
+        struct iovec* iovLim = iov + num;
+        while (iovPtr != iovLim)
+        {
+            // skip empty blocks
+            if (iovPtr->iov_len == 0)
+            {
+                ++iovPtr;
+                continue;
+            }
+
+            // block until we can write
+            if (nonBlock)
+                blockWrite();
+
+            // try to write
+            ssize_t numWritten = ::writev(_fd, iovPtr, iovLim - iovPtr);
+            if (numWritten < 0)
+            {
+                // interrupted system call -> just try again
+                if (errno == EINTR)
+                    continue;
+                if (nonBlock && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+                    continue;
+
+                // something went wrong...
+                throwStreamErrorEx();
+            }
+
+            // skip past the blocks that were written (and adjust a partially written one)
+            size_t n = numWritten;
+            while ((iovPtr != iovLim) && (n >= iovPtr->iov_len))
+            {
+                n -= iovPtr->iov_len;
+                ++iovPtr;
+            }
+            if (n != 0)
+            {
+                iovPtr->iov_base = static_cast<byte_t*>(iovPtr->iov_base) + n;
+                iovPtr->iov_len -= n;
+            }
+        }
+    }
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if UTL_HOST_TYPE == UTL_HT_UNIX
+size_t
+FDstream::transferFrom(FDstream& src, off_t offset, size_t num)
+{
+    ASSERTD(isOutput());
+    checkOK();
+#if UTL_HOST_OS == UTL_OS_LINUX
+    bool nonBlock = !this->blockingIO();
+    size_t res = 0;
+    while (res != num)
+    {
+        // block until we can write
+        if (nonBlock)
+            blockWrite();
+
+        // (sendfile(2) transfers at most 0x7ffff000 bytes at a time)
+        off_t off = offset + res;
+        ssize_t numSent = ::sendfile(_fd, src.fd(), &off, min(num - res, (size_t)0x7ffff000));
+        if (numSent > 0)
+        {
+            res += numSent;
+            continue;
+        }
+
+        // end of file?
+        if (numSent == 0)
+            break;
+
+        // interrupted system call -> just try again
+        if (errno == EINTR)
+            continue;
+        if (nonBlock && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+            continue;
+
+        // source can't be used with sendfile(2) -> copy it ourselves
+        if ((res == 0) && ((errno == EINVAL) || (errno == ENOSYS)))
+            return super::transferFrom(src, offset, num);
+
+        // something went wrong...
+        throwStreamErrorEx();
+    }
+    return res;
+#else
+    return super::transferFrom(src, offset, num);
+#endif
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 #if UTL_HOST_TYPE == UTL_HT_UNIX
 void
 FDstream::setBlockingIO(bool v)
@@ -84,6 +84,15 @@ public:
     virtual void write(const byte_t* array, size_t num);
 
 #if UTL_HOST_TYPE == UTL_HT_UNIX
+    /** Write all the blocks with as few writev(2) calls as possible. */
+    virtual void writev(const struct iovec* iov, size_t iovcnt);
+
+    /**
+       Copy part of a file with sendfile(2), which moves the data inside the kernel (no copies
+       through user space).  Falls back to Stream::transferFrom() where that isn't possible.
+    */
+    virtual size_t transferFrom(FDstream& src, off_t offset, size_t num);
+
     /** Is blocking I/O enabled on the file descriptor? */
     bool
     blockingIO() const
@@ -0,0 +1,426 @@
+#include <libutl/libutl.h>
+#include <libutl/Exception.h>
+#include <libutl/IOuring.h>
+
+#if UTL_HOST_TYPE == UTL_HT_UNIX
+
+#include <sys/mman.h>
+#include <sys/uio.h>
+#if UTL_HOST_OS == UTL_OS_LINUX
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// request operations
+enum ioring_op_t
+{
+    ioring_read,
+    ioring_write
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct IOuring::request_t
+{
+    callback_t callback;
+    request_t* next;
+
+    // (io_uring mode only: the buffer, for IORING_OP_READV and IORING_OP_WRITEV)
+    struct iovec iov;
+
+    // (synchronous mode only)
+    int op;
+    int fd;
+    byte_t* buf;
+    size_t len;
+    uint64_t off;
+    ssize_t res;
+    bool done;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IOuring::IOuring(uint_t entries, uint_t numBufs, size_t bufSize)
+    : _fd(-1)
+    , _entries(max(entries, 1U))
+    , _numPending(0)
+    , _numQueued(0)
+    , _sqRing(nullptr)
+    , _sqRingSize(0)
+    , _cqRing(nullptr)
+    , _cqRingSize(0)
+    , _sqes(nullptr)
+    , _syncHead(nullptr)
+    , _syncTail(nullptr)
+    , _bufs(nullptr)
+    , _numBufs(numBufs)
+    , _bufSize(bufSize)
+    , _freeBufs(nullptr)
+    , _numFreeBufs(0)
+    , _fixedBufs(false)
+{
+#if UTL_HOST_OS == UTL_OS_LINUX
+    // set up the rings (if the kernel lets us)
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = syscall(__NR_io_uring_setup, _entries, &params);
+    if (fd >= 0)
+    {
+        _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0)
+            _sqRingSize = _cqRingSize = max(_sqRingSize, _cqRingSize);
+        _sqRing = mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       fd, IORING_OFF_SQ_RING);
+        if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0)
+        {
+            _cqRing = _sqRing;
+        }
+        else if (_sqRing != MAP_FAILED)
+        {
+            _cqRing = mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        }
+        if (_sqRing != MAP_FAILED)
+        {
+            _sqes = mmap(nullptr, params.sq_entries * sizeof(struct io_uring_sqe),
+                         PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                         IORING_OFF_SQES);
+        }
+        if ((_sqRing == MAP_FAILED) || (_cqRing == MAP_FAILED) || (_sqes == MAP_FAILED))
+        {
+            if (_sqRing != MAP_FAILED)
+                munmap(_sqRing, _sqRingSize);
+            if ((_cqRing != MAP_FAILED) && (_cqRing != _sqRing))
+                munmap(_cqRing, _cqRingSize);
+            ::close(fd);
+            _sqRing = _cqRing = _sqes = nullptr;
+        }
+        else
+        {
+            auto sq = static_cast<byte_t*>(_sqRing);
+            auto cq = static_cast<byte_t*>(_cqRing);
+            _fd = fd;
+            _entries = params.sq_entries;
+            _sqHead = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+            _sqTail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+            _sqMask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+            _sqArray = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+            _cqHead = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+            _cqTail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+            _cqMask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+            _cqes = cq + params.cq_off.cqes;
+        }
+    }
+#endif
+
+    // make the requests
+    _reqs = new request_t[_entries];
+    _freeReqs = nullptr;
+    for (uint_t i = _entries; i != 0; --i)
+    {
+        _reqs[i - 1].next = _freeReqs;
+        _freeReqs = _reqs + i - 1;
+    }
+
+    // make the buffers (and register them)
+    if (numBufs == 0)
+        return;
+    _bufs = new byte_t[numBufs * _bufSize];
+    _freeBufs = new int[numBufs];
+    for (uint_t i = 0; i != numBufs; ++i)
+    {
+        _freeBufs[_numFreeBufs++] = numBufs - 1 - i;
+    }
+#if UTL_HOST_OS == UTL_OS_LINUX
+    if (_fd < 0)
+        return;
+    auto iov = new struct iovec[numBufs];
+    for (uint_t i = 0; i != numBufs; ++i)
+    {
+        iov[i].iov_base = _bufs + (i * _bufSize);
+        iov[i].iov_len = _bufSize;
+    }
+    // (registration can fail, e.g. if it would exceed RLIMIT_MEMLOCK)
+    _fixedBufs =
+        (syscall(__NR_io_uring_register, _fd, IORING_REGISTER_BUFFERS, iov, numBufs) == 0);
+    delete[] iov;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IOuring::~IOuring()
+{
+    // the kernel may still be using the buffers
+    waitAll();
+
+#if UTL_HOST_OS == UTL_OS_LINUX
+    if (_fd >= 0)
+    {
+        munmap(_sqes, (_sqMask + 1) * sizeof(struct io_uring_sqe));
+        if (_cqRing != _sqRing)
+            munmap(_cqRing, _cqRingSize);
+        munmap(_sqRing, _sqRingSize);
+        ::close(_fd);
+    }
+#endif
+    delete[] _reqs;
+    delete[] _bufs;
+    delete[] _freeBufs;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+byte_t*
+IOuring::takeBuf(int& idx)
+{
+    if (_numFreeBufs == 0)
+    {
+        idx = -1;
+        return nullptr;
+    }
+    idx = _freeBufs[--_numFreeBufs];
+    return _bufs + (idx * _bufSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+IOuring::returnBuf(int idx)
+{
+    ASSERTD(idx >= 0);
+    _freeBufs[_numFreeBufs++] = idx;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+IOuring::read(
+    int fd, byte_t* buf, size_t len, uint64_t off, const callback_t& callback, int bufIdx)
+{
+    auto req = queue(ioring_read, fd, buf, len, off, bufIdx);
+    req->callback = callback;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+IOuring::write(
+    int fd, const byte_t* buf, size_t len, uint64_t off, const callback_t& callback, int bufIdx)
+{
+    auto req = queue(ioring_write, fd, const_cast<byte_t*>(buf), len, off, bufIdx);
+    req->callback = callback;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint_t
+IOuring::submit()
+{
+    uint_t num = _numQueued;
+    if (num != 0)
+        enter(num, 0);
+    return num;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint_t
+IOuring::wait(uint_t minComplete)
+{
+    minComplete = min(minComplete, _numPending);
+    uint_t num = reap();
+    if ((_numQueued == 0) && (num >= minComplete))
+        return num;
+    enter(_numQueued, minComplete - min(num, minComplete));
+    return num + reap();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+IOuring::waitAll()
+{
+    while (_numPending != 0)
+    {
+        wait(_numPending);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IOuring::request_t*
+IOuring::queue(int op, int fd, byte_t* buf, size_t len, uint64_t off, int bufIdx)
+{
+    // all requests in use -> wait for one to complete
+    while (_freeReqs == nullptr)
+    {
+        wait(1);
+    }
+    auto req = _freeReqs;
+    _freeReqs = req->next;
+    req->next = nullptr;
+    ++_numPending;
+    ++_numQueued;
+
+#if UTL_HOST_OS == UTL_OS_LINUX
+    if (_fd >= 0)
+    {
+        // (the kernel consumes queued entries when they're submitted, so there's always room)
+        uint32_t tail = *_sqTail;
+        uint32_t idx = tail & _sqMask;
+        auto sqe = static_cast<struct io_uring_sqe*>(_sqes) + idx;
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->fd = fd;
+        sqe->off = off;
+        if ((bufIdx >= 0) && _fixedBufs)
+        {
+            sqe->opcode = (op == ioring_read) ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+            sqe->addr = reinterpret_cast<uint64_t>(buf);
+            sqe->len = len;
+            sqe->buf_index = bufIdx;
+        }
+        else
+        {
+            // (IORING_OP_READ and IORING_OP_WRITE need Linux 5.6, the vectored ones only 5.1)
+            req->iov.iov_base = buf;
+            req->iov.iov_len = len;
+            sqe->opcode = (op == ioring_read) ? IORING_OP_READV : IORING_OP_WRITEV;
+            sqe->addr = reinterpret_cast<uint64_t>(&req->iov);
+            sqe->len = 1;
+        }
+        sqe->user_data = reinterpret_cast<uint64_t>(req);
+        _sqArray[idx] = idx;
+        __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+        return req;
+    }
+#endif
+
+    // synchronous mode: append to the list
+    req->op = op;
+    req->fd = fd;
+    req->buf = buf;
+    req->len = len;
+    req->off = off;
+    req->done = false;
+    if (_syncTail == nullptr)
+        _syncHead = req;
+    else
+        _syncTail->next = req;
+    _syncTail = req;
+    return req;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint_t
+IOuring::reap()
+{
+    uint_t num = 0;
+#if UTL_HOST_OS == UTL_OS_LINUX
+    if (_fd >= 0)
+    {
+        uint32_t head = *_cqHead;
+        while (head != __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE))
+        {
+            auto cqe = static_cast<struct io_uring_cqe*>(_cqes) + (head & _cqMask);
+            auto req = reinterpret_cast<request_t*>(cqe->user_data);
+            ssize_t res = cqe->res;
+            __atomic_store_n(_cqHead, ++head, __ATOMIC_RELEASE);
+
+            // free the request before calling back (the callback may queue another)
+            callback_t callback;
+            callback.swap(req->callback);
+            req->next = _freeReqs;
+            _freeReqs = req;
+            --_numPending;
+            ++num;
+            callback(res);
+        }
+        return num;
+    }
+#endif
+
+    // synchronous mode: call back for the completed requests at the head of the list
+    while ((_syncHead != nullptr) && _syncHead->done)
+    {
+        auto req = _syncHead;
+        _syncHead = req->next;
+        if (_syncHead == nullptr)
+            _syncTail = nullptr;
+        ssize_t res = req->res;
+        callback_t callback;
+        callback.swap(req->callback);
+        req->next = _freeReqs;
+        _freeReqs = req;
+        --_numPending;
+        ++num;
+        callback(res);
+    }
+    return num;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+IOuring::enter(uint_t toSubmit, uint_t minComplete)
+{
+#if UTL_HOST_OS == UTL_OS_LINUX
+    if (_fd >= 0)
+    {
+        uint_t flags = (minComplete == 0) ? 0 : IORING_ENTER_GETEVENTS;
+        while ((toSubmit != 0) || (minComplete != 0))
+        {
+            int res = syscall(__NR_io_uring_enter, _fd, toSubmit, minComplete, flags, nullptr, 0);
+            if (res < 0)
+            {
+                // interrupted -> try again (but the submissions may have been consumed)
+                if (errno == EINTR)
+                {
+                    toSubmit = _numQueued = (*_sqTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE));
+                    continue;
+                }
+                errToEx();
+            }
+            _numQueued -= res;
+            toSubmit -= res;
+            if (toSubmit == 0)
+                break;
+        }
+        return;
+    }
+#endif
+
+    // synchronous mode: carry out the queued requests
+    for (auto req = _syncHead; req != nullptr; req = req->next)
+    {
+        if (req->done)
+            continue;
+        ssize_t res;
+        do
+        {
+            if (req->op == ioring_read)
+                res = ::pread(req->fd, req->buf, req->len, req->off);
+            else
+                res = ::pwrite(req->fd, req->buf, req->len, req->off);
+        } while ((res < 0) && (errno == EINTR));
+        req->res = (res < 0) ? -errno : res;
+        req->done = true;
+    }
+    _numQueued = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // UTL_HOST_TYPE == UTL_HT_UNIX
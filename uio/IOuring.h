@@ -0,0 +1,220 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if UTL_HOST_TYPE == UTL_HT_UNIX
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <functional>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Asynchronous file I/O engine.
+
+   IOuring queues reads and writes (at given file offsets), submits any number of them to the
+   kernel with a single system call, and calls a completion function for each one as it finishes.
+   Many requests can be in flight at once, so reading ahead (or writing behind) several buffers
+   keeps a fast device busy without a thread per request.
+
+   An engine can also own a pool of buffers that are registered with the kernel (see takeBuf()),
+   which saves the kernel from mapping the buffer for each request.  Several streams can share one
+   engine (see AsyncFileStream), so that all of their requests are submitted together.
+
+   On Linux, the engine is a thin layer over io_uring.  Where io_uring isn't available (other
+   hosts, older kernels, or a sandbox that forbids it), requests are carried out synchronously
+   with pread(2)/pwrite(2) when they're submitted, and completions are delivered as usual.
+
+   An engine must only be used by one thread at a time.
+
+   \author Adam McKee
+   \ingroup io
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class IOuring
+{
+public:
+    /**
+       Completion function.  Its argument is the number of bytes transferred (or -errno).
+    */
+    typedef std::function<void(ssize_t)> callback_t;
+
+public:
+    /**
+       Constructor.
+       \param entries (optional : 64) maximum number of requests in flight
+       \param numBufs (optional : 0) number of registered buffers
+       \param bufSize (optional : 64 KB) size of each registered buffer
+    */
+    IOuring(uint_t entries = 64, uint_t numBufs = 0, size_t bufSize = KB(64));
+
+    IOuring(const IOuring&) = delete;
+
+    IOuring& operator=(const IOuring&) = delete;
+
+    /** Destructor (waits for requests in flight to complete). */
+    ~IOuring();
+
+    /** Does the engine use io_uring (rather than synchronous I/O)? */
+    bool
+    isAsync() const
+    {
+        return (_fd >= 0);
+    }
+
+    /** Get the number of requests that have been queued or submitted but not completed. */
+    uint_t
+    pending() const
+    {
+        return _numPending;
+    }
+
+    /// \name Registered Buffers
+    //@{
+    /** Get the number of registered buffers (zero if the engine has no buffer pool). */
+    uint_t
+    numBufs() const
+    {
+        return _numBufs;
+    }
+
+    /** Get the size of each registered buffer. */
+    size_t
+    bufSize() const
+    {
+        return _bufSize;
+    }
+
+    /**
+       Take a registered buffer from the pool.
+       \return buffer (nullptr if none is available)
+       \param idx (returned) buffer index (for read() and write())
+    */
+    byte_t* takeBuf(int& idx);
+
+    /** Return a buffer taken by takeBuf() to the pool. */
+    void returnBuf(int idx);
+    //@}
+
+    /// \name Requests
+    //@{
+    /**
+       Queue a read (it isn't started until the next submit() or wait()).
+       \param fd file descriptor
+       \param buf buffer to read into
+       \param len number of bytes to read
+       \param off file offset
+       \param callback completion function
+       \param bufIdx (optional : -1) registered buffer index (-1 if buf isn't registered)
+    */
+    void read(int fd,
+              byte_t* buf,
+              size_t len,
+              uint64_t off,
+              const callback_t& callback,
+              int bufIdx = -1);
+
+    /**
+       Queue a write (it isn't started until the next submit() or wait()).
+       \param fd file descriptor
+       \param buf data to write
+       \param len number of bytes to write
+       \param off file offset
+       \param callback completion function
+       \param bufIdx (optional : -1) registered buffer index (-1 if buf isn't registered)
+    */
+    void write(int fd,
+               const byte_t* buf,
+               size_t len,
+               uint64_t off,
+               const callback_t& callback,
+               int bufIdx = -1);
+
+    /**
+       Submit all queued requests.
+       \return number of requests submitted
+    */
+    uint_t submit();
+
+    /**
+       Submit all queued requests, then wait until at least the given number of requests has
+       completed, calling their completion functions.
+       \return number of completed requests
+       \param minComplete (optional : 1) minimum number of completions to wait for
+    */
+    uint_t wait(uint_t minComplete = 1);
+
+    /**
+       Call the completion functions of requests that have completed (without waiting).
+       \return number of completed requests
+    */
+    uint_t
+    poll()
+    {
+        return wait(0);
+    }
+
+    /** Wait for all pending requests to complete. */
+    void waitAll();
+    //@}
+
+private:
+    struct request_t;
+
+private:
+    request_t* queue(int op, int fd, byte_t* buf, size_t len, uint64_t off, int bufIdx);
+    uint_t reap();
+    void enter(uint_t toSubmit, uint_t minComplete);
+
+private:
+    int _fd;
+    uint_t _entries;
+    uint_t _numPending;
+    uint_t _numQueued;
+
+    // io_uring rings
+    void* _sqRing;
+    size_t _sqRingSize;
+    void* _cqRing;
+    size_t _cqRingSize;
+    void* _sqes;
+    uint32_t* _sqHead;
+    uint32_t* _sqTail;
+    uint32_t _sqMask;
+    uint32_t* _sqArray;
+    uint32_t* _cqHead;
+    uint32_t* _cqTail;
+    uint32_t _cqMask;
+    void* _cqes;
+
+    // requests (_freeReqs is a list of unused ones)
+    request_t* _reqs;
+    request_t* _freeReqs;
+
+    // synchronous mode: queued requests, and completed ones
+    request_t* _syncHead;
+    request_t* _syncTail;
+
+    // registered buffers (_freeBufs is a stack of indexes)
+    byte_t* _bufs;
+    uint_t _numBufs;
+    size_t _bufSize;
+    int* _freeBufs;
+    uint_t _numFreeBufs;
+    bool _fixedBufs;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // UTL_HOST_TYPE == UTL_HT_UNIX
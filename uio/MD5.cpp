@@ -2,6 +2,7 @@
 #include <libutl/String.h>
 #include <libutl/Uint.h>
 #include <libutl/MD5.h>
+#include <libutl/MmapStream.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -190,6 +191,16 @@ MD5sum
 MD5::compute(Stream& is)
 {
     MD5 md5;
+
+    // a mapped file can be summed in place
+    if (is.isA(MmapStream))
+    {
+        auto& ms = utl::cast<MmapStream>(is);
+        md5.add(ms.cur(), ms.remaining());
+        ms.skip(ms.remaining());
+        return md5.get();
+    }
+
     Vector<byte_t> bufVector(4096);
     byte_t* buf = bufVector;
 
@@ -198,7 +209,7 @@ MD5::compute(Stream& is)
         size_t numRead;
         try
         {
-            numRead = is.read(buf, 4096);
+            numRead = is.read(buf, 4096, 1);
             md5.add(buf, numRead);
         }
         catch (StreamEOFex&)
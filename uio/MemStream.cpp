@@ -13,6 +13,30 @@ UTL_NS_BEGIN;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+Stream&
+MemStream::readLine(String& str)
+{
+    ASSERTD(isInput());
+
+    // nothing left -> EOF
+    if (_readPos >= _array.size())
+        throwStreamEOFex();
+
+    // the line ends at the first newline or nul (or the end of the data)
+    const byte_t* start = _array + _readPos;
+    const byte_t* lim = _array + _array.size();
+    auto end = findLineEnd(start, lim);
+    size_t lineLen = (end - start);
+
+    // skip past the terminator (if there is one)
+    _readPos += lineLen + ((end == lim) ? 0 : 1);
+
+    str.set(reinterpret_cast<const char*>(start), true, true, lineLen);
+    return self;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 size_t
 MemStream::read(byte_t* array, size_t maxBytes, size_t minBytes)
 {
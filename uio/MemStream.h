@@ -70,6 +70,8 @@ public:
         clear();
     }
 
+    virtual Stream& readLine(String& str);
+
     virtual size_t read(byte_t* array, size_t maxBytes, size_t minBytes = size_t_max);
 
     virtual void write(const byte_t* array, size_t num);
@@ -0,0 +1,189 @@
+#include <libutl/libutl.h>
+#include <libutl/MmapStream.h>
+#include <libutl/String.h>
+#if UTL_HOST_TYPE == UTL_HT_UNIX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_CLASS_IMPL(utl::MmapStream);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+MmapStream::open(int fd, uint_t flags)
+{
+    // close any currently open file
+    close();
+
+    map(fd, flags);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+MmapStream::open(const Pathname& path, uint_t flags)
+{
+    // close any currently open file
+    close();
+
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        errToEx(path);
+    SCOPE_EXIT
+    {
+        ::close(fd);
+    };
+
+    setName(path);
+    map(fd, flags);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+MmapStream::advise(uint_t flags)
+{
+#if UTL_HOST_TYPE == UTL_HT_UNIX
+    if (_data == nullptr)
+        return;
+
+    // (these are only hints, so failures are ignored)
+    int advice = MADV_NORMAL;
+    if ((flags & mmap_sequential) != 0)
+        advice = MADV_SEQUENTIAL;
+    else if ((flags & mmap_random) != 0)
+        advice = MADV_RANDOM;
+    madvise(_data, _size, advice);
+    if ((flags & mmap_willneed) != 0)
+        madvise(_data, _size, MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+    if ((flags & mmap_hugepage) != 0)
+        madvise(_data, _size, MADV_HUGEPAGE);
+#endif
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Stream&
+MmapStream::readLine(String& str)
+{
+    ASSERTD(isInput());
+
+    // nothing left -> EOF
+    if (_pos == _size)
+        throwStreamEOFex();
+
+    // the line ends at the first newline or nul (or the end of the file)
+    auto start = _data + _pos;
+    auto lim = _data + _size;
+    auto end = findLineEnd(start, lim);
+    size_t lineLen = (end - start);
+
+    // skip past the terminator (if there is one)
+    _pos += lineLen + ((end == lim) ? 0 : 1);
+
+    str.set(reinterpret_cast<const char*>(start), true, true, lineLen);
+    return self;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+MmapStream::read(byte_t* array, size_t maxBytes, size_t minBytes)
+{
+    ASSERTD(isInput());
+
+    // fix minBytes
+    if (minBytes > maxBytes)
+        minBytes = maxBytes;
+
+    // how many bytes can we read?
+    size_t num = min(remaining(), maxBytes);
+
+    // not enough bytes to satisfy the request?
+    if (num < minBytes)
+        throwStreamEOFex();
+
+    // copy into the caller's buffer
+    memcpy(array, _data + _pos, num);
+    _pos += num;
+
+    return num;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+MmapStream::write(const byte_t*, size_t)
+{
+    ABORT();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+MmapStream::clear()
+{
+#if UTL_HOST_TYPE == UTL_HT_UNIX
+    if (_data != nullptr)
+        munmap(_data, _size);
+#else
+    delete[] _data;
+#endif
+    init();
+    super::clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+MmapStream::map(int fd, uint_t flags)
+{
+    setMode(io_rd);
+    setError(false);
+
+#if UTL_HOST_TYPE == UTL_HT_UNIX
+    struct stat st;
+    if (fstat(fd, &st) < 0)
+        errToEx(getNamePtr());
+
+    // (an empty file can't be mapped, but there's nothing to map anyway)
+    if (st.st_size == 0)
+        return;
+    void* ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (ptr == MAP_FAILED)
+        errToEx(getNamePtr());
+    _data = static_cast<byte_t*>(ptr);
+    _size = st.st_size;
+    advise(flags);
+#else
+    // read the whole file into memory
+    off_t size = lseek(fd, 0, SEEK_END);
+    if ((size < 0) || (lseek(fd, 0, SEEK_SET) < 0))
+        errToEx(getNamePtr());
+    _data = new byte_t[size];
+    _size = size;
+    for (size_t pos = 0; pos != _size;)
+    {
+        auto num = ::read(fd, _data + pos, _size - pos);
+        if (num <= 0)
+        {
+            clear();
+            errToEx(getNamePtr());
+        }
+        pos += num;
+    }
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
@@ -0,0 +1,174 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/Pathname.h>
+#include <libutl/Stream.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   MmapStream flags (access hints for the kernel).
+   \ingroup io
+*/
+enum mmap_flags_t
+{
+    mmap_sequential = 1, /**< the file will be read sequentially (aggressive read-ahead) */
+    mmap_random = 2,     /**< the file will be read in random order (no read-ahead) */
+    mmap_willneed = 4,   /**< start reading the whole file in now */
+    mmap_hugepage = 8    /**< map the file with huge pages (where the filesystem supports it) */
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Memory-mapped (read-only) file stream.
+
+   Instead of copying the file into a buffer with read(2) (as FileStream and BufferedFileStream
+   do), MmapStream maps the whole file into memory.  read() and readLine() work as usual, and the
+   mapped region can also be accessed directly (see data(), cur() and remaining()), so that a large
+   file can be processed without copying it at all.
+
+   The access hints (see utl::mmap_flags_t) are passed to the kernel with madvise(2).  On hosts
+   without mmap(), the file is read into memory instead.
+
+   \author Adam McKee
+   \ingroup io
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class MmapStream : public Stream
+{
+    UTL_CLASS_DECL(MmapStream, Stream);
+    UTL_CLASS_NO_COPY;
+
+public:
+    /**
+       Constructor.
+       \param path file pathname
+       \param flags (optional : mmap_sequential) see utl::mmap_flags_t
+    */
+    MmapStream(const Pathname& path, uint_t flags = mmap_sequential)
+    {
+        init();
+        open(path, flags);
+    }
+
+    /**
+       Close the currently open file, and map an open file.  The file descriptor can be closed
+       after this returns (the mapping remains valid).
+       \param fd file descriptor obtained from call to open(2)
+       \param flags (optional : mmap_sequential) see utl::mmap_flags_t
+    */
+    void open(int fd, uint_t flags = mmap_sequential);
+
+    /**
+       Close the currently open file, and map a new file.
+       \param path file pathname
+       \param flags (optional : mmap_sequential) see utl::mmap_flags_t
+    */
+    void open(const Pathname& path, uint_t flags = mmap_sequential);
+
+    virtual void
+    close()
+    {
+        clear();
+    }
+
+    /**
+       Give the kernel new access hints.
+       \param flags see utl::mmap_flags_t
+    */
+    void advise(uint_t flags);
+
+    /** Get the address of the mapped region. */
+    const byte_t*
+    data() const
+    {
+        return _data;
+    }
+
+    /** Get the size of the mapped region (the file length). */
+    size_t
+    size() const
+    {
+        return _size;
+    }
+
+    /** Get the address of the next byte to be read. */
+    const byte_t*
+    cur() const
+    {
+        return _data + _pos;
+    }
+
+    /** Get the number of bytes remaining to be read. */
+    size_t
+    remaining() const
+    {
+        return _size - _pos;
+    }
+
+    /** Seek to the given position. */
+    void
+    seek(size_t pos)
+    {
+        ASSERTD(pos <= _size);
+        _pos = pos;
+        setEOF(false);
+    }
+
+    /** Skip over the given number of bytes (e.g. after processing them in place). */
+    void
+    skip(size_t num)
+    {
+        ASSERTD(num <= remaining());
+        _pos += num;
+    }
+
+    /** Get the current position. */
+    size_t
+    tell() const
+    {
+        return _pos;
+    }
+
+    virtual Stream& readLine(String& str);
+
+    virtual size_t read(byte_t* array, size_t maxBytes, size_t minBytes = size_t_max);
+
+    /** MmapStream is read-only, so calling write() is an error. */
+    virtual void write(const byte_t* array, size_t num);
+
+protected:
+    virtual void clear();
+
+private:
+    void
+    init()
+    {
+        _data = nullptr;
+        _size = 0;
+        _pos = 0;
+    }
+    void
+    deInit()
+    {
+        clear();
+    }
+    void map(int fd, uint_t flags);
+
+private:
+    byte_t* _data;
+    size_t _size;
+    size_t _pos;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
@@ -1,5 +1,6 @@
 #include <libutl/libutl.h>
 #include <libutl/util_inl.h>
+#include <libutl/FDstream.h>
 #include <libutl/Stream.h>
 #include <libutl/String.h>
 #include <libutl/Vector.h>
@@ -249,7 +250,7 @@ Stream::readLine(String& p_str)
         *strPtr++ = '\0';
     }
 
-    p_str.set(str, true, true);
+    p_str.set(str, true, true, strPtr - str - 1);
 
     return self;
 }
@@ -349,6 +350,45 @@ Stream::writeSpaces(size_t num)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+Stream::writev(const struct iovec* iov, size_t iovcnt)
+{
+    auto lim = iov + iovcnt;
+    for (; iov != lim; ++iov)
+    {
+        write(static_cast<const byte_t*>(iov->iov_base), iov->iov_len);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if UTL_HOST_TYPE == UTL_HT_UNIX
+size_t
+Stream::transferFrom(FDstream& src, off_t offset, size_t num)
+{
+    const size_t bufSize = KB(64);
+    Vector<byte_t> buf(min(num, bufSize));
+    size_t res = 0;
+    while (res != num)
+    {
+        ssize_t numRead = ::pread(src.fd(), buf.get(), min(num - res, bufSize), offset + res);
+        if (numRead < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            src.throwStreamErrorEx();
+        }
+        if (numRead == 0)
+            break;
+        write(buf.get(), numRead);
+        res += numRead;
+    }
+    return res;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 Stream&
 Stream::operator<<(void* ptr)
 {
@@ -586,6 +626,10 @@ Stream::clear()
     _bitByte = 0;
     _inCount = 0;
     _outCount = 0;
+    _iBufPtr = nullptr;
+    _iBufPos = _iBufLim = 0;
+    _oBufPtr = nullptr;
+    _oBufPos = _oBufSize = 0;
     _indent = 0;
 }
 
@@ -3,6 +3,19 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <libutl/Exception.h>
+#if UTL_HOST_TYPE == UTL_HT_UNIX
+#include <sys/uio.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if UTL_HOST_TYPE == UTL_HT_WINDOWS
+struct iovec
+{
+    void* iov_base;
+    size_t iov_len;
+};
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -10,6 +23,7 @@ UTL_NS_BEGIN;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+class FDstream;
 class String;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -251,12 +265,19 @@ public:
     size_t copyData(Stream& in, size_t numBytes = size_t_max, size_t bufSize = KB(4));
 
     /**
-       Get a single byte.
+       Get a single byte.  If the stream has an input buffer (see BufferedStream) with unread data
+       in it, the byte is taken from the buffer directly, otherwise read() is called.
        \param val byte reference
     */
     void
     get(byte_t& val)
     {
+        if (_iBufPos < _iBufLim)
+        {
+            val = _iBufPtr[_iBufPos++];
+            ++_inCount;
+            return;
+        }
         read(&val, 1);
     }
 
@@ -332,11 +353,22 @@ public:
 
     /// \name Output
     //@{
-    /** Write the given character. */
+    /**
+       Write the given character.  If the stream has an output buffer (see BufferedStream) with
+       room in it, the byte is stored in the buffer directly, otherwise write() is called.
+    */
     Stream&
     put(byte_t b)
     {
         ASSERTD(isOutput());
+
+        // (the byte that fills the buffer goes through write(), which flushes it)
+        if ((_oBufPos + 1) < _oBufSize)
+        {
+            _oBufPtr[_oBufPos++] = b;
+            ++_outCount;
+            return self;
+        }
         write(&b, 1);
         return self;
     }
@@ -435,6 +467,26 @@ public:
        \param num number of bytes to write
     */
     virtual void write(const byte_t* array, size_t num) = 0;
+
+    /**
+       Write a sequence of blocks of bytes (gather write).  The default implementation calls
+       write() for each block.
+       \param iov blocks to write
+       \param iovcnt number of blocks
+    */
+    virtual void writev(const struct iovec* iov, size_t iovcnt);
+
+#if UTL_HOST_TYPE == UTL_HT_UNIX
+    /**
+       Copy part of a file to the stream (without changing the file's position).  The default
+       implementation reads the file with pread(2) and calls write().
+       \return number of bytes copied (less than num only if the end of the file was reached)
+       \param src source file
+       \param offset file offset of the first byte to copy
+       \param num number of bytes to copy
+    */
+    virtual size_t transferFrom(FDstream& src, off_t offset, size_t num);
+#endif
     //@}
 
     /**
@@ -593,6 +645,11 @@ protected:
     // track # input/output bytes
     size_t _inCount;
     size_t _outCount;
+    // buffers (owned and maintained by BufferedStream)
+    byte_t* _iBufPtr;
+    size_t _iBufPos, _iBufLim;
+    byte_t* _oBufPtr;
+    size_t _oBufPos, _oBufSize;
     // bit i/o
     byte_t _bitMask;
     byte_t _bitByte;
@@ -25,9 +25,14 @@ Float::compare(const Object& p_rhs) const
 {
     auto& f = utl::cast<Float>(p_rhs);
 
-    // normalize into [-1.0, +1.0]
     double lhs = _n;
     double rhs = f._n;
+
+    // equal (this also covers zeroes, which can't be normalized)
+    if (lhs == rhs)
+        return 0;
+
+    // normalize into [-1.0, +1.0]
     bool lhsNeg = (lhs < 0.0);
     bool rhsNeg = (rhs < 0.0);
     double lhsABS = lhsNeg ? fabs(lhs) : lhs;
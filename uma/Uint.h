@@ -28,6 +28,7 @@ class Uint : public Integer<uint64_t>
 {
     UTL_CLASS_DECL(Uint, Integer<uint64_t>);
     UTL_CLASS_DEFID;
+    UTL_CLASS_POOLED;
 
 public:
     /**
@@ -2,6 +2,18 @@
 #include <libutl/algorithms_inl.h>
 #include <libutl/Heap.h>
 #include <libutl/AutoPtr.h>
+#include <libutl/Thread.h>
+#include <libutl/Float.h>
+#include <libutl/Int.h>
+#include <libutl/Rope.h>
+#include <libutl/Semaphore.h>
+#include <libutl/Uint.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#undef new
+#include <thread>
+#include <libutl/gblnew_macros.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -12,6 +24,9 @@ UTL_NS_BEGIN;
 static void
 mergeSort(Object** array, Object** buf, size_t begin, size_t end, const Ordering* ordering);
 
+// minimum size of a sequence that quickSort() and mergeSort() will try to radix-sort
+static const size_t radixSortMinSize = 64;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 size_t
@@ -940,6 +955,8 @@ mergeSort(const FwdIt& begin, const FwdIt& end, const Ordering* ordering, size_t
 void
 mergeSort(Object** array, size_t begin, size_t end, const Ordering* ordering)
 {
+    if (((end - begin) >= radixSortMinSize) && radixSort(array, begin, end, ordering))
+        return;
     Vector<Object*> buf(end - begin);
     mergeSort(array, buf.get(), begin, end, ordering);
 }
@@ -954,7 +971,7 @@ mergeSort(Object** array, Object** buf, size_t begin, size_t end, const Ordering
     // use a different algorithm for smaller-sized sequences
     if ((end - begin) <= 16)
     {
-        insertionSort(array, begin, end);
+        insertionSort(array, begin, end, ordering);
         return;
     }
 
@@ -999,7 +1016,7 @@ mergeSort(Object** array, Object** buf, size_t begin, size_t end, const Ordering
     }
 
     // copy the result back into vect[]
-    memmove(array, buf, (end - begin) * sizeof(void*));
+    memmove(array + begin, buf, (end - begin) * sizeof(void*));
     // arrayVect.copy(buf, begin, 0, end - begin);
 }
 
@@ -1049,6 +1066,261 @@ multiKeyQuickSort(const FwdIt& begin, const FwdIt& end, bool key, bool reverse,
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// minimum size of a run sorted by one thread (in parallelMergeSort())
+static const size_t parallelMinRunSize = 16384;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Find how many of the first k objects of the merge of lhs[] and rhs[] come from lhs[] (objects
+// from lhs[] go first when they compare equal to objects from rhs[]).
+static size_t
+mergeSplit(Object* const* lhs,
+           size_t lhsSize,
+           Object* const* rhs,
+           size_t rhsSize,
+           size_t k,
+           const Ordering* ordering)
+{
+    size_t low = (k > rhsSize) ? (k - rhsSize) : 0;
+    size_t high = min(k, lhsSize);
+    for (;;)
+    {
+        size_t i = (low + high) / 2;
+        size_t j = k - i;
+        if ((i > 0) && (j < rhsSize) && (compare(lhs[i - 1], rhs[j], ordering) > 0))
+        {
+            // too many from lhs
+            high = i - 1;
+        }
+        else if ((j > 0) && (i < lhsSize) && (compare(rhs[j - 1], lhs[i], ordering) >= 0))
+        {
+            // too few from lhs
+            low = i + 1;
+        }
+        else
+        {
+            return i;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// merge lhs[] and rhs[] into out[]
+static void
+mergeRuns(Object* const* lhs,
+          Object* const* lhsEnd,
+          Object* const* rhs,
+          Object* const* rhsEnd,
+          Object** out,
+          const Ordering* ordering)
+{
+    while ((lhs != lhsEnd) && (rhs != rhsEnd))
+    {
+        if (compare(*lhs, *rhs, ordering) <= 0)
+            *out++ = *lhs++;
+        else
+            *out++ = *rhs++;
+    }
+    memcpy(out, lhs, (lhsEnd - lhs) * sizeof(Object*));
+    out += (lhsEnd - lhs);
+    memcpy(out, rhs, (rhsEnd - rhs) * sizeof(Object*));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Team of threads that run batches of tasks (for parallelMergeSort()).  The threads are created
+// once, and wait between batches, so a sort doesn't pay for a thread start-up per merge round.
+class ParallelWorkers
+{
+public:
+    // numThreads includes the calling thread
+    ParallelWorkers(uint_t numThreads)
+        : _numWorkers(numThreads - 1)
+        , _startSem(0)
+        , _doneSem(0)
+        , _task(nullptr)
+        , _numTasks(0)
+        , _nextTask(0)
+        , _threads(_numWorkers)
+    {
+        for (uint_t i = 0; i != _numWorkers; ++i)
+        {
+            auto thread = new WorkerThread(*this);
+            _threads[i] = thread;
+            thread->start();
+        }
+    }
+
+    ~ParallelWorkers()
+    {
+        // a null task tells the workers to exit
+        _task = nullptr;
+        for (uint_t i = 0; i != _numWorkers; ++i)
+        {
+            _startSem.up();
+        }
+        for (uint_t i = 0; i != _numWorkers; ++i)
+        {
+            utl::cast<Thread>(_threads[i])->join();
+        }
+    }
+
+    // run task(0) ... task(numTasks - 1) on the workers and the calling thread
+    void
+    parallelFor(size_t numTasks, const std::function<void(size_t)>& task)
+    {
+        _task = &task;
+        _numTasks = numTasks;
+        _nextTask.store(0, std::memory_order_relaxed);
+        for (uint_t i = 0; i != _numWorkers; ++i)
+        {
+            _startSem.up();
+        }
+        runTasks();
+        for (uint_t i = 0; i != _numWorkers; ++i)
+        {
+            _doneSem.down();
+        }
+    }
+
+private:
+    class WorkerThread : public Thread
+    {
+    public:
+        WorkerThread(ParallelWorkers& workers)
+            : _workers(workers)
+        {
+        }
+
+        virtual void*
+        run(void*)
+        {
+            for (;;)
+            {
+                _workers._startSem.down();
+                if (_workers._task == nullptr)
+                    break;
+                _workers.runTasks();
+                _workers._doneSem.up();
+            }
+            return nullptr;
+        }
+
+    private:
+        ParallelWorkers& _workers;
+    };
+
+private:
+    void
+    runTasks()
+    {
+        size_t i;
+        while ((i = _nextTask.fetch_add(1, std::memory_order_relaxed)) < _numTasks)
+        {
+            (*_task)(i);
+        }
+    }
+
+private:
+    uint_t _numWorkers;
+    Semaphore _startSem;
+    Semaphore _doneSem;
+    const std::function<void(size_t)>* _task;
+    size_t _numTasks;
+    std::atomic_size_t _nextTask;
+    Vector<Object*> _threads;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+parallelMergeSort(const FwdIt& begin, const FwdIt& end, const Ordering* ordering, size_t size)
+{
+    if (size == size_t_max)
+        size = count(begin, end);
+    Vector<Object*> vect(size, 1);
+    copy(vect, begin, end);
+    parallelMergeSort(vect, 0, size, ordering);
+    AutoPtr<FwdIt> it = begin.clone();
+    copy(*it, vect);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+parallelMergeSort(
+    Object** array, size_t begin, size_t end, const Ordering* ordering, uint_t numThreads)
+{
+    size_t size = end - begin;
+    if (numThreads == 0)
+        numThreads = max(std::thread::hardware_concurrency(), 1U);
+
+    // determine the number of runs
+    size_t numRuns = 1;
+    while ((numRuns < numThreads) && ((size / (numRuns * 2)) >= parallelMinRunSize))
+    {
+        numRuns *= 2;
+    }
+
+    // not worth doing in parallel?
+    if (numRuns == 1)
+    {
+        quickSort(array, begin, end, ordering);
+        return;
+    }
+
+    // start the threads (no more than there are runs)
+    ParallelWorkers workers(min((size_t)numThreads, numRuns));
+
+    // quick-sort the runs
+    Object** src = array + begin;
+    workers.parallelFor(numRuns, [=](size_t run) {
+        quickSort(src, (run * size) / numRuns, ((run + 1) * size) / numRuns, ordering);
+    });
+
+    // merge pairs of runs until there's only one run left, splitting each merge into
+    // (numRuns / numMerges) pieces
+    Vector<Object*> buf(size);
+    Object** dst = buf.get();
+    size_t numPieces = numRuns;
+    for (size_t runs = numRuns; runs != 1; runs /= 2)
+    {
+        size_t numMerges = runs / 2;
+        size_t piecesPerMerge = numPieces / numMerges;
+        workers.parallelFor(numPieces, [=](size_t piece) {
+            // the two runs being merged
+            size_t merge = piece / piecesPerMerge;
+            size_t lhsBegin = ((2 * merge) * size) / runs;
+            size_t rhsBegin = ((2 * merge + 1) * size) / runs;
+            size_t rhsEnd = ((2 * merge + 2) * size) / runs;
+            Object** lhs = src + lhsBegin;
+            Object** rhs = src + rhsBegin;
+            size_t lhsSize = rhsBegin - lhsBegin;
+            size_t rhsSize = rhsEnd - rhsBegin;
+
+            // this piece's part of the output, and the inputs that go into it
+            size_t mergeSize = lhsSize + rhsSize;
+            size_t pieceIdx = piece % piecesPerMerge;
+            size_t outBegin = (pieceIdx * mergeSize) / piecesPerMerge;
+            size_t outEnd = ((pieceIdx + 1) * mergeSize) / piecesPerMerge;
+            size_t lhsIdx = mergeSplit(lhs, lhsSize, rhs, rhsSize, outBegin, ordering);
+            size_t lhsLim = mergeSplit(lhs, lhsSize, rhs, rhsSize, outEnd, ordering);
+            mergeRuns(lhs + lhsIdx, lhs + lhsLim, rhs + (outBegin - lhsIdx),
+                      rhs + (outEnd - lhsLim), dst + lhsBegin + outBegin, ordering);
+        });
+        std::swap(src, dst);
+    }
+
+    // result is in buf[]?
+    if (src != (array + begin))
+    {
+        memcpy(array + begin, src, size * sizeof(Object*));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void
 quickSort(const FwdIt& begin, const FwdIt& end, const Ordering* ordering, size_t size)
 {
@@ -1082,6 +1354,10 @@ quickSort(Object** array, size_t begin, size_t end, const Ordering* ordering)
         return;
     }
 
+    // sort numbers by their values instead?
+    if (((end - begin) >= radixSortMinSize) && radixSort(array, begin, end, ordering))
+        return;
+
     // quickSort with median-of-three partitioning and no recursion
     for (;;)
     {
@@ -1171,6 +1447,84 @@ quickSort(Object** array, size_t begin, size_t end, const Ordering* ordering)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// a number's key (ordered like the number) and the number itself
+struct RadixItem
+{
+    uint64_t key;
+    Object* object;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool
+radixSort(Object** array, size_t begin, size_t end, const Ordering* ordering)
+{
+    // natural ordering required
+    if ((ordering != nullptr) && (ordering->getClass() != CLASS(NaturalOrdering)))
+        return false;
+
+    // all objects must be of the same class (Int, Uint, or Float)
+    size_t size = end - begin;
+    if (size == 0)
+        return true;
+    Object** objects = array + begin;
+    const RunTimeClass* rtc = objects[0]->getClass();
+    if ((rtc != CLASS(Int)) && (rtc != CLASS(Uint)) && (rtc != CLASS(Float)))
+        return false;
+    for (size_t i = 1; i != size; ++i)
+    {
+        if (objects[i]->getClass() != rtc)
+            return false;
+    }
+
+    // map each value to an unsigned key with the same order
+    auto items = new RadixItem[size];
+    RadixItem* item = items;
+    if (rtc == CLASS(Uint))
+    {
+        for (size_t i = 0; i != size; ++i, ++item)
+        {
+            item->key = static_cast<Uint*>(objects[i])->get();
+            item->object = objects[i];
+        }
+    }
+    else if (rtc == CLASS(Int))
+    {
+        // flip the sign bit so negative numbers come first
+        for (size_t i = 0; i != size; ++i, ++item)
+        {
+            item->key = (uint64_t)static_cast<Int*>(objects[i])->get() ^ ((uint64_t)1 << 63);
+            item->object = objects[i];
+        }
+    }
+    else
+    {
+        // negative: invert all bits (so larger magnitudes come first), else flip the sign bit
+        for (size_t i = 0; i != size; ++i, ++item)
+        {
+            double d = static_cast<Float*>(objects[i])->get();
+            if (d == 0.0)
+                d = 0.0; // -0.0 = +0.0
+            uint64_t bits;
+            memcpy(&bits, &d, sizeof(bits));
+            item->key = (bits & ((uint64_t)1 << 63)) ? ~bits : (bits | ((uint64_t)1 << 63));
+            item->object = objects[i];
+        }
+    }
+
+    radixSortByKey(items, size, [](const RadixItem& item) { return item.key; });
+
+    item = items;
+    for (size_t i = 0; i != size; ++i, ++item)
+    {
+        objects[i] = item->object;
+    }
+    delete[] items;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void
 remove(FwdIt& begin, const FwdIt& end, bool cmp, const Predicate* pred, bool predVal)
 {
@@ -1326,6 +1680,9 @@ sort(const FwdIt& begin, const FwdIt& end, const Ordering* ordering, uint_t algo
     case sort_quickSort:
         quickSort(begin, end, ordering, size);
         break;
+    case sort_parallelMergeSort:
+        parallelMergeSort(begin, end, ordering, size);
+        break;
     }
 }
 
@@ -1348,6 +1705,9 @@ sort(Object** array, size_t begin, size_t end, const Ordering* ordering, uint_t
     case sort_quickSort:
         quickSort(array, begin, end, ordering);
         break;
+    case sort_parallelMergeSort:
+        parallelMergeSort(array, begin, end, ordering);
+        break;
     }
 }
 
@@ -1488,8 +1848,17 @@ symmetricDifference(const FwdIt& lhsBegin,
 String
 toString(const FwdIt& begin, const FwdIt& end, const String& sep, bool key)
 {
-    String res;
+    // build a rope, and flatten it at the end (instead of repeatedly growing a String)
+    Rope rope;
+    toRope(begin, end, sep, rope, key);
+    return rope.toString();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+toRope(const FwdIt& begin, const FwdIt& end, const String& sep, Rope& rope, bool key)
+{
     // create iterator
     AutoPtr<FwdIt> itPtr = begin.clone();
     FwdIt& it = *itPtr;
@@ -1504,23 +1873,21 @@ toString(const FwdIt& begin, const FwdIt& end, const String& sep, bool key)
         // add the separator if this isn't the first string
         if (!first)
         {
-            res += sep;
+            rope += sep;
         }
         // add the object's string
         if (key)
         {
-            res += object->getKey().toString();
+            rope += object->getKey().toString();
         }
         else
         {
-            res += object->toString();
+            rope += object->toString();
         }
         first = false;
 
         ++it;
     }
-
-    return res;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -13,17 +13,22 @@ UTL_NS_BEGIN;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+class Rope;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /**
    Specifies a sort algorithm.
    \ingroup algorithm
 */
 enum sort_t
 {
-    sort_heapSort,      /**< heap sort */
-    sort_insertionSort, /**< insertion sort */
-    sort_mergeSort,     /**< merge sort */
-    sort_quickSort,     /**< quick sort */
-    sort_none           /**< do not sort */
+    sort_heapSort,          /**< heap sort */
+    sort_insertionSort,     /**< insertion sort */
+    sort_mergeSort,         /**< merge sort */
+    sort_quickSort,         /**< quick sort */
+    sort_parallelMergeSort, /**< merge sort using multiple threads (see parallelMergeSort()) */
+    sort_none               /**< do not sort */
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -501,6 +506,48 @@ void multiKeyQuickSort(const FwdIt& begin,
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/**
+   Sort a sequence using multiple threads.  The objects are copied into an array that is sorted
+   with parallelMergeSort(Object**, size_t, size_t, const Ordering*, uint_t), then copied back.
+
+   \ingroup algorithm
+   \param begin begin of sequence
+   \param end end of sequence
+   \param ordering (optional) ordering
+   \param size (optional) size of sequence
+*/
+void parallelMergeSort(const FwdIt& begin,
+                       const FwdIt& end,
+                       const Ordering* ordering = nullptr,
+                       size_t size = size_t_max);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Sort (part of) an array using multiple threads.
+
+   The array is divided into runs (a power of 2, at least as many as there are threads, but
+   no smaller than 16384 objects each), which are quick-sorted at the same time.  The runs are
+   then merged pairwise, one round at a time.  In each round, every merge is split into pieces of
+   (almost) equal size by binary-searching both inputs for where each piece of the output begins,
+   so all threads stay busy until the end, when a single merge produces the whole array.  A small
+   array is quick-sorted by the calling thread.
+
+   \ingroup algorithm
+   \param array sequence to be sorted
+   \param begin index of first object
+   \param end index of last object + 1
+   \param ordering (optional) ordering
+   \param numThreads (optional) number of threads to use (0 = one per hardware thread)
+*/
+void parallelMergeSort(Object** array,
+                       size_t begin,
+                       size_t end,
+                       const Ordering* ordering = nullptr,
+                       uint_t numThreads = 0);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /**
    Quick-sort a sequence.
 
@@ -530,6 +577,26 @@ void quickSort(Object** array, size_t begin, size_t end, const Ordering* orderin
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/**
+   Radix-sort (part of) a sequence of numbers, if possible.
+
+   A radix sort is possible when the ordering is the natural ordering (or none is given), and all
+   the objects are of the same class, which is one of Int, Uint, or Float.  In that case the
+   objects' values are sorted directly (see radixSortByKey()), without calling Ordering::cmp().
+   The sort is stable.  quickSort() and mergeSort() use radixSort() when they can, so there's
+   usually no need to call it directly.
+
+   \ingroup algorithm
+   \return true if the sequence was sorted, false if a radix sort isn't possible
+   \param array sequence to be sorted
+   \param begin index of first object
+   \param end index of last object + 1
+   \param ordering (optional) ordering
+*/
+bool radixSort(Object** array, size_t begin, size_t end, const Ordering* ordering = nullptr);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /**
    Remove objects from a sequence.
 
@@ -731,6 +798,21 @@ String toString(const FwdIt& begin, const FwdIt& end, const String& sep, bool ke
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/**
+   Append a string representation of a sequence (via Object::toString()) to a rope.
+
+   \see Object::getKey
+   \ingroup algorithm
+   \param begin begin iterator
+   \param end end iterator
+   \param sep separator (e.g. ", ")
+   \param rope rope to append to
+   \param key (optional : false) invoke Object::toString() on object keys?
+*/
+void toRope(const FwdIt& begin, const FwdIt& end, const String& sep, Rope& rope, bool key = false);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /**
    Remove duplicate objects from a sorted sequence.
 
@@ -493,4 +493,132 @@ binarySearch(
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/**
+   Radix-sort a sequence by unsigned integer keys.
+
+   This is an LSD radix sort that handles one byte of the key per pass.  The histograms for all
+   passes are built in a single scan, and passes where every key has the same digit are skipped,
+   so sorting small keys in a wide type doesn't cost extra passes.  The sort is stable.
+
+   \ingroup algorithm
+   \param array sequence to be sorted
+   \param size number of elements
+   \param keyFn function that returns the (unsigned integer) key for an element
+*/
+template <typename T, typename KeyFn>
+void
+radixSortByKey(T* array, size_t size, KeyFn keyFn)
+{
+    typedef decltype(keyFn(*array)) key_t;
+    static_assert(std::is_unsigned<key_t>::value, "radixSortByKey(): key must be unsigned");
+    const size_t numPasses = sizeof(key_t);
+
+    if (size < 2)
+        return;
+
+    // small sequence -> insertion sort
+    if (size <= 32)
+    {
+        for (size_t i = 1; i != size; ++i)
+        {
+            T elem = std::move(array[i]);
+            key_t key = keyFn(elem);
+            size_t j = i;
+            for (; (j != 0) && (key < keyFn(array[j - 1])); --j)
+            {
+                array[j] = std::move(array[j - 1]);
+            }
+            array[j] = std::move(elem);
+        }
+        return;
+    }
+
+    // count digits for all passes
+    size_t counts[numPasses][256];
+    memset(counts, 0, sizeof(counts));
+    for (size_t i = 0; i != size; ++i)
+    {
+        key_t key = keyFn(array[i]);
+        for (size_t pass = 0; pass != numPasses; ++pass)
+        {
+            ++counts[pass][(key >> (pass * 8)) & 0xff];
+        }
+    }
+
+    // distribute between array[] and buf[]
+    T* buf = new T[size];
+    T* src = array;
+    T* dst = buf;
+    for (size_t pass = 0; pass != numPasses; ++pass)
+    {
+        size_t shift = pass * 8;
+        size_t* count = counts[pass];
+
+        // all keys have the same digit -> nothing to do
+        if (count[(keyFn(src[0]) >> shift) & 0xff] == size)
+            continue;
+
+        // digit counts -> starting offsets
+        size_t offset = 0;
+        for (size_t digit = 0; digit != 256; ++digit)
+        {
+            size_t digitCount = count[digit];
+            count[digit] = offset;
+            offset += digitCount;
+        }
+
+        for (size_t i = 0; i != size; ++i)
+        {
+            dst[count[(keyFn(src[i]) >> shift) & 0xff]++] = std::move(src[i]);
+        }
+        std::swap(src, dst);
+    }
+
+    // result is in buf[]?
+    if (src != array)
+        std::move(src, src + size, array);
+    delete[] buf;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Radix-sort (part of) an array of integers.
+
+   \see radixSortByKey
+   \ingroup algorithm
+   \param array array to be sorted
+   \param begin index of first element
+   \param end index of last element + 1
+*/
+template <typename T>
+void
+radixSort(T* array, size_t begin, size_t end)
+{
+    static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value,
+                  "radixSort(): integer type required");
+    typedef typename std::make_unsigned<T>::type key_t;
+
+    // flip the sign bit of signed values so negative values come first
+    const key_t signFlip = std::is_signed<T>::value ? (key_t(1) << (sizeof(T) * 8 - 1)) : 0;
+    radixSortByKey(array + begin, end - begin, [=](T n) { return key_t((key_t)n ^ signFlip); });
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Radix-sort a vector of integers.
+
+   \ingroup algorithm
+   \param vect vector to be sorted
+*/
+template <typename T>
+void
+radixSort(Vector<T>& vect)
+{
+    radixSort(vect.get(), 0, vect.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 UTL_NS_END;
@@ -1,4 +1,5 @@
 #include <libutl/libutl.h>
+#include <libutl/Arena.h>
 #include <libutl/Deque.h>
 #include <libutl/MemStream.h>
 #include <libutl/Token.h>
@@ -953,11 +954,11 @@ BBcodeParser::addIsolatedTag(const String& name, const String& markup)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 String*
-BBcodeParser::parse(const String& input) const
+BBcodeParser::parse(const String& input, Arena* arena) const
 {
-    utl::Deque* tokens = tokenize(input);
+    utl::Deque* tokens = tokenize(input, arena);
     MemStream os;
-    parse(os, *tokens);
+    parse(os, *tokens, arena);
     delete tokens;
     return new String(os.takeString(), true, false);
 }
@@ -1085,9 +1086,10 @@ BBcodeParser::deInit()
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 utl::Deque*
-BBcodeParser::tokenize(const String& input) const
+BBcodeParser::tokenize(const String& input, Arena* arena) const
 {
-    utl::Deque* tokens = new utl::Deque();
+    // tokens in the arena are owned by the arena
+    utl::Deque* tokens = new utl::Deque(arena == nullptr);
     const char* c = input.get();
     const char* lim = c + input.length();
     size_t line = 1, col = 1;
@@ -1264,13 +1266,14 @@ BBcodeParser::tokenize(const String& input) const
                 {
                     size_t i = (unp - begin);
                     size_t len = (p - unp);
-                    tokens->add(
-                        new Token(bbc_text, token.subString(i, len), tokenLine, tokenCol + i));
+                    tokens->add(arenaNew<Token>(
+                        arena, bbc_text, token.subString(i, len), tokenLine, tokenCol + i));
                 }
 
                 // emit token
                 name.assertOwner();
-                tokens->add(new Token(bbc_tag, name, tokenLine, tokenCol + (p - begin)));
+                tokens->add(
+                    arenaNew<Token>(arena, bbc_tag, name, tokenLine, tokenCol + (p - begin)));
 
                 // adjust unp, p
                 unp = (p + tagLen);
@@ -1291,7 +1294,7 @@ BBcodeParser::tokenize(const String& input) const
             continue;
         }
     add:
-        utl::Token* tk = new Token(tokenType, token, tokenLine, tokenCol);
+        utl::Token* tk = arenaNew<Token>(arena, tokenType, token, tokenLine, tokenCol);
         IFDEBUG(tk->length());
         tokens->add(tk);
     }
@@ -1301,9 +1304,9 @@ BBcodeParser::tokenize(const String& input) const
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void
-BBcodeParser::parse(MemStream& os, utl::Deque& tokens) const
+BBcodeParser::parse(MemStream& os, utl::Deque& tokens, Arena* arena) const
 {
-    Deque list;
+    Deque list(arena == nullptr);
     bbcode_context_t context = bbc_block;
     while (!tokens.empty())
     {
@@ -1341,7 +1344,7 @@ BBcodeParser::parse(MemStream& os, utl::Deque& tokens) const
             // auto-close list_item tag?
             if ((context == bbc_list_item) && (tag->context() == bbc_list_item))
             {
-                context = processTag(list, "*", tk->lineNo(), tk->colNo());
+                context = processTag(list, "*", tk->lineNo(), tk->colNo(), arena);
             }
 
             if (tag->isIsolated())
@@ -1349,8 +1352,8 @@ BBcodeParser::parse(MemStream& os, utl::Deque& tokens) const
                 // isolated tag -> just process it
                 String text;
                 tag->process(this, text, *tk, tagParam, context, false);
-                list.add(new Token(bbc_text, text, tk->lineNo(), tk->colNo()));
-                delete tk;
+                list.add(arenaNew<Token>(arena, bbc_text, text, tk->lineNo(), tk->colNo()));
+                arenaDelete(arena, tk);
             }
             else if (tag->isVerbatim())
             {
@@ -1362,7 +1365,7 @@ BBcodeParser::parse(MemStream& os, utl::Deque& tokens) const
                     bool isEnd = ((t->id() == bbc_endtag) && (*t == tagName));
                     if (isEnd)
                     {
-                        delete t;
+                        arenaDelete(arena, t);
                         break;
                     }
                     if (first && (t->id() == bbc_nl))
@@ -1370,11 +1373,11 @@ BBcodeParser::parse(MemStream& os, utl::Deque& tokens) const
                     else
                         text += toString(*t, true);
                     first = false;
-                    delete t;
+                    arenaDelete(arena, t);
                 }
                 tag->process(this, text, text, tagParam, context, false);
-                list.add(new Token(bbc_text, text, tk->lineNo(), tk->colNo()));
-                delete tk;
+                list.add(arenaNew<Token>(arena, bbc_text, text, tk->lineNo(), tk->colNo()));
+                arenaDelete(arena, tk);
             }
             else
             {
@@ -1389,18 +1392,18 @@ BBcodeParser::parse(MemStream& os, utl::Deque& tokens) const
             // ignore [/*]
             if (*tk == "*")
             {
-                delete tk;
+                arenaDelete(arena, tk);
                 continue;
             }
 
             // auto-close list_item tag?
             if ((context == bbc_list_item) && (*tk == "list"))
             {
-                context = processTag(list, "*", tk->lineNo(), tk->colNo());
+                context = processTag(list, "*", tk->lineNo(), tk->colNo(), arena);
             }
 
-            context = processTag(list, *tk, tk->lineNo(), tk->colNo());
-            delete tk;
+            context = processTag(list, *tk, tk->lineNo(), tk->colNo(), arena);
+            arenaDelete(arena, tk);
         }
     }
 
@@ -1422,7 +1425,8 @@ BBcodeParser::parse(MemStream& os, utl::Deque& tokens) const
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 bbcode_context_t
-BBcodeParser::processTag(utl::Deque& list, const String& name, uint_t lineNo, uint_t colNo) const
+BBcodeParser::processTag(
+    utl::Deque& list, const String& name, uint_t lineNo, uint_t colNo, Arena* arena) const
 {
     bbcode_context_t context;
     // search backwards for matching start tag (any other start tag is inappropriate)
@@ -1440,13 +1444,13 @@ BBcodeParser::processTag(utl::Deque& list, const String& name, uint_t lineNo, ui
             if (tagName == name)
             {
                 processed = true;
-                context = processTag(list, it);
+                context = processTag(list, it, arena);
             }
         }
     }
     if (!processed)
     {
-        list.add(new Token(bbc_text, "[/" + name + "]", lineNo, colNo));
+        list.add(arenaNew<Token>(arena, bbc_text, "[/" + name + "]", lineNo, colNo));
     }
     return context;
 }
@@ -1454,7 +1458,9 @@ BBcodeParser::processTag(utl::Deque& list, const String& name, uint_t lineNo, ui
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 bbcode_context_t
-BBcodeParser::processTag(utl::Deque& list, const utl::Deque::iterator& startTagIt) const
+BBcodeParser::processTag(utl::Deque& list,
+                         const utl::Deque::iterator& startTagIt,
+                         Arena* arena) const
 {
     // read start tag
     const Token* tk = (Token*)*startTagIt;
@@ -1521,7 +1527,7 @@ BBcodeParser::processTag(utl::Deque& list, const utl::Deque::iterator& startTagI
     tag->process(this, text, text, tagParam, context, indent);
     if (addNL)
         text += '\n';
-    tk = new Token(bbc_text, text, lineNo, colNo);
+    tk = arenaNew<Token>(arena, bbc_text, text, lineNo, colNo);
     list.add(tk);
 
     // return the new context
@@ -11,6 +11,7 @@ UTL_NS_BEGIN;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+class Arena;
 class MemStream;
 class Token;
 
@@ -44,7 +45,13 @@ class BBcodeParser : public utl::Object
 public:
     void addIsolatedTag(const String& name, const String& markup);
 
-    String* parse(const String& input) const;
+    /**
+       Translate BBCode to HTML.
+       \return HTML markup
+       \param input BBCode text
+       \param arena (optional) arena for the intermediate tokens
+    */
+    String* parse(const String& input, Arena* arena = nullptr) const;
 
     String parseColor(const String& colorName) const;
 
@@ -66,11 +73,15 @@ public:
 private:
     void init();
     void deInit();
-    utl::Deque* tokenize(const String& input) const;
-    void parse(utl::MemStream& os, utl::Deque& tokens) const;
+    utl::Deque* tokenize(const String& input, Arena* arena) const;
+    void parse(utl::MemStream& os, utl::Deque& tokens, Arena* arena) const;
+    bbcode_context_t processTag(utl::Deque& list,
+                                const String& name,
+                                uint_t lineNo,
+                                uint_t colNo,
+                                Arena* arena) const;
     bbcode_context_t
-    processTag(utl::Deque& list, const String& name, uint_t lineNo, uint_t colNo) const;
-    bbcode_context_t processTag(utl::Deque& list, const utl::Deque::iterator& startTagIt) const;
+    processTag(utl::Deque& list, const utl::Deque::iterator& startTagIt, Arena* arena) const;
     bbcode_context_t findContext(utl::Deque& list) const;
     bool isIsolatedTag(const String& name) const;
 
@@ -0,0 +1,259 @@
+#include <libutl/libutl.h>
+#include <libutl/ConcurrentHashtable.h>
+#include <libutl/InternedString.h>
+#include <libutl/MemoryCensus.h>
+#include <libutl/Stream.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_CLASS_IMPL(utl::InternedString);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// maximum number of interned strings
+static const size_t maxInterned = 64 * 1024;
+
+// number of interned strings
+static std::atomic<size_t> internedString_count(0);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// well-known names that make() will intern (sorted by memcmp() order)
+static const char* knownNames[] = {
+    "AUTH_TYPE", "Accept", "Accept-Charset", "Accept-Encoding", "Accept-Language", "Accept-Ranges",
+    "Age", "Allow", "Authorization", "CONTENT_LENGTH", "CONTENT_TYPE", "Cache-Control",
+    "Connection", "Content-Disposition", "Content-Encoding", "Content-Language", "Content-Length",
+    "Content-Location", "Content-Range", "Content-Type", "Cookie", "DOCUMENT_ROOT", "DOCUMENT_URI",
+    "Date", "ETag", "Expect", "Expires", "From", "GATEWAY_INTERFACE", "HTTPS", "HTTP_ACCEPT",
+    "HTTP_ACCEPT_CHARSET", "HTTP_ACCEPT_ENCODING", "HTTP_ACCEPT_LANGUAGE", "HTTP_AUTHORIZATION",
+    "HTTP_CACHE_CONTROL", "HTTP_CONNECTION", "HTTP_CONTENT_LENGTH", "HTTP_CONTENT_TYPE",
+    "HTTP_COOKIE", "HTTP_HOST", "HTTP_IF_MODIFIED_SINCE", "HTTP_IF_NONE_MATCH", "HTTP_ORIGIN",
+    "HTTP_PRAGMA", "HTTP_REFERER", "HTTP_USER_AGENT", "HTTP_X_FORWARDED_FOR",
+    "HTTP_X_REQUESTED_WITH", "Host", "If-Match", "If-Modified-Since", "If-None-Match", "If-Range",
+    "If-Unmodified-Since", "Keep-Alive", "Last-Modified", "Location", "Origin", "PATH", "PATH_INFO",
+    "PATH_TRANSLATED", "Pragma", "Proxy-Authenticate", "Proxy-Authorization", "QUERY_STRING",
+    "REDIRECT_STATUS", "REMOTE_ADDR", "REMOTE_HOST", "REMOTE_PORT", "REMOTE_USER", "REQUEST_METHOD",
+    "REQUEST_SCHEME", "REQUEST_URI", "Range", "Referer", "Retry-After", "SCRIPT_FILENAME",
+    "SCRIPT_NAME", "SERVER_ADDR", "SERVER_NAME", "SERVER_PORT", "SERVER_PROTOCOL",
+    "SERVER_SOFTWARE", "Server", "Set-Cookie", "TE", "Trailer", "Transfer-Encoding", "Upgrade",
+    "User-Agent", "Vary", "Via", "WWW-Authenticate", "Warning", "X-Forwarded-For",
+    "X-Forwarded-Proto", "X-Powered-By", "X-Requested-With"};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// is s[0..len) exactly equal to one of the well-known names?
+static bool
+isKnownName(const char* s, size_t len)
+{
+    size_t lo = 0, hi = sizeof(knownNames) / sizeof(knownNames[0]);
+    while (lo < hi)
+    {
+        size_t mid = (lo + hi) / 2;
+        const char* name = knownNames[mid];
+        size_t nameLen = strlen(name);
+        int cmp = memcmp(s, name, min(len, nameLen));
+        if (cmp == 0)
+            cmp = (len < nameLen) ? -1 : ((len > nameLen) ? 1 : 0);
+        if (cmp == 0)
+            return true;
+        if (cmp < 0)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// the canonical copies of all interned strings (a memory census root)
+static ConcurrentHashtable&
+internedString_table()
+{
+    static ConcurrentHashtable table(0);
+    static bool censusRoot = (MemoryCensus::addRoot(&table, "InternedString table"), true);
+    (void)censusRoot;
+    return table;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+InternedString::InternedString(const char* s, bool caseSensitive)
+{
+    ASSERTD(s != nullptr);
+    init();
+    intern(s, strlen(s));
+    if (!caseSensitive)
+        setCaseSensitive(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+InternedString::InternedString(const String& s, bool caseSensitive)
+{
+    init();
+    intern(s.get(), s.length());
+    if (!caseSensitive)
+        setCaseSensitive(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+InternedString::copy(const Object& rhs)
+{
+    if (!rhs.isA(String))
+    {
+        this->copy(rhs.toString());
+        return;
+    }
+    if (&rhs == this)
+        return;
+    auto& str = utl::cast<String>(rhs);
+    copyFlags(str);
+
+    // rhs is interned -> share its characters
+    if (rhs.isA(InternedString))
+    {
+        auto& istr = utl::cast<InternedString>(rhs);
+        if (istr.isInterned())
+        {
+            excise();
+            if (istr._length != 0)
+                set(istr._s, false, false, istr._length);
+            _hash = istr._hash;
+            _atom = _s;
+            return;
+        }
+    }
+
+    intern(str.get(), str.length());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+InternedString::steal(Object& rhs)
+{
+    copy(rhs);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+InternedString::hash(size_t size) const
+{
+    if (isInterned())
+        return _hash % size;
+    return super::hash(size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+InternedString::serialize(Stream& stream, uint_t io, uint_t mode)
+{
+    if (io == io_rd)
+    {
+        String str;
+        str.serialize(stream, io, mode);
+        intern(str.get(), str.length());
+    }
+    else
+    {
+        super::serialize(stream, io, mode);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+InternedString::innerAllocatedSize() const
+{
+    // the canonical copy isn't counted (it's shared by all equal InternedStrings)
+    return isInterned() ? 0 : super::innerAllocatedSize();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+InternedString::count()
+{
+    return internedString_count.load(std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+String*
+InternedString::make(const char* s, size_t len, bool caseSensitive)
+{
+    ASSERTD((len == 0) || (s != nullptr));
+    String* res;
+    if (isKnownName(s, len))
+    {
+        auto istr = new InternedString();
+        istr->intern(s, len);
+        res = istr;
+    }
+    else
+    {
+        res = new String();
+        if (len != 0)
+            res->set(s, true, true, len);
+    }
+    if (!caseSensitive)
+        res->setCaseSensitive(false);
+    return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+InternedString::intern(const char* s, size_t len)
+{
+    ASSERTD((len == 0) || (s != _s));
+    excise();
+    _hash = hashCode(s, len);
+    if (len == 0)
+    {
+        _atom = _s;
+        return;
+    }
+
+    // search for the canonical copy (with self referring to s, so our hash code is used)
+    set(s, false, false, len);
+    _atom = _s;
+    auto& table = internedString_table();
+    auto atom = utl::cast<String>(table.find(self));
+
+    // not found -> add a canonical copy
+    if (atom == nullptr)
+    {
+        // the table is full -> just keep our own copy
+        if (internedString_count.load(std::memory_order_relaxed) >= maxInterned)
+        {
+            set(s, true, true, len);
+            _atom = nullptr;
+            return;
+        }
+
+        auto newAtom = new String();
+        newAtom->set(s, true, true, len);
+        // (if another thread beat us to it, the table destroys newAtom)
+        atom = utl::cast<String>(table.addOrFind(newAtom));
+        if (atom == newAtom)
+            internedString_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // refer to the canonical copy
+    set(atom->get(), false, false, len);
+    _atom = _s;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
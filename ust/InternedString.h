@@ -0,0 +1,123 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/String.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Interned (canonical) string.
+
+   All equal InternedStrings share a single immutable character array, which is found (or made)
+   in a global table when the InternedString is constructed, and whose hash code is computed only
+   once.  Comparing two InternedStrings that are equal is just a pointer comparison, and hash()
+   never looks at the characters, so an InternedString is an ideal key for a Hashtable when the
+   same small set of keys (HTTP header names, FastCGI parameter names, etc.) is used over and
+   over.  Copying an InternedString doesn't allocate anything.
+
+   The table is safe for concurrent use by any number of threads (see ConcurrentHashtable).
+   Interned character arrays are never freed, so the table only accepts a limited number of
+   strings: after that, an InternedString just keeps its own copy of its characters (and behaves
+   like an ordinary String).  Names that come from outside the program (e.g. the header names in
+   an HTTP request) shouldn't be interned directly: make() interns only a fixed list of well-known
+   names, and makes a plain String for any other name.
+
+   An InternedString's characters must not be modified directly (through get() or operator[]).
+   Modifying it through the String interface makes it a private copy (that isn't interned).
+
+   \author Adam McKee
+   \ingroup string
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class InternedString : public String
+{
+    UTL_CLASS_DECL(InternedString, String);
+
+public:
+    /**
+       Constructor.
+       \param s character array
+       \param caseSensitive (optional : true) case sensitivity flag
+    */
+    InternedString(const char* s, bool caseSensitive = true);
+
+    /**
+       Constructor.
+       \param s string
+       \param caseSensitive (optional : true) case sensitivity flag
+    */
+    InternedString(const String& s, bool caseSensitive = true);
+
+    virtual void copy(const Object& rhs);
+
+    virtual void steal(Object& rhs);
+
+    virtual size_t hash(size_t size) const;
+
+    virtual void serialize(Stream& stream, uint_t io, uint_t mode = ser_default);
+
+    virtual size_t innerAllocatedSize() const;
+
+    /** Does self refer to the interned (canonical) copy of its string? */
+    bool
+    isInterned() const
+    {
+        return (_s == _atom);
+    }
+
+    /** Get the number of interned strings. */
+    static size_t count();
+
+    /**
+       Make a copy of a name that may come from outside the program (e.g. an HTTP header name or a
+       FastCGI parameter name).  Only well-known names (common HTTP header names and CGI variable
+       names, matched exactly) are interned, so untrusted input can't grow the table.
+       \return new InternedString (for a well-known name), or new String (for any other name)
+       \param s name
+       \param len length of name
+       \param caseSensitive (optional : true) case sensitivity flag
+    */
+    static String* make(const char* s, size_t len, bool caseSensitive = true);
+
+    /**
+       Make a copy of a name that may come from outside the program.
+       \return new InternedString (for a well-known name), or new String (for any other name)
+       \param s name
+       \param caseSensitive (optional : true) case sensitivity flag
+    */
+    static String*
+    make(const String& s, bool caseSensitive = true)
+    {
+        return make(s.get(), s.length(), caseSensitive);
+    }
+
+private:
+    void
+    init()
+    {
+        _hash = 0;
+        _atom = _s;
+    }
+
+    void
+    deInit()
+    {
+    }
+
+    void intern(const char* s, size_t len);
+
+private:
+    size_t _hash;
+    const char* _atom;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
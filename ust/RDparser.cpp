@@ -1,4 +1,5 @@
 #include <libutl/libutl.h>
+#include <libutl/Arena.h>
 #include <libutl/MemStream.h>
 #include <libutl/RDparser.h>
 
@@ -335,14 +336,17 @@ GrammarNode::copy(const Object& rhs)
 class RDparserState
 {
 public:
-    RDparserState()
+    RDparserState(Arena* arena)
+        : tokenQ(arena == nullptr)
     {
         lastToken = tokenQ.end();
         lastTokenOK = tokenQ.end();
         ok = true;
+        this->arena = arena;
     }
 
 public:
+    Arena* arena;
     Queue<Token> tokenQ;
     TDequeIt<Token> lastToken;
     TDequeIt<Token> lastTokenOK;
@@ -469,7 +473,7 @@ RDparser::compile()
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 Graph*
-RDparser::parse(Stream& stream, const String* prod)
+RDparser::parse(Stream& stream, const String* prod, Arena* arena)
 {
     if (!ok())
         return nullptr;
@@ -482,11 +486,11 @@ RDparser::parse(Stream& stream, const String* prod)
         return nullptr;
 
     // scan input
-    RDparserState state;
+    RDparserState state(arena);
     scan(state, stream);
 
-    // create the parseTree
-    auto parseTree = new Graph;
+    // create the parseTree (if it's in an arena, the arena owns the nodes)
+    auto parseTree = arenaNew<Graph>(arena, arena == nullptr);
     parseTree->setMultiSet(true);
     auto it = state.tokenQ.begin();
     parseTree->setStart(parse(state, it, parseTree, gn));
@@ -504,7 +508,7 @@ RDparser::parse(Stream& stream, const String* prod)
     // clean up if the parse failed
     if (!state.ok)
     {
-        delete parseTree;
+        arenaDelete(arena, parseTree);
         throw ParseEx(utl::clone(*state.lastToken));
     }
 
@@ -514,10 +518,10 @@ RDparser::parse(Stream& stream, const String* prod)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 Graph*
-RDparser::parse(const String& str, const String* prod)
+RDparser::parse(const String& str, const String* prod, Arena* arena)
 {
     MemStream ms((byte_t*)str.get(), str.length() + 1, 0, false);
-    return parse(ms, prod);
+    return parse(ms, prod, arena);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -571,7 +575,7 @@ RDparser::parse(RDparserState& state, TDequeIt<Token>& it, Graph* parseTree, con
     TDeque<GrammarNode> edges(false);
     TDequeIt<Token> saveIt = it;
     TDequeIt<Token> saveLastTokenOK = state.lastTokenOK;
-    ParseNode* pn = new ParseNode;
+    ParseNode* pn = arenaNew<ParseNode>(state.arena);
     ParseNode* newPN = nullptr;
     uint_t op = gn->op();
     uint_t numEdges;
@@ -596,7 +600,8 @@ RDparser::parse(RDparserState& state, TDequeIt<Token>& it, Graph* parseTree, con
             state.lastTokenOK = it;
             if (setLastToken)
                 state.lastToken = it;
-            pn->setToken(tk);
+            // (tokens in the arena live as long as the parse tree does)
+            pn->setToken(tk, state.arena == nullptr);
             parseTree->add(pn);
             return pn;
         }
@@ -677,7 +682,7 @@ succeed:
             ASSERTD(!newPN->isProduction());
             newPN->setProductionId(pn->productionId());
         }
-        delete pn;
+        arenaDelete(state.arena, pn);
         pn = newPN;
     }
     else
@@ -687,7 +692,7 @@ succeed:
     return pn;
 
 fail:
-    delete pn;
+    arenaDelete(state.arena, pn);
     it = saveIt;
     state.lastTokenOK = saveLastTokenOK;
     state.ok = false;
@@ -870,7 +875,7 @@ RDparser::scan(RDparserState& state, Stream& stream)
         }
         catch (StreamEOFex&)
         {
-            state.tokenQ += new Token(uint_t_max, "<eof>", line, 0);
+            state.tokenQ += arenaNew<Token>(state.arena, uint_t_max, "<eof>", line, 0);
             break;
         }
         size_t i = 0;
@@ -885,7 +890,8 @@ RDparser::scan(RDparserState& state, Stream& stream)
                 RegexMatch m;
                 if (terminal->match(curStr, m))
                 {
-                    Token* tk = new Token(terminal->id(), m.replaceString("&"), line, i);
+                    Token* tk =
+                        arenaNew<Token>(state.arena, terminal->id(), m.replaceString("&"), line, i);
                     state.tokenQ += tk;
                     i += tk->length();
                     match = true;
@@ -987,16 +993,18 @@ RDparser::tryParse(RDparserState& state,
                    Graph* parseTree,
                    const GrammarNode* gn)
 {
-    Graph subParseTree;
+    // (nodes in the arena are owned by the arena)
+    Graph subParseTree(state.arena == nullptr);
     subParseTree.setMultiSet(true);
     ParseNode* pn = parse(state, it, subParseTree, gn);
     if (state.ok)
     {
         // parseTree gets subParseTree's elements
+        bool owner = parseTree->isOwner();
         parseTree->setOwner(false);
         Collection& subParseTreeCol = subParseTree;
         parseTree->add(subParseTreeCol);
-        parseTree->setOwner(true);
+        parseTree->setOwner(owner);
         // subParseTree loses ownership of elements
         subParseTree.setOwner(false);
     }
@@ -13,6 +13,7 @@ UTL_NS_BEGIN;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+class Arena;
 class GrammarNode;
 class Production;
 class ParseNode;
@@ -94,6 +95,13 @@ class Terminal;
    grammar.  Then you're ready to parse text (parse()).  To see a full example of RDparser in
    action, look at the example program that parses simple math expressions.
 
+   <b>Arena Allocation</b>
+
+   parse() can build the parse tree in an Arena.  The scanned tokens, the parse nodes and the
+   Graph itself are then carved out of the arena's chunks instead of being allocated one at a
+   time, and clearing the arena disposes of the whole tree.  A parse tree that lives in an arena
+   must not be deleted.
+
    \author Adam McKee
    \ingroup string
 */
@@ -148,16 +156,18 @@ public:
        \return parse tree (Graph of ParseNode)
        \param stream input stream
        \param prod (optional) root production
+       \param arena (optional) arena to build the parse tree in
     */
-    Graph* parse(Stream& stream, const String* prod = nullptr);
+    Graph* parse(Stream& stream, const String* prod = nullptr, Arena* arena = nullptr);
 
     /**
        Parse the given string.
        \return parse tree (Graph of ParseNode)
        \param str input string
        \param prod (optional) root production
+       \param arena (optional) arena to build the parse tree in
     */
-    Graph* parse(const String& str, const String* prod = nullptr);
+    Graph* parse(const String& str, const String* prod = nullptr, Arena* arena = nullptr);
 
 private:
     enum flg_t
@@ -253,13 +263,19 @@ public:
         _prodId = prodId;
     }
 
-    /** Set the token. */
+    /**
+       Set the token.
+       \param token new token
+       \param clone if false, refer to the given token instead of keeping a copy of it
+    */
     void
-    setToken(const Token* token)
+    setToken(const Token* token, bool clone = true)
     {
-        delete _token;
+        if (_tokenOwner)
+            delete _token;
         _token = token;
-        if (_token != nullptr)
+        _tokenOwner = clone;
+        if (clone && (_token != nullptr))
             _token = _token->clone();
     }
 
@@ -268,16 +284,19 @@ private:
     init()
     {
         _prodId = uint_t_max;
+        _tokenOwner = true;
         _token = nullptr;
     }
     void
     deInit()
     {
-        delete _token;
+        if (_tokenOwner)
+            delete _token;
     }
 
 private:
     uint_t _prodId;
+    bool _tokenOwner;
     const Token* _token;
 };
 
@@ -1,5 +1,6 @@
 #include <libutl/libutl.h>
 #include <libutl/Regex.h>
+#include <libutl/Arena.h>
 #include <libutl/AutoPtr.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -213,6 +214,7 @@ Regex::steal(Object& rhs)
         delete _mustStr;
 
     super::steal(rhsRegex);
+    _arena = rhsRegex._arena;
     _start = rhsRegex._start;
     _regex = rhsRegex._regex;
     _parenNo = rhsRegex._parenNo;
@@ -405,8 +407,8 @@ Regex::searchReplace(String& str, const String& rep)
             continue;
         }
         String replaceString = m.replaceString(rep);
+        // (m's match string refers to str's old characters, and mustn't be used after this)
         str.replace(matchSpan.begin(), matchSpan.size(), replaceString);
-        m.matchString().lengthInvalidate();
         pos = matchSpan.begin() + replaceString.length();
         ++numReplaced;
     }
@@ -416,9 +418,11 @@ Regex::searchReplace(String& str, const String& rep)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void
-Regex::init()
+Regex::init(Arena* arena)
 {
-    _regex = new TArray<REnode>();
+    // nodes in the arena are owned by the arena
+    _arena = arena;
+    _regex = new TArray<REnode>(arena == nullptr);
     _mustStr = nullptr;
     clear();
 }
@@ -434,6 +438,22 @@ Regex::deInit()
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+REnode*
+Regex::newNode(uint_t op, REnode* operand)
+{
+    return arenaNew<REnode>(_arena, op, operand);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+Regex::deleteNode(REnode* node)
+{
+    arenaDelete(_arena, node);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 String
 Regex::getToken(const TDequeIt<String>& it)
 {
@@ -613,7 +633,7 @@ Regex::parseExpression(TDequeIt<String>& it, bool paren)
 
     if (paren)
     {
-        expr = new REnode(REnode::re_open_paren);
+        expr = newNode(REnode::re_open_paren);
         parenNo = _parenNo++;
         expr->setParenNo(parenNo);
         *_regex += expr;
@@ -627,12 +647,12 @@ Regex::parseExpression(TDequeIt<String>& it, bool paren)
     for (;;)
     {
         TDequeIt<String> saveIt = it;
-        branch = new REnode(REnode::re_branch);
+        branch = newNode(REnode::re_branch);
         branch->setOperand(parseBranch(it));
 
         if (branch->operand() == nullptr)
         {
-            delete branch;
+            deleteNode(branch);
             it = saveIt;
             return nullptr;
         }
@@ -672,12 +692,12 @@ Regex::parseExpression(TDequeIt<String>& it, bool paren)
     REnode* end;
     if (paren)
     {
-        end = new REnode(REnode::re_close_paren);
+        end = newNode(REnode::re_close_paren);
         end->setParenNo(parenNo);
     }
     else
     {
-        end = new REnode(REnode::re_end);
+        end = newNode(REnode::re_end);
     }
     *_regex += end;
     prevNode->setNext(end);
@@ -758,21 +778,21 @@ Regex::parsePiece(TDequeIt<String>& it)
     if (tk == "*")
     {
         ++it;
-        piece = new REnode(REnode::re_repeat, atom);
+        piece = newNode(REnode::re_repeat, atom);
         piece->setReps(0);
         *_regex += piece;
     }
     else if (tk == "+")
     {
         ++it;
-        piece = new REnode(REnode::re_repeat, atom);
+        piece = newNode(REnode::re_repeat, atom);
         piece->setReps(1);
         *_regex += piece;
     }
     else if (tk == "?")
     {
         ++it;
-        piece = new REnode(REnode::re_repeat, atom);
+        piece = newNode(REnode::re_repeat, atom);
         piece->setReps(0, 1);
         *_regex += piece;
     }
@@ -783,7 +803,7 @@ Regex::parsePiece(TDequeIt<String>& it)
         ++it;
         if (!isSymbol(it) || (getToken(it) != "}"))
         {
-            delete atom;
+            // (atom is already in _regex)
             setOK(false);
             return nullptr;
         }
@@ -804,7 +824,7 @@ Regex::parsePiece(TDequeIt<String>& it)
         {
             maxReps = Uint(maxRepsStr);
         }
-        piece = new REnode(REnode::re_repeat, atom);
+        piece = newNode(REnode::re_repeat, atom);
         piece->setReps(minReps, maxReps);
         *_regex += piece;
     }
@@ -822,7 +842,7 @@ Regex::parsePiece(TDequeIt<String>& it)
         String ch = str.chop(strLen - 1, strLen);
 
         // create atom2, link with piece
-        REnode* atom2 = new REnode(REnode::re_string);
+        REnode* atom2 = newNode(REnode::re_string);
         atom2->setString(ch);
         *_regex += atom2;
         piece->setOperand(atom2);
@@ -867,24 +887,24 @@ Regex::parseAtom(TDequeIt<String>& it)
         else if (tk == "^")
         {
             ++it;
-            atom = new REnode(REnode::re_line_begin);
+            atom = newNode(REnode::re_line_begin);
         }
         else if (tk == "$")
         {
             ++it;
-            atom = new REnode(REnode::re_line_end);
+            atom = newNode(REnode::re_line_end);
         }
         else if (tk == ".")
         {
             ++it;
-            atom = new REnode(REnode::re_any_char);
+            atom = newNode(REnode::re_any_char);
         }
         else if (tk == "[")
         {
             ++it;
 
             // translate bracket expression -> charSet
-            atom = new REnode(REnode::re_range_any);
+            atom = newNode(REnode::re_range_any);
             BitArray& charSet = *new BitArray(256);
             atom->setCharSet(charSet);
 
@@ -901,7 +921,7 @@ Regex::parseAtom(TDequeIt<String>& it)
         {
             ++it;
             bool tv = (tk == "\\a");
-            atom = new REnode(REnode::re_range_any);
+            atom = newNode(REnode::re_range_any);
             BitArray& charSet = *new BitArray(256);
             atom->setCharSet(charSet);
             for (uint_t c = 0; c < 256; c++)
@@ -911,7 +931,7 @@ Regex::parseAtom(TDequeIt<String>& it)
         {
             ++it;
             bool tv = (tk == "\\d");
-            atom = new REnode(REnode::re_range_any);
+            atom = newNode(REnode::re_range_any);
             BitArray& charSet = *new BitArray(256);
             atom->setCharSet(charSet);
             for (uint_t c = 0; c < 256; c++)
@@ -921,7 +941,7 @@ Regex::parseAtom(TDequeIt<String>& it)
         {
             ++it;
             bool tv = (tk == "\\s");
-            atom = new REnode(REnode::re_range_any);
+            atom = newNode(REnode::re_range_any);
             BitArray& charSet = *new BitArray(256);
             atom->setCharSet(charSet);
             for (uint_t c = 0; c < 256; c++)
@@ -931,7 +951,7 @@ Regex::parseAtom(TDequeIt<String>& it)
         {
             ++it;
             bool tv = (tk == "\\w");
-            atom = new REnode(REnode::re_range_any);
+            atom = newNode(REnode::re_range_any);
             BitArray& charSet = *new BitArray(256);
             atom->setCharSet(charSet);
             for (uint_t c = 0; c < 256; c++)
@@ -947,14 +967,14 @@ Regex::parseAtom(TDequeIt<String>& it)
         String tk = getToken(it);
         if (tk.empty())
             goto fail;
-        atom = new REnode(REnode::re_string);
+        atom = newNode(REnode::re_string);
         atom->setString(tk);
         ++it;
     }
     *_regex += atom;
     return atom;
 fail:
-    delete atom;
+    deleteNode(atom);
     setOK(false);
     return nullptr;
 }
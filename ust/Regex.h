@@ -15,6 +15,7 @@ UTL_NS_BEGIN;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+class Arena;
 class REnode;
 class RegexMatch;
 
@@ -124,6 +125,11 @@ class RegexMatch;
        </ul>
    </ul>
 
+   A regex can be compiled into an Arena (see the constructor that takes one), which is useful
+   when many short-lived regexes are made.  The nodes of the compiled form are then allocated from
+   the arena and released when it's cleared, so the arena must outlive the regex.  (Recompiling
+   the regex leaves its old nodes in the arena until then.)
+
    \author Adam McKee
    \ingroup string
 */
@@ -143,6 +149,18 @@ public:
         compile();
     }
 
+    /**
+       Constructor.
+       \param regex regex
+       \param arena arena to build the compiled form in
+    */
+    Regex(const String& regex, Arena* arena)
+        : String(regex)
+    {
+        init(arena);
+        compile();
+    }
+
     /**
        Constructor.
        \param str regex
@@ -191,9 +209,13 @@ public:
     }
 
 private:
-    void init();
+    void init(Arena* arena = nullptr);
     void deInit();
 
+    REnode* newNode(uint_t op, REnode* operand = nullptr);
+
+    void deleteNode(REnode* node);
+
     static String getToken(const TDequeIt<String>& it);
 
     bool
@@ -231,6 +253,7 @@ private:
     void setTail(REnode* chain, REnode* tail);
 
 private:
+    Arena* _arena;
     REnode* _start;
     TArray<REnode>* _regex;
     uint_t _parenNo;
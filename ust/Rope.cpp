@@ -0,0 +1,504 @@
+#include <libutl/libutl.h>
+#include <libutl/Rope.h>
+#include <libutl/Stream.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_CLASS_IMPL(utl::Rope);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#undef new
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// chunk sizes grow with the rope (within these limits)
+static const size_t minChunkSize = 256;
+static const size_t maxChunkSize = 64 * 1024;
+
+// a piece shorter than this is copied (instead of shared) when one rope is added to another
+static const size_t minSharedPiece = 64;
+
+// blocks written with each call to Stream::writev()
+static const size_t maxWriteBlocks = 64;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// the characters in [lo, hi) are in use
+struct Rope::chunk_t
+{
+    std::atomic<size_t> refCount;
+    size_t size;
+    size_t lo;
+    size_t hi;
+
+    char*
+    data()
+    {
+        return reinterpret_cast<char*>(this + 1);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int
+Rope::compare(const Object& rhs) const
+{
+    auto& rope = utl::cast<Rope>(rhs);
+    if (&rope == this)
+        return 0;
+
+    // compare the overlapping parts of pieces
+    size_t lhsIdx = 0, rhsIdx = 0;
+    size_t lhsOff = 0, rhsOff = 0;
+    while ((lhsIdx != _numPieces) && (rhsIdx != rope._numPieces))
+    {
+        auto& lp = piece(lhsIdx);
+        auto& rp = rope.piece(rhsIdx);
+        size_t num = min(lp.len - lhsOff, rp.len - rhsOff);
+        int res = memcmp(lp.ptr + lhsOff, rp.ptr + rhsOff, num);
+        if (res != 0)
+            return res;
+        lhsOff += num;
+        rhsOff += num;
+        if (lhsOff == lp.len)
+        {
+            ++lhsIdx;
+            lhsOff = 0;
+        }
+        if (rhsOff == rp.len)
+        {
+            ++rhsIdx;
+            rhsOff = 0;
+        }
+    }
+
+    // one is a prefix of the other
+    return utl::compare(_length, rope._length);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+Rope::copy(const Object& rhs)
+{
+    auto& rope = utl::cast<Rope>(rhs);
+    if (&rope == this)
+        return;
+    clear();
+    append(rope);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+Rope::steal(Object& rhs_)
+{
+    auto& rhs = utl::cast<Rope>(rhs_);
+    if (&rhs == this)
+        return;
+    deInit();
+    _pieces = rhs._pieces;
+    _capacity = rhs._capacity;
+    _head = rhs._head;
+    _numPieces = rhs._numPieces;
+    _begin = rhs._begin;
+    _length = rhs._length;
+    rhs.init();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+Rope::innerAllocatedSize() const
+{
+    // count each run of pieces from the same chunk once
+    size_t res = _capacity * sizeof(piece_t);
+    chunk_t* lastChunk = nullptr;
+    for (size_t i = 0; i != _numPieces; ++i)
+    {
+        auto chunk = piece(i).chunk;
+        if (chunk != lastChunk)
+            res += sizeof(chunk_t) + chunk->size;
+        lastChunk = chunk;
+    }
+    return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+String
+Rope::toString() const
+{
+    String res;
+    if (_length == 0)
+        return res;
+    auto s = new char[_length + 1];
+    copyTo(s);
+    s[_length] = '\0';
+    res.set(s, true, false, _length);
+    return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+char
+Rope::get(size_t i) const
+{
+    ASSERTD(i < _length);
+    auto& p = piece(findPiece(i));
+    return p.ptr[(_begin + (ssize_t)i) - p.start];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Rope
+Rope::subRope(size_t begin, size_t len) const
+{
+    Rope res;
+    if (begin >= _length)
+        return res;
+    len = min(len, _length - begin);
+    for (size_t idx = findPiece(begin); len != 0; ++idx)
+    {
+        auto& p = piece(idx);
+        size_t off = (_begin + (ssize_t)begin) - p.start;
+        size_t num = min(p.len - off, len);
+        addRef(p.chunk);
+        res.pushBack(p.chunk, p.ptr + off, num);
+        begin += num;
+        len -= num;
+    }
+    return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+Rope::copyTo(char* array) const
+{
+    for (size_t i = 0; i != _numPieces; ++i)
+    {
+        auto& p = piece(i);
+        memcpy(array, p.ptr, p.len);
+        array += p.len;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+Rope::writeTo(Stream& os) const
+{
+    struct iovec iov[maxWriteBlocks];
+    size_t num = 0;
+    for (size_t i = 0; i != _numPieces; ++i)
+    {
+        auto& p = piece(i);
+        iov[num].iov_base = const_cast<char*>(p.ptr);
+        iov[num].iov_len = p.len;
+        if (++num == maxWriteBlocks)
+        {
+            os.writev(iov, num);
+            num = 0;
+        }
+    }
+    if (num != 0)
+        os.writev(iov, num);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+Rope::clear()
+{
+    for (size_t i = 0; i != _numPieces; ++i)
+    {
+        release(piece(i).chunk);
+    }
+    _head = 0;
+    _numPieces = 0;
+    _begin = 0;
+    _length = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Rope&
+Rope::append(const char* s, size_t len)
+{
+    if (len == 0)
+        return self;
+
+    // fill the free space at the end of the last chunk (if only we are using it)
+    if (_numPieces != 0)
+    {
+        auto& p = piece(_numPieces - 1);
+        auto chunk = p.chunk;
+        if ((chunk->refCount.load(std::memory_order_acquire) == 1) &&
+            ((p.ptr + p.len) == (chunk->data() + chunk->hi)))
+        {
+            size_t num = min(len, chunk->size - chunk->hi);
+            memcpy(chunk->data() + chunk->hi, s, num);
+            chunk->hi += num;
+            p.len += num;
+            _length += num;
+            s += num;
+            len -= num;
+            if (len == 0)
+                return self;
+        }
+    }
+
+    // copy the rest into a new chunk
+    auto chunk = newChunk(chunkSize(len));
+    memcpy(chunk->data(), s, len);
+    chunk->lo = 0;
+    chunk->hi = len;
+    pushBack(chunk, chunk->data(), len);
+    return self;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Rope&
+Rope::append(const Rope& rope)
+{
+    if (&rope == this)
+    {
+        Rope tmp(rope);
+        return append(tmp);
+    }
+    for (size_t i = 0; i != rope._numPieces; ++i)
+    {
+        auto& p = rope.piece(i);
+        if (p.len < minSharedPiece)
+        {
+            append(p.ptr, p.len);
+        }
+        else
+        {
+            addRef(p.chunk);
+            pushBack(p.chunk, p.ptr, p.len);
+        }
+    }
+    return self;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Rope&
+Rope::prepend(const char* s, size_t len)
+{
+    if (len == 0)
+        return self;
+
+    // fill the free space at the beginning of the first chunk (if only we are using it)
+    if (_numPieces != 0)
+    {
+        auto& p = piece(0);
+        auto chunk = p.chunk;
+        if ((chunk->refCount.load(std::memory_order_acquire) == 1) &&
+            (p.ptr == (chunk->data() + chunk->lo)))
+        {
+            size_t num = min(len, chunk->lo);
+            chunk->lo -= num;
+            memcpy(chunk->data() + chunk->lo, s + len - num, num);
+            p.ptr -= num;
+            p.len += num;
+            p.start -= num;
+            _begin -= num;
+            _length += num;
+            len -= num;
+            if (len == 0)
+                return self;
+        }
+    }
+
+    // copy the rest into the end of a new chunk (leaving room for more prepending)
+    auto size = chunkSize(len);
+    auto chunk = newChunk(size);
+    chunk->lo = size - len;
+    chunk->hi = size;
+    memcpy(chunk->data() + chunk->lo, s, len);
+    pushFront(chunk, chunk->data() + chunk->lo, len);
+    return self;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Rope&
+Rope::prepend(const Rope& rope)
+{
+    if (&rope == this)
+    {
+        Rope tmp(rope);
+        return prepend(tmp);
+    }
+    for (size_t i = rope._numPieces; i != 0; --i)
+    {
+        auto& p = rope.piece(i - 1);
+        if (p.len < minSharedPiece)
+        {
+            prepend(p.ptr, p.len);
+        }
+        else
+        {
+            addRef(p.chunk);
+            pushFront(p.chunk, p.ptr, p.len);
+        }
+    }
+    return self;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+Rope::init()
+{
+    _pieces = nullptr;
+    _capacity = 0;
+    _head = 0;
+    _numPieces = 0;
+    _begin = 0;
+    _length = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+Rope::deInit()
+{
+    clear();
+    delete[] _pieces;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+Rope::findPiece(size_t pos) const
+{
+    ASSERTD(pos < _length);
+
+    // find the last piece that starts at or before pos
+    ssize_t target = _begin + (ssize_t)pos;
+    size_t lo = 0, hi = _numPieces;
+    while ((hi - lo) > 1)
+    {
+        size_t mid = (lo + hi) / 2;
+        if (piece(mid).start <= target)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t
+Rope::chunkSize(size_t len) const
+{
+    size_t size = min(max(nextPow2(_length), minChunkSize), maxChunkSize);
+    return max(size, len);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+Rope::pushBack(chunk_t* chunk, const char* ptr, size_t len)
+{
+    if (_numPieces == _capacity)
+        grow();
+    auto& p = _pieces[(_head + _numPieces) & (_capacity - 1)];
+    p.chunk = chunk;
+    p.ptr = ptr;
+    p.len = len;
+    p.start = _begin + (ssize_t)_length;
+    ++_numPieces;
+    _length += len;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+Rope::pushFront(chunk_t* chunk, const char* ptr, size_t len)
+{
+    if (_numPieces == _capacity)
+        grow();
+    _head = (_head - 1) & (_capacity - 1);
+    auto& p = _pieces[_head];
+    _begin -= len;
+    p.chunk = chunk;
+    p.ptr = ptr;
+    p.len = len;
+    p.start = _begin;
+    ++_numPieces;
+    _length += len;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+Rope::grow()
+{
+    size_t capacity = (_capacity == 0) ? 8 : (_capacity * 2);
+    auto pieces = new piece_t[capacity];
+    for (size_t i = 0; i != _numPieces; ++i)
+    {
+        pieces[i] = piece(i);
+    }
+    delete[] _pieces;
+    _pieces = pieces;
+    _capacity = capacity;
+    _head = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Rope::chunk_t*
+Rope::newChunk(size_t size)
+{
+    auto mem = new byte_t[sizeof(chunk_t) + size];
+    auto chunk = new (mem) chunk_t;
+    chunk->refCount.store(1, std::memory_order_relaxed);
+    chunk->size = size;
+    return chunk;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+Rope::addRef(chunk_t* chunk)
+{
+    chunk->refCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void
+Rope::release(chunk_t* chunk)
+{
+    if (chunk->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        chunk->~chunk_t();
+        delete[] reinterpret_cast<byte_t*>(chunk);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+utl::Stream&
+operator<<(utl::Stream& lhs, const utl::Rope& rhs)
+{
+    rhs.writeTo(lhs);
+    return lhs;
+}
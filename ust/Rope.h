@@ -0,0 +1,280 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <libutl/String.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Stream;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Character string made of pieces of shared chunks.
+
+   Rope is meant for building up a large string (like an HTTP response body) piece by piece,
+   without the repeated re-allocation and copying that appending to a String does as it grows.
+   A rope is a sequence of <b>pieces</b>, each of which refers to a run of characters in a
+   reference-counted <b>chunk</b>.  Short appends (and prepends) copy the characters into the free
+   space in the last (or first) chunk, so most of them don't allocate anything.  Appending one
+   rope to another (and copying a rope, or taking a subRope()) shares the chunks instead of
+   copying the characters.
+
+   \arg append() and prepend() take O(1) time (not counting the copying of the characters)
+   \arg get() and subRope() take O(log n) time (for n pieces)
+   \arg writeTo() writes the pieces to a Stream as they are (with Stream::writev())
+   \arg toString() makes a flat String (with a single allocation)
+
+   Chunks are shared between ropes safely (their reference counts are atomic), but a single Rope
+   must not be modified by one thread while another thread is using it.
+
+   \author Adam McKee
+   \ingroup string
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Rope : public Object
+{
+    UTL_CLASS_DECL(Rope, Object);
+
+public:
+    /**
+       Constructor.
+       \param s initial contents
+    */
+    Rope(const char* s)
+    {
+        init();
+        append(s);
+    }
+
+    /**
+       Constructor.
+       \param s initial contents
+    */
+    Rope(const String& s)
+    {
+        init();
+        append(s);
+    }
+
+    virtual int compare(const Object& rhs) const;
+
+    virtual void copy(const Object& rhs);
+
+    virtual void steal(Object& rhs);
+
+    virtual size_t innerAllocatedSize() const;
+
+    /** Make a flat String with the same contents. */
+    virtual String toString() const;
+
+    /// \name Accessors
+    //@{
+    /** Is the rope empty? */
+    bool
+    empty() const
+    {
+        return (_length == 0);
+    }
+
+    /** Get the length of the rope. */
+    size_t
+    length() const
+    {
+        return _length;
+    }
+
+    /** Get the number of pieces. */
+    size_t
+    numPieces() const
+    {
+        return _numPieces;
+    }
+
+    /** Get the character at the given position. */
+    char get(size_t i) const;
+
+    /** Array access operator. */
+    char operator[](size_t i) const
+    {
+        return get(i);
+    }
+
+    /**
+       Get a sub-rope (which shares self's chunks).
+       \return specified sub-rope
+       \param begin index of first character
+       \param len length of sub-rope
+    */
+    Rope subRope(size_t begin, size_t len = size_t_max) const;
+
+    /**
+       Copy the characters to an array (which isn't <b>nul</b>-terminated).
+       \param array destination array (length() bytes are written)
+    */
+    void copyTo(char* array) const;
+
+    /** Write the contents to the given stream. */
+    void writeTo(Stream& os) const;
+    //@}
+
+    /// \name Modification
+    //@{
+    /** Make the rope empty. */
+    void clear();
+
+    /**
+       Append the given characters.
+       \param s address of the first character
+       \param len number of characters
+    */
+    Rope& append(const char* s, size_t len);
+
+    /** Append the given string. */
+    Rope&
+    append(const char* s)
+    {
+        ASSERTD(s != nullptr);
+        return append(s, strlen(s));
+    }
+
+    /** Append the given string. */
+    Rope&
+    append(const String& s)
+    {
+        return append(s.get(), s.length());
+    }
+
+    /** Append the given character. */
+    Rope&
+    append(char c)
+    {
+        return append(&c, 1);
+    }
+
+    /** Append the given rope (sharing its chunks). */
+    Rope& append(const Rope& rope);
+
+    /**
+       Prepend the given characters.
+       \param s address of the first character
+       \param len number of characters
+    */
+    Rope& prepend(const char* s, size_t len);
+
+    /** Prepend the given string. */
+    Rope&
+    prepend(const char* s)
+    {
+        ASSERTD(s != nullptr);
+        return prepend(s, strlen(s));
+    }
+
+    /** Prepend the given string. */
+    Rope&
+    prepend(const String& s)
+    {
+        return prepend(s.get(), s.length());
+    }
+
+    /** Prepend the given character. */
+    Rope&
+    prepend(char c)
+    {
+        return prepend(&c, 1);
+    }
+
+    /** Prepend the given rope (sharing its chunks). */
+    Rope& prepend(const Rope& rope);
+
+    /** Append the given character. */
+    Rope&
+    operator+=(char c)
+    {
+        return append(c);
+    }
+
+    /** Append the given string. */
+    Rope&
+    operator+=(const char* s)
+    {
+        return append(s);
+    }
+
+    /** Append the given string. */
+    Rope&
+    operator+=(const String& s)
+    {
+        return append(s);
+    }
+
+    /** Append the given rope. */
+    Rope&
+    operator+=(const Rope& rope)
+    {
+        return append(rope);
+    }
+    //@}
+
+private:
+    struct chunk_t;
+
+    struct piece_t
+    {
+        chunk_t* chunk;
+        const char* ptr;
+        size_t len;
+        ssize_t start;
+    };
+
+private:
+    void init();
+    void deInit();
+
+    piece_t&
+    piece(size_t idx) const
+    {
+        ASSERTD(idx < _numPieces);
+        return _pieces[(_head + idx) & (_capacity - 1)];
+    }
+
+    size_t findPiece(size_t pos) const;
+    size_t chunkSize(size_t len) const;
+    void pushBack(chunk_t* chunk, const char* ptr, size_t len);
+    void pushFront(chunk_t* chunk, const char* ptr, size_t len);
+    void grow();
+
+    static chunk_t* newChunk(size_t size);
+    static void addRef(chunk_t* chunk);
+    static void release(chunk_t* chunk);
+
+private:
+    piece_t* _pieces;
+    size_t _capacity;
+    size_t _head;
+    size_t _numPieces;
+    ssize_t _begin;
+    size_t _length;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Write a rope to a stream.
+   \ingroup string
+   \return output stream
+   \param lhs output stream
+   \param rhs rope to write
+*/
+utl::Stream& operator<<(utl::Stream& lhs, const utl::Rope& rhs);
@@ -35,7 +35,7 @@ String::String(const char* s, bool owner, bool duplicate, bool caseSensitive)
     {
         _s = const_cast<char*>(s);
         _size = 0;
-        _length = size_t_max;
+        _length = strlen(s);
     }
 }
 
@@ -48,6 +48,13 @@ String::String(size_t size)
     {
         init();
     }
+    else if (size <= inlineSize)
+    {
+        _s = _buf;
+        _s[0] = '\0';
+        _size = inlineSize;
+        _length = 0;
+    }
     else
     {
         size = utl::nextMultipleOfPow2((size_t)8, size);
@@ -64,6 +71,8 @@ int
 String::compare(const Object& rhs) const
 {
     auto& string = utl::cast<String>(rhs);
+    if (_s == string._s)
+        return 0;
     if (isCaseSensitive() && string.isCaseSensitive())
     {
         return ::strcmp(_s, string._s);
@@ -95,7 +104,7 @@ String::copy(const Object& rhs)
     bool owner = isOwner() || string.isOwner();
 
     // set the new string in lhs (self)
-    set(string._s, owner, owner);
+    set(string._s, owner, owner, string._length);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -104,42 +113,34 @@ void
 String::steal(Object& rhs_)
 {
     auto& rhs = utl::cast<String>(rhs_);
-    if (_size > 0)
-        delete[] _s;
+    if (&rhs == this)
+        return;
+    deleteArray();
     copyFlags(rhs);
+    _length = rhs._length;
+
+    // a string in rhs's own buffer must be copied (rhs keeps its copy)
+    if (rhs.isInline())
+    {
+        memcpy(_buf, rhs._buf, _length + 1);
+        _s = _buf;
+        _size = inlineSize;
+        return;
+    }
+
+    // take rhs's array (rhs is left empty)
     _s = rhs._s;
     _size = rhs._size;
-    _length = rhs._length;
-    if (_size > 0)
-        rhs.setOwner(false);
+    if (_size != 0)
+        rhs.init(rhs.isCaseSensitive());
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-// FNV-1a hash
-#define FNV_GCC_OPTIMIZATION
 size_t
 String::hash(size_t size) const
 {
-    if (empty())
-        return 0;
-    static const uint64_t FNV_offset_basis = 14695981039346656037ULL;
-#ifndef FNV_GCC_OPTIMIZATION
-    static const uint64_t FNV_prime = 1099511628211ULL;
-#endif
-    uint64_t h = FNV_offset_basis;
-    auto ptr = reinterpret_cast<byte_t*>(_s);
-    auto lim = ptr + length();
-    for (; ptr != lim; ++ptr)
-    {
-        h ^= static_cast<uint64_t>(*ptr);
-#ifdef FNV_GCC_OPTIMIZATION
-        h += (h << 1) + (h << 4) + (h << 5) + (h << 7) + (h << 8) + (h << 40);
-#else
-        h *= FNV_prime;
-#endif
-    }
-    return h % size;
+    return hashCode(_s, length()) % size;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -162,7 +163,7 @@ String::serialize(Stream& stream, uint_t io, uint_t mode)
 size_t
 String::innerAllocatedSize() const
 {
-    return _size;
+    return isInline() ? 0 : _size;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -418,11 +419,11 @@ String::subString(size_t begin, size_t len) const
     if ((begin == 0) && (len == myLen))
         return self;
 
-    char* str = new char[len + 1];
-    strncpy(str, _s + begin, len);
-    str[len] = '\0';
-
-    return String(str, true, false);
+    String res(len + 1);
+    memcpy(res._s, _s + begin, len);
+    res._s[len] = '\0';
+    res._length = len;
+    return res;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -521,8 +522,7 @@ String::nextToken(size_t& idx, char delim, bool processQuotes) const
 String&
 String::excise()
 {
-    if (isOwner())
-        delete[] _s;
+    deleteArray();
     _s = &nullChar;
     _size = 0;
     _length = 0;
@@ -534,7 +534,7 @@ String::excise()
 void
 String::economize()
 {
-    if (_size == 0)
+    if ((_size == 0) || isInline())
         return;
     if (empty())
     {
@@ -544,11 +544,19 @@ String::economize()
         _length = 0;
         return;
     }
-    size_t size = utl::nextMultipleOfPow2((size_t)8, length() + 1);
+    if (_length < inlineSize)
+    {
+        memcpy(_buf, _s, _length + 1);
+        delete[] _s;
+        _s = _buf;
+        _size = inlineSize;
+        return;
+    }
+    size_t size = utl::nextMultipleOfPow2((size_t)8, _length + 1);
     if (_size == size)
         return;
     char* s = new char[size];
-    memcpy(s, _s, size);
+    memcpy(s, _s, _length + 1);
     delete[] _s;
     _s = s;
     _size = size;
@@ -654,6 +662,7 @@ String::replace(const String& lhs, const String& rhs)
 String&
 String::replace(char lhs, char rhs)
 {
+    assertOwner();
     auto myLen = length();
     auto lim = _s + myLen;
     for (auto ptr = _s; ptr != lim; ++ptr)
@@ -752,17 +761,25 @@ String::set(const char* s_, bool owner, bool duplicate, size_t length)
         {
             if (reqSize <= _size)
             {
-                memcpy(_s, s, length);
+                memmove(_s, s, length);
             }
             else
             {
                 // nuke existing string if we own it
-                if (_size > 0)
-                    delete[] _s;
+                deleteArray();
 
-                // make new size large enough to contain the string, and a multiple of 8
-                _size = nextMultipleOfPow2((size_t)8, reqSize);
-                _s = new char[_size];
+                // a short string goes in our own buffer
+                if (reqSize <= inlineSize)
+                {
+                    _size = inlineSize;
+                    _s = _buf;
+                }
+                else
+                {
+                    // make new size large enough to contain the string, and a multiple of 8
+                    _size = nextMultipleOfPow2((size_t)8, reqSize);
+                    _s = new char[_size];
+                }
 
                 // copy into the new allocation
                 memcpy(_s, s, length);
@@ -771,16 +788,14 @@ String::set(const char* s_, bool owner, bool duplicate, size_t length)
         }
         else
         {
-            if (_size > 0)
-                delete[] _s;
+            deleteArray();
             _s = s;
             _size = reqSize;
         }
     }
     else
     {
-        if (_size > 0)
-            delete[] _s;
+        deleteArray();
         _s = s;
         _size = 0;
     }
@@ -813,6 +828,8 @@ String::toLower(size_t begin, size_t len)
 String&
 String::toUpper(size_t begin, size_t len)
 {
+    assertOwner();
+
     // set bounds
     size_t myLen = length(), end;
     setBounds(begin, end, len, myLen);
@@ -928,12 +945,45 @@ String::spaces(size_t num)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// FNV-1a hash
+#define FNV_GCC_OPTIMIZATION
+size_t
+String::hashCode(const char* s, size_t len)
+{
+    if (len == 0)
+        return 0;
+    static const uint64_t FNV_offset_basis = 14695981039346656037ULL;
+#ifndef FNV_GCC_OPTIMIZATION
+    static const uint64_t FNV_prime = 1099511628211ULL;
+#endif
+    uint64_t h = FNV_offset_basis;
+    auto ptr = reinterpret_cast<const byte_t*>(s);
+    auto lim = ptr + len;
+    for (; ptr != lim; ++ptr)
+    {
+        h ^= static_cast<uint64_t>(*ptr);
+#ifdef FNV_GCC_OPTIMIZATION
+        h += (h << 1) + (h << 4) + (h << 5) + (h << 7) + (h << 8) + (h << 40);
+#else
+        h *= FNV_prime;
+#endif
+    }
+    return h;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void
 String::_assertOwner()
 {
     ASSERTD(_size == 0);
-    if (_length == size_t_max)
-        _length = strlen(_s);
+    if (_length < inlineSize)
+    {
+        memcpy(_buf, _s, _length + 1);
+        _s = _buf;
+        _size = inlineSize;
+        return;
+    }
     size_t size = utl::nextMultipleOfPow2((size_t)8, _length + 1);
     char* s = new char[size];
     memcpy(s, _s, _length + 1);
@@ -953,28 +1003,33 @@ String::_assertOwner(size_t size, size_t increment)
     if (size <= _size)
         return;
 
-    // make sure ownership flag is set
-    bool wasOwner = isOwner();
-    setOwner(true);
-
-    // determine new size of _s[]
+    // determine new size of _s[] (a short string goes in our own buffer)
     size_t newSize;
-    if (increment == size_t_max)
+    char* s;
+    if (size <= inlineSize)
     {
-        newSize = nextPow2(size);
+        ASSERTD(!isInline());
+        newSize = inlineSize;
+        s = _buf;
     }
     else
     {
-        ASSERTD(increment == nextPow2(increment));
-        newSize = nextMultipleOfPow2(increment, size);
+        if (increment == size_t_max)
+        {
+            newSize = nextPow2(size);
+        }
+        else
+        {
+            ASSERTD(increment == nextPow2(increment));
+            newSize = nextMultipleOfPow2(increment, size);
+        }
+        s = new char[newSize];
     }
 
-    // grow the character array to newSize
-    ASSERTD(length() < newSize);
-    auto s = new char[newSize];
-    memcpy(s, _s, length() + 1);
-    if (wasOwner)
-        delete[] _s;
+    // copy the string into the new array
+    ASSERTD(_length < newSize);
+    memcpy(s, _s, _length + 1);
+    deleteArray();
     _s = s;
     _size = newSize;
 }
@@ -15,6 +15,11 @@ UTL_NS_BEGIN;
 
    A string is a <b>nul</b>-terminated array of characters.
 
+   The length of the string is always known, so length() is O(1).  A string that owns its
+   characters keeps short strings (of up to 23 characters) in a small buffer inside the object
+   itself, and only allocates an array from the heap for longer strings.  When you modify the
+   characters directly (e.g. through get()), call lengthInvalidate() afterward.
+
    <b>Attributes</b>
 
    \arg <b><i>owner</i> flag</b> : True iff self owns the underlying string.
@@ -33,6 +38,7 @@ class String
     , public FlagsMI
 {
     UTL_CLASS_DECL(String, Object);
+    UTL_CLASS_POOLED;
 
 public:
     /**
@@ -56,11 +62,11 @@ public:
     */
     String(char ch)
     {
-        _s = new char[8];
+        _s = _buf;
         _s[0] = ch;
         _s[1] = '\0';
-        _size = 8;
-        _length = size_t_max;
+        _size = inlineSize;
+        _length = (ch == '\0') ? 0 : 1;
     }
 
     virtual int compare(const Object& rhs) const;
@@ -86,17 +92,39 @@ public:
         return (_size != 0);
     }
 
-    /** Set the ownership flag (without doing anything else). */
+    /**
+       Set the ownership flag.  Asserting ownership of an empty string moves it to the object's own
+       buffer.  Relinquishing ownership hands the character array over to the caller, who must
+       delete[] get() when done with it: if the string is held in the object's own buffer, it is
+       first copied to an array allocated with new[] (so relinquishing ownership only to keep a
+       non-owning view of a short string leaks that copy).  Otherwise nothing else is done.
+    */
     void
     setOwner(bool owner)
     {
         if (owner)
         {
-            if (_size == 0)
-                _size = length() + 1;
+            if (_size != 0)
+                return;
+            if (_s == &nullChar)
+            {
+                _s = _buf;
+                *_s = '\0';
+                _size = inlineSize;
+            }
+            else
+            {
+                _size = _length + 1;
+            }
         }
         else
         {
+            if (isInline())
+            {
+                auto s = new char[_length + 1];
+                memcpy(s, _s, _length + 1);
+                _s = s;
+            }
             _size = 0;
         }
     }
@@ -300,17 +328,19 @@ public:
     size_t
     length() const
     {
-        if (_length == size_t_max)
-            _length = strlen(_s);
         ASSERTD(_length == strlen(_s));
         return _length;
     }
 
-    /** Invalidate the cached length of the string. */
+    /**
+       Re-calculate the length of the string (after its characters were modified directly).  The
+       characters are read right away, so a string that doesn't own its characters must still
+       refer to a valid array.
+    */
     void
     lengthInvalidate() const
     {
-        _length = size_t_max;
+        _length = strlen(_s);
     }
 
     /**
@@ -323,7 +353,7 @@ public:
         return subString(0, n);
     }
 
-    /** Get the size of the allocated character array. */
+    /** Get the size of the character array (including the object's own buffer). */
     size_t
     size() const
     {
@@ -575,6 +605,15 @@ public:
 
     /** Return a string consisting of the given number of spaces. */
     static String spaces(size_t num);
+
+    /**
+       Compute the hash code of a character array.  For a string \b str,
+       <code>str.hash(size) == hashCode(str.get(), str.length()) % size</code>.
+       \return hash code (0 if len == 0)
+       \param s character array
+       \param len length of character array
+    */
+    static size_t hashCode(const char* s, size_t len);
     //@}
 
     /// \name Operators
@@ -771,10 +810,15 @@ protected:
         len = end - begin;
     }
 
+protected:
+    // size of the buffer for short strings
+    static const size_t inlineSize = 24;
+
 protected:
     char* _s;
     size_t _size;
     mutable size_t _length;
+    char _buf[inlineSize];
 
 private:
     enum flg_t
@@ -799,13 +843,27 @@ private:
     {
 // check length in DEBUG mode, and allow an easy breakpoint
 #ifdef DEBUG
-        bool lengthOK = ((_length == size_t_max) || (_length == strlen(_s)));
+        bool lengthOK = !isOwner() || (_length == strlen(_s));
         ASSERT(lengthOK);
         ASSERT(nullChar == '\0');
 #endif
 
         // if we own the string, delete it
-        if (isOwner())
+        deleteArray();
+    }
+
+    /** Is the string kept in the object's own buffer? */
+    bool
+    isInline() const
+    {
+        return (_s == _buf);
+    }
+
+    /** Delete the character array (if self owns it, and it was allocated from the heap). */
+    void
+    deleteArray()
+    {
+        if ((_size != 0) && !isInline())
             delete[] _s;
     }
 
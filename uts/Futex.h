@@ -0,0 +1,209 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#if UTL_HOST_OS == UTL_OS_LINUX
+#include <errno.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#else
+#include <thread>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_BEGIN;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+   Wait/wake on a 32-bit atomic word.
+
+   Futex lets lock-free structures put waiting threads to sleep without adding a lock to their
+   fast path: a waiter samples value(), re-checks its condition, and calls wait() with the sampled
+   value; a thread that changes the condition then calls bump() followed by wake().  wait() returns
+   immediately if the word no longer holds the sampled value, so a wake-up can't be lost between
+   the waiter's check and its sleep.
+
+   waitFor() and notify() package that protocol for the common case of a thread that wants to
+   retry a non-blocking operation (such as dequeueing from an empty queue) until it succeeds.
+   notify() is cheap when no thread is waiting.
+
+   On Linux this is a thin wrapper around the futex(2) system call.  Elsewhere, wait() falls back
+   to yielding the processor until the value changes or the timeout expires.
+
+   \author Adam McKee
+   \ingroup threads
+*/
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Futex
+{
+public:
+    /** Constructor. */
+    Futex()
+        : _word(0)
+        , _waiters(0)
+    {
+    }
+
+    Futex(const Futex&) = delete;
+
+    Futex& operator=(const Futex&) = delete;
+
+    /** Get the current value. */
+    uint32_t
+    value() const
+    {
+        return _word.load(std::memory_order_acquire);
+    }
+
+    /** Change the value (so that threads waiting on the old value will not go to sleep). */
+    void
+    bump()
+    {
+        _word.fetch_add(1, std::memory_order_release);
+    }
+
+    /**
+       Sleep while the value equals the given value.
+       \return false iff the timeout expired
+       \param val value sampled by the caller
+       \param msec (optional : uint_t_max) timeout in milliseconds (uint_t_max = wait forever)
+    */
+    bool wait(uint32_t val, uint_t msec = uint_t_max);
+
+    /**
+       Wake up threads waiting in wait().
+       \param num (optional : 1) maximum number of threads to wake up (INT_MAX = all)
+    */
+    void wake(int num = 1);
+
+    /**
+       Call the given function until it returns true, sleeping while it returns false until
+       notify() is called.
+       \return true iff the function returned true (false if the timeout expired)
+       \param tryFn non-blocking operation to retry
+       \param msec (optional : uint_t_max) timeout in milliseconds (uint_t_max = wait forever)
+    */
+    template <typename Function>
+    bool waitFor(Function tryFn, uint_t msec = uint_t_max);
+
+    /**
+       Wake up threads waiting in waitFor() (if there are any).
+       \param num (optional : 1) maximum number of threads to wake up (INT_MAX = all)
+    */
+    void
+    notify(int num = 1)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_waiters.load(std::memory_order_relaxed) == 0)
+            return;
+        bump();
+        wake(num);
+    }
+
+private:
+    std::atomic<uint32_t> _word;
+    std::atomic<uint32_t> _waiters;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Function>
+bool
+Futex::waitFor(Function tryFn, uint_t msec)
+{
+    if (tryFn())
+        return true;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(msec);
+    while (true)
+    {
+        // register as a waiter, then try again before going to sleep
+        _waiters.fetch_add(1, std::memory_order_seq_cst);
+        auto val = value();
+        if (tryFn())
+        {
+            _waiters.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        uint_t waitMsec = uint_t_max;
+        if (msec != uint_t_max)
+        {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline)
+            {
+                _waiters.fetch_sub(1, std::memory_order_relaxed);
+                return false;
+            }
+            waitMsec = 1 + std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now)
+                               .count();
+        }
+        wait(val, waitMsec);
+        _waiters.fetch_sub(1, std::memory_order_relaxed);
+        if (tryFn())
+            return true;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if UTL_HOST_OS == UTL_OS_LINUX
+
+inline bool
+Futex::wait(uint32_t val, uint_t msec)
+{
+    struct timespec ts, *tsp = nullptr;
+    if (msec != uint_t_max)
+    {
+        ts.tv_sec = msec / 1000;
+        ts.tv_nsec = (msec % 1000) * 1000000;
+        tsp = &ts;
+    }
+    auto res = syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_word), FUTEX_WAIT_PRIVATE, val,
+                       tsp, nullptr, 0);
+    return (res == 0) || (errno != ETIMEDOUT);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline void
+Futex::wake(int num)
+{
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_word), FUTEX_WAKE_PRIVATE, num, nullptr,
+            nullptr, 0);
+}
+
+#else
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline bool
+Futex::wait(uint32_t val, uint_t msec)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(msec);
+    while (_word.load(std::memory_order_acquire) == val)
+    {
+        if ((msec != uint_t_max) && (std::chrono::steady_clock::now() >= deadline))
+            return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline void
+Futex::wake(int)
+{
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+UTL_NS_END;